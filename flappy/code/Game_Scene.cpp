@@ -12,8 +12,10 @@
 #include "Menu_Scene.hpp"
 
 #include <cstdlib>
+#include <string>
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Log>
 
 using namespace basics;
 using namespace std;
@@ -22,23 +24,31 @@ namespace example
 {
     // ---------------------------------------------------------------------------------------------
     // ID y ruta de las texturas que se deben cargar para esta escena. La textura con el mensaje de
-    // carga está la primera para poder dibujarla cuanto antes:
+    // carga se carga aparte para poder dibujarla cuanto antes y, como es opaca, se sube en RGB565
+    // (con tramado) para que ocupe la mitad:
 
     Game_Scene::Texture_Data Game_Scene::textures_data[] =
             {
-                    { ID(loading),    "game-scene/loading.png"        },
+                    { ID(loading),    "game-scene/loading.png",        Texture_Container::RGB565  },
+            };
+
+    // Pâra determinar el número de items en el array textures_data, se divide el tamaño en bytes
+    // del array completo entre el tamaño en bytes de un item:
+
+    unsigned Game_Scene::textures_count = sizeof(textures_data) / sizeof(Texture_Data);
+
+    // ID y ruta de las imágenes de los sprites, que se empaquetan en un atlas:
+
+    Game_Scene::Image_Data Game_Scene::images_data[] =
+            {
                     { ID(hbar),       "game-scene/horizontal-bar.png" },
                     { ID(flappy),     "game-scene/flappy.png"         },
                     { ID(top),        "game-scene/top.png"            },
                     { ID(bottom),     "game-scene/bottom.png"         },
                     { ID(exit),       "game-scene/exit.png"           },
-
             };
 
-    // Pâra determinar el número de items en el array textures_data, se divide el tamaño en bytes
-    // del array completo entre el tamaño en bytes de un item:
-
-    unsigned Game_Scene::textures_count = sizeof(textures_data) / sizeof(Texture_Data);
+    unsigned Game_Scene::images_count = sizeof(images_data) / sizeof(Image_Data);
 
     // ---------------------------------------------------------------------------------------------
 
@@ -77,6 +87,11 @@ namespace example
         suspended = true;
         gameplay  = UNINITIALIZED;
 
+        // Mientras se cargan las texturas se usa el contexto gráfico en update(), por lo que la
+        // escena no se dibuja en el hilo de render hasta que empieza el juego:
+
+        set_pipelined (false);
+
         return true;
     }
 
@@ -96,20 +111,25 @@ namespace example
 
     // ---------------------------------------------------------------------------------------------
 
-    void Game_Scene::handle (Event & event)
+    void Game_Scene::handle_touches (const Touch_Batch & touches)
     {
-        if (state == RUNNING)               // Se descartan los eventos cuando la escena está LOADING
+        if (state == RUNNING)               // Se descartan los toques cuando la escena está LOADING
         {
-            if (gameplay == WAITING_TO_START)
-            {
-                start_playing ();           // Se empieza a jugar cuando el usuario toca la pantalla por primera vez
-            }
-            else switch (event.id)
+            for (const Touch_Sample & touch : touches)
             {
-                case ID(touch-started):     // El usuario toca la pantalla
+                if (touch.historical) continue;
+
+                if (gameplay == WAITING_TO_START)
+                {
+                    start_playing ();       // Se empieza a jugar cuando el usuario toca la pantalla por primera vez
+                }
+                else
+                if (touch.phase == Touch_Sample::STARTED)
                 {
-                    float touchX = *event[ID(x) ].as< var::Float > ();
-                    float touchY = *event[ID(y) ].as< var::Float > ();
+                    // El usuario toca la pantalla:
+
+                    float touchX = touch.x;
+                    float touchY = touch.y;
 
                     if(touchX > exit_x->get_position_x() && touchX < exit_x->get_width() && touchY > exit_x->get_position_y() && touchY < exit_x->get_height())
                     {
@@ -122,14 +142,6 @@ namespace example
                         timer.reset();
                     }
                 }
-                case ID(touch-moved):
-                {
-
-                }
-                case ID(touch-ended):       // El usuario deja de tocar la pantalla
-                {
-
-                }
             }
         }
     }
@@ -148,7 +160,7 @@ namespace example
 
     // ---------------------------------------------------------------------------------------------
 
-    void Game_Scene::render (Context & context)
+    void Game_Scene::render (Context & context, float alpha)
     {
         if (!suspended)
         {
@@ -167,47 +179,99 @@ namespace example
 
             if (canvas)
             {
-                canvas->clear ();
+                record (*canvas, alpha);
+            }
+        }
+    }
 
-                switch (state)
-                {
-                    case LOADING: render_loading   (*canvas); break;
-                    case RUNNING: render_playfield (*canvas); break;
-                    case ERROR:   break;
-                }
+    // ---------------------------------------------------------------------------------------------
+
+    void Game_Scene::record (Canvas & canvas, float alpha)
+    {
+        if (!suspended)
+        {
+            canvas.clear ();
+
+            switch (state)
+            {
+                case LOADING: render_loading   (canvas); break;
+                case RUNNING: render_playfield (canvas, alpha); break;
+                case ERROR:   break;
             }
         }
     }
 
     // ---------------------------------------------------------------------------------------------
-    // En este método solo se carga una textura por fotograma para poder pausar la carga si el
-    // juego pasa a segundo plano inesperadamente. Otro aspecto interesante es que la carga no
-    // comienza hasta que la escena se inicia para así tener la posibilidad de mostrar al usuario
-    // que la carga está en curso en lugar de tener una pantalla en negro que no responde durante
-    // un tiempo.
+    // Las texturas se leen y decodifican en paralelo en segundo plano, y en cada fotograma solo se
+    // suben al contexto gráfico las que quepan en el presupuesto del cargador (las imágenes de los
+    // sprites se empaquetan antes en un atlas, en otro hilo), de modo que la carga se puede pausar
+    // si el juego pasa a segundo plano inesperadamente. Otro aspecto interesante es que la carga no
+    // comienza hasta que la escena se inicia para así tener la posibilidad de mostrar al usuario que
+    // la carga está en curso en lugar de tener una pantalla en negro que no responde durante un
+    // tiempo.
 
     void Game_Scene::load_textures ()
     {
-        if (textures.size () < textures_count)          // Si quedan texturas por cargar...
+        if (texture_loader.get_progress ().requested == 0)
         {
-            // Las texturas se cargan y se suben al contexto gráfico, por lo que es necesario disponer
-            // de uno:
+            // Se encargan todas las texturas. Cada una se guarda en el mapa en cuanto está lista:
+
+            for (unsigned index = 0; index < textures_count; ++index)
+            {
+                Texture_2D::Options options{};
+
+                options.upload_format = textures_data[index].format;
+                options.dither        = true;
+
+                texture_loader.load
+                (
+                    textures_data[index].id,
+                    textures_data[index].path,
+                    options,
+                    [this] (Id id, const Texture_Handle & texture)
+                    {
+                        if (texture) textures[id] = texture; else state = ERROR;
+                    }
+                );
+            }
+
+            // Las imágenes de los sprites se decodifican y empaquetan en un atlas en otro hilo:
+
+            for (unsigned index = 0; index < images_count; ++index)
+            {
+                atlas_builder.add (images_data[index].id, images_data[index].path);
+            }
+
+            atlas_builder.start ();
+        }
+
+        if (!texture_loader.is_done () || !atlas_builder.is_uploaded ())
+        {
+            // Las texturas decodificadas se suben al contexto gráfico, por lo que es necesario
+            // disponer de uno:
 
             Graphics_Context::Accessor context = director.lock_graphics_context ();
 
             if (context)
             {
-                // Se carga la siguiente textura (textures.size() indica cuántas llevamos cargadas):
+                texture_loader.upload (context);
 
-                Texture_Data   & texture_data = textures_data[textures.size ()];
-                Texture_Handle & texture      = textures[texture_data.id] = Texture_2D::create (texture_data.id, context, texture_data.path);
-
-                // Se comprueba si la textura se ha podido cargar correctamente:
+                if (!atlas_builder.is_uploaded () && atlas_builder.upload (context))
+                {
+                    if (!atlas_builder.good ()) state = ERROR;
 
-                if (texture) context->add (texture); else state = ERROR;
+                    for (auto & page : atlas_builder.get_occupancy ())
+                    {
+                        basics::log.d
+                        (
+                            "atlas page " + to_string (page.width) + "x" + to_string (page.height) +
+                            ": " + to_string (unsigned(page.get_ratio () * 100.f + .5f)) + "% used"
+                        );
+                    }
+                }
 
-                // Cuando se han terminado de cargar todas las texturas se pueden crear los sprites que
-                // las usarán e iniciar el juego:
+                // Cuando se han terminado de cargar todas las texturas se pueden crear los sprites
+                // que las usarán e iniciar el juego:
             }
         }
         else
@@ -217,6 +281,15 @@ namespace example
             restart_game   ();                          // el mensaje de carga no aparezca y desaparezca
             // demasiado rápido.
             state = RUNNING;
+
+            set_pipelined (true);                       // A partir de aquí ya no se usa el contexto gráfico
+
+            // La simulación avanza con un paso fijo de 1/60 s independientemente de la frecuencia de
+            // refresco de la pantalla, por lo que speed son los píxeles que se avanza en cada paso.
+            // Durante la carga no se usa porque el Director podría llamar a update() varias veces
+            // en un mismo frame y las texturas se subirían con varias veces el presupuesto:
+
+            set_frame_rate (60);
         }
     }
 
@@ -226,8 +299,8 @@ namespace example
     {
         // Se crean y configuran los sprites del fondo:
 
-        Sprite_Handle    top_bar(new Sprite( textures[ID(hbar)].get () ));
-        Sprite_Handle bottom_bar(new Sprite( textures[ID(hbar)].get () ));
+        Sprite_Handle    top_bar(new Sprite( atlas_builder.get_slice (ID(hbar)) ));
+        Sprite_Handle bottom_bar(new Sprite( atlas_builder.get_slice (ID(hbar)) ));
 
         top_bar->set_anchor   (TOP | LEFT);
         top_bar->set_position ({ 0, canvas_height });
@@ -242,10 +315,10 @@ namespace example
         top_border    =             top_bar.get ();
         bottom_border =          bottom_bar.get ();
 
-        Sprite_Handle bird_handle  (new Sprite( textures[ID(flappy)].get() ));
-        Sprite_Handle top_handle   (new Sprite( textures[ID(top)].get()    ));
-        Sprite_Handle bottom_handle(new Sprite( textures[ID(bottom)].get() ));
-        Sprite_Handle exit_handle  (new Sprite( textures[ID(exit)].get()   ));
+        Sprite_Handle bird_handle  (new Sprite( atlas_builder.get_slice (ID(flappy)) ));
+        Sprite_Handle top_handle   (new Sprite( atlas_builder.get_slice (ID(top))    ));
+        Sprite_Handle bottom_handle(new Sprite( atlas_builder.get_slice (ID(bottom)) ));
+        Sprite_Handle exit_handle  (new Sprite( atlas_builder.get_slice (ID(exit))   ));
 
         sprites.push_back(bird_handle);
         sprites.push_back(top_handle);
@@ -277,6 +350,13 @@ namespace example
         bottompipe->set_position({canvas_width - bottompipe->get_width(), pipepos - 400.f});
         bottompipe->set_speed_x(0.f);
 
+        // Los sprites recolocados no se deben interpolar desde su posición anterior:
+
+        for (auto & sprite : sprites)
+        {
+            sprite->skip_interpolation ();
+        }
+
         pipepos = canvas_height / 2;
 
         gameplay = WAITING_TO_START;
@@ -325,6 +405,9 @@ namespace example
 
             bottompipe->set_position_x(canvas_width);
             bottompipe->set_position_y(pipepos - 400.f);
+
+            toppipe   ->skip_interpolation ();
+            bottompipe->skip_interpolation ();
         }
     }
 
@@ -380,13 +463,14 @@ namespace example
     }
 
     // ---------------------------------------------------------------------------------------------
-    // Simplemente se dibujan todos los sprites que conforman la escena.
+    // Simplemente se dibujan todos los sprites que conforman la escena, cada uno entre su posición
+    // del paso anterior y la del último según lo que haya transcurrido del paso actual.
 
-    void Game_Scene::render_playfield (Canvas & canvas)
+    void Game_Scene::render_playfield (Canvas & canvas, float alpha)
     {
         for (auto & sprite : sprites)
         {
-            sprite->render (canvas);
+            sprite->render (canvas, alpha);
         }
     }
 
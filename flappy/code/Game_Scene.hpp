@@ -11,14 +11,16 @@
 #ifndef GAME_SCENE_HEADER
 #define GAME_SCENE_HEADER
 
-#include <map>
 #include <list>
 #include <memory>
 
+#include <basics/Atlas_Builder>
 #include <basics/Canvas>
 #include <basics/Id>
+#include <basics/Id_Map>
 #include <basics/Scene>
 #include <basics/Texture_2D>
+#include <basics/Texture_Loader>
 #include <basics/Timer>
 
 #include "Sprite.hpp"
@@ -27,9 +29,12 @@ namespace example
 {
 
     using basics::Id;
+    using basics::Id_Map;
+    using basics::Atlas_Builder;
     using basics::Timer;
     using basics::Canvas;
     using basics::Texture_2D;
+    using basics::Texture_Loader;
 
     class Game_Scene : public basics::Scene
     {
@@ -39,7 +44,7 @@ namespace example
         typedef std::shared_ptr < Sprite     >     Sprite_Handle;
         typedef std::list< Sprite_Handle     >     Sprite_List;
         typedef std::shared_ptr< Texture_2D  >     Texture_Handle;
-        typedef std::map< Id, Texture_Handle >     Texture_Map;
+        typedef Id_Map< Texture_Handle >           Texture_Map;
         typedef basics::Graphics_Context::Accessor Context;
 
         /**
@@ -65,15 +70,27 @@ namespace example
     private:
 
         /**
-         * Array de estructuras con la información de las texturas (Id y ruta) que hay que cargar.
+         * Array de estructuras con la información de las texturas (Id, ruta y formato con el que
+         * se suben al contexto gráfico) que hay que cargar.
          */
-        static struct   Texture_Data { Id id; const char * path; } textures_data[];
+        static struct   Texture_Data { Id id; const char * path; basics::Texture_Container::Format format; } textures_data[];
 
         /**
          * Número de items que hay en el array textures_data.
          */
         static unsigned textures_count;
 
+        /**
+         * Array de estructuras con la información de las imágenes (Id y ruta) de los sprites, que
+         * se empaquetan juntas en un atlas para no tener que cambiar de textura al dibujarlos.
+         */
+        static struct   Image_Data { Id id; const char * path; } images_data[];
+
+        /**
+         * Número de items que hay en el array images_data.
+         */
+        static unsigned images_count;
+
     private:
 
         State          state;                               ///< Estado de la escena.
@@ -84,6 +101,8 @@ namespace example
         unsigned       canvas_height;                       ///< Alto  de la resolución virtual usada para dibujar.
 
         Texture_Map    textures;                            ///< Mapa  en el que se guardan shared_ptr a las texturas cargadas.
+        Texture_Loader texture_loader;                      ///< Carga las texturas en segundo plano.
+        Atlas_Builder  atlas_builder;                       ///< Empaqueta las imágenes de los sprites en segundo plano.
         Sprite_List    sprites;                             ///< Lista en la que se guardan shared_ptr a los sprites creados.
 
         Sprite       * top_border;                          ///< Puntero al sprite de la lista de sprites que representa el borde superior.
@@ -98,7 +117,7 @@ namespace example
         float          birdpos;
         bool           birdjump;
         bool           go;
-        float          speed;
+        float          speed;                               ///< Píxeles que se avanza en cada paso de la simulación
 
         Timer          timer;                               ///< Cronómetro usado para medir intervalos de tiempo
 
@@ -138,21 +157,32 @@ namespace example
 
         /**
          * Este método se invoca automáticamente una vez por fotograma cuando se acumulan
-         * eventos dirigidos a la escena.
+         * toques dirigidos a la escena.
          */
-        void handle (basics::Event & event) override;
+        void handle_touches (const basics::Touch_Batch & touches) override;
 
         /**
-         * Este método se invoca automáticamente una vez por fotograma para que la escena
-         * actualize su estado.
+         * Este método se invoca automáticamente para que la escena actualize su estado. Como la
+         * escena establece una frecuencia fija, se invoca con un paso constante tantas veces por
+         * fotograma como haga falta para seguir el tiempo real (puede que ninguna).
          */
         void update (float time) override;
 
+        using basics::Scene::render;
+
         /**
          * Este método se invoca automáticamente una vez por fotograma para que la escena
          * dibuje su contenido.
+         * @param alpha Fracción del paso de simulación transcurrida desde la última actualización.
+         */
+        void render (Context & context, float alpha) override;
+
+        /**
+         * Dibuja el contenido de la escena con un canvas cualquiera. Cuando la escena se dibuja en
+         * el hilo de render, Director lo invoca en lugar de render() con un canvas que solo graba
+         * lo que se dibuja.
          */
-        void render (Context & context) override;
+        void record (Canvas & canvas, float alpha) override;
 
     private:
 
@@ -204,8 +234,9 @@ namespace example
         /**
          * Dibuja la escena de juego cuando el estado de la escena es RUNNING.
          * @param canvas Referencia al Canvas con el que dibujar.
+         * @param alpha  Fracción del paso con la que se interpola la posición de los sprites.
          */
-        void render_playfield (Canvas & canvas);
+        void render_playfield (Canvas & canvas, float alpha);
 
     };
 
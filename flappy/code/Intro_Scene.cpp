@@ -91,20 +91,25 @@ namespace example
 
     void Intro_Scene::update_loading ()
     {
-        Graphics_Context::Accessor context = director.lock_graphics_context ();
+        // La textura del logo se lee y decodifica en segundo plano:
 
-        if (context)
+        if (texture_loader.get_progress ().requested == 0)
         {
-            // Se carga la textura del logo:
+            texture_loader.load (ID(logo), "logo.png");
+        }
+
+        Graphics_Context::Accessor context = director.lock_graphics_context ();
 
-            logo_texture = Texture_2D::create (0, context, "logo.png");
+        // Cuando está decodificada se sube al contexto gráfico:
+
+        if (context && texture_loader.upload (context) > 0)
+        {
+            logo_texture = texture_loader.get (ID(logo));
 
             // Se comprueba si la textura se ha podido cargar correctamente:
 
             if (logo_texture)
             {
-                context->add (logo_texture);
-
                 timer.reset ();
 
                 opacity = 0.f;
@@ -15,6 +15,7 @@
     #include <basics/Canvas>
     #include <basics/Scene>
     #include <basics/Texture_2D>
+    #include <basics/Texture_Loader>
     #include <basics/Timer>
 
     namespace example
@@ -23,6 +24,7 @@
         using basics::Timer;
         using basics::Canvas;
         using basics::Texture_2D;
+        using basics::Texture_Loader;
         using basics::Graphics_Context;
 
         class Intro_Scene : public basics::Scene
@@ -55,6 +57,7 @@
             float    opacity;                                   ///< Opacidad de la textura.
 
             std::shared_ptr < Texture_2D > logo_texture;        ///< Textura que contiene la imagen del logo.
+            Texture_Loader                 texture_loader;      ///< Carga la textura del logo en segundo plano.
 
         public:
 
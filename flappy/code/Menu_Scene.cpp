@@ -42,47 +42,51 @@ namespace example
 
     // ---------------------------------------------------------------------------------------------
 
-    void Menu_Scene::handle (basics::Event & event)
+    void Menu_Scene::handle_touches (const Touch_Batch & touches)
     {
-        if (state == READY)                     // Se descartan los eventos cuando la escena está LOADING
+        if (state == READY)                     // Se descartan los toques cuando la escena está LOADING
         {
-            switch (event.id)
+            for (const Touch_Sample & touch : touches)
             {
-                case ID(touch-started):         // El usuario toca la pantalla
-                case ID(touch-moved):
+                if (touch.historical) continue;
+
+                Point2f touch_location = { touch.x, touch.y };
+
+                switch (touch.phase)
                 {
-                    // Se determina qué opción se ha tocado:
+                    case Touch_Sample::STARTED:         // El usuario toca la pantalla
+                    case Touch_Sample::MOVED:
+                    {
+                        // Se determina qué opción se ha tocado:
 
-                    Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
-                    int     option_touched = option_at (touch_location);
+                        int option_touched = option_at (touch_location);
 
-                    // Solo se puede tocar una opción a la vez (para evitar selecciones múltiples),
-                    // por lo que solo una se considera presionada (el resto se "sueltan"):
+                        // Solo se puede tocar una opción a la vez (para evitar selecciones múltiples),
+                        // por lo que solo una se considera presionada (el resto se "sueltan"):
 
-                    for (int index = 0; index < number_of_options; ++index)
-                    {
-                        options[index].is_pressed = index == option_touched;
-                    }
+                        for (int index = 0; index < number_of_options; ++index)
+                        {
+                            options[index].is_pressed = index == option_touched;
+                        }
 
-                    break;
-                }
+                        break;
+                    }
 
-                case ID(touch-ended):           // El usuario deja de tocar la pantalla
-                {
-                    // Se "sueltan" todas las opciones:
+                    case Touch_Sample::ENDED:           // El usuario deja de tocar la pantalla
+                    {
+                        // Se "sueltan" todas las opciones:
 
-                    for (auto & option : options) option.is_pressed = false;
+                        for (auto & option : options) option.is_pressed = false;
 
-                    // Se determina qué opción se ha dejado de tocar la última y se actúa como corresponda:
+                        // Se determina qué opción se ha dejado de tocar la última y se actúa como corresponda:
 
-                    Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
+                        if (option_at (touch_location) == PLAY)
+                        {
+                            director.run_scene (shared_ptr< Scene >(new Game_Scene));
+                        }
 
-                    if (option_at (touch_location) == PLAY)
-                    {
-                        director.run_scene (shared_ptr< Scene >(new Game_Scene));
+                        break;
                     }
-
-                    break;
                 }
             }
         }
@@ -94,13 +98,20 @@ namespace example
     {
         if (!suspended) if (state == LOADING)
         {
-            Graphics_Context::Accessor context = director.lock_graphics_context ();
+            // La textura del atlas se lee y decodifica en segundo plano:
 
-            if (context)
+            if (texture_loader.get_progress ().requested == 0)
             {
-                // Se carga el atlas:
+                texture_loader.load (ID(main-menu), "menu-scene/main-menu.png");
+            }
 
-                atlas.reset (new Atlas("menu-scene/main-menu.sprites", context));
+            Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+            // Una vez que la textura se ha subido al contexto gráfico, se carga el atlas con ella:
+
+            if (context && texture_loader.upload (context) > 0)
+            {
+                atlas.reset (new Atlas("menu-scene/main-menu.sprites", texture_loader.get (ID(main-menu))));
 
                 // Si el atlas se ha podido cargar el estado es READY y, en otro caso, es ERROR:
 
@@ -111,6 +122,8 @@ namespace example
                 if (state == READY)
                 {
                     configure_options ();
+
+                    set_pipelined (true);       // Ya no se usa el contexto gráfico fuera de render()
                 }
             }
         }
@@ -137,31 +150,41 @@ namespace example
 
             if (canvas)
             {
-                canvas->clear ();
+                record (*canvas, 1.f);
+            }
+        }
+    }
 
-                if (state == READY)
-                {
-                    // Se dibuja el slice de cada una de las opciones del menú:
+    // ---------------------------------------------------------------------------------------------
 
-                    for (auto & option : options)
-                    {
-                        canvas->set_transform
-                        (
-                            scale_then_translate_2d
-                            (
-                                  option.is_pressed ? 0.75f : 1.f,              // Escala de la opción
-                                { option.position[0], option.position[1] }      // Traslación
-                            )
-                        );
-
-                        canvas->fill_rectangle ({ 0.f, 0.f }, { option.slice->width, option.slice->height }, option.slice, CENTER | TOP);
-                    }
+    void Menu_Scene::record (Canvas & canvas, float )
+    {
+        if (!suspended)
+        {
+            canvas.clear ();
 
-                    // Se restablece la transformación aplicada a las opciones para que no afecte a
-                    // dibujos posteriores realizados con el mismo canvas:
+            if (state == READY)
+            {
+                // Se dibuja el slice de cada una de las opciones del menú:
 
-                    canvas->set_transform (Transformation2f());
+                for (auto & option : options)
+                {
+                    canvas.set_transform
+                    (
+                        scale_then_translate_2d
+                        (
+                              option.is_pressed ? 0.75f : 1.f,              // Escala de la opción
+                            { option.position[0], option.position[1] }      // Traslación
+                        )
+                    );
+
+                    canvas.fill_rectangle ({ 0.f, 0.f }, { option.slice->width, option.slice->height }, option.slice, CENTER | TOP);
                 }
+
+                // Se restablece la transformación aplicada a las opciones para que no afecte a
+                // dibujos posteriores realizados con el mismo canvas:
+
+                canvas.set_transform (Transformation2f());
             }
         }
     }
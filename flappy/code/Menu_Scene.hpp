@@ -17,6 +17,7 @@
     #include <basics/Point>
     #include <basics/Scene>
     #include <basics/Size>
+    #include <basics/Texture_Loader>
     #include <basics/Timer>
 
     namespace example
@@ -28,6 +29,7 @@
         using basics::Point2f;
         using basics::Size2f;
         using basics::Texture_2D;
+        using basics::Texture_Loader;
         using basics::Graphics_Context;
 
         class Menu_Scene : public basics::Scene
@@ -74,6 +76,7 @@
             Option   options[number_of_options];                ///< Datos de las opciones del menú
 
             std::unique_ptr< Atlas > atlas;                     ///< Atlas que contiene las imágenes de las opciones del menú
+            Texture_Loader           texture_loader;            ///< Carga la textura del atlas en segundo plano
 
         public:
 
@@ -113,9 +116,9 @@
 
             /**
              * Este método se invoca automáticamente una vez por fotograma cuando se acumulan
-             * eventos dirigidos a la escena.
+             * toques dirigidos a la escena.
              */
-            void handle (basics::Event & event) override;
+            void handle_touches (const basics::Touch_Batch & touches) override;
 
             /**
              * Este método se invoca automáticamente una vez por fotograma para que la escena
@@ -129,6 +132,12 @@
              */
             void render (Graphics_Context::Accessor & context) override;
 
+            /**
+             * Dibuja las opciones del menú con un canvas cualquiera. Cuando la escena se dibuja en
+             * el hilo de render, Director lo invoca en lugar de render() con una Render_Queue.
+             */
+            void record (Canvas & canvas, float alpha) override;
+
         private:
 
             /**
@@ -17,14 +17,30 @@ namespace example
 
     Sprite::Sprite(Texture_2D * texture)
     :
-        texture (texture)
+        texture (texture),
+        slice   (nullptr)
     {
-        anchor   = basics::CENTER;
-        size     = { texture->get_width (), texture->get_height () };
-        position = { 0.f, 0.f };
-        scale    = 1.f;
-        speed    = { 0.f, 0.f };
-        visible  = true;
+        anchor            = basics::CENTER;
+        size              = { texture->get_width (), texture->get_height () };
+        position          = { 0.f, 0.f };
+        previous_position = position;
+        scale             = 1.f;
+        speed             = { 0.f, 0.f };
+        visible           = true;
+    }
+
+    Sprite::Sprite(const Atlas::Slice * slice)
+    :
+        texture (nullptr),
+        slice   (slice  )
+    {
+        anchor            = basics::CENTER;
+        size              = { slice->width, slice->height };
+        position          = { 0.f, 0.f };
+        previous_position = position;
+        scale             = 1.f;
+        speed             = { 0.f, 0.f };
+        visible           = true;
     }
 
     bool Sprite::intersects (const Sprite & other)
@@ -12,6 +12,7 @@
 #define SPRITE_HEADER
 
     #include <memory>
+    #include <basics/Atlas>
     #include <basics/Canvas>
     #include <basics/Texture_2D>
     #include <basics/Vector>
@@ -19,6 +20,7 @@
     namespace example
     {
 
+        using basics::Atlas;
         using basics::Canvas;
         using basics::Size2f;
         using basics::Point2f;
@@ -30,10 +32,13 @@
         protected:
 
             Texture_2D * texture;                   ///< Textura en la que está la imagen del sprite.
+            const Atlas::Slice
+                         * slice;                   ///< Slice de un atlas usado en lugar de la textura si no es nullptr.
             int          anchor;                    ///< Indica qué punto de la textura se colocará en 'position' (x,y).
 
             Size2f       size;                      ///< Tamaño del sprite (normalmente en coordenadas virtuales).
             Point2f      position;                  ///< Posición del sprite (normalmente en coordenadas virtuales).
+            Point2f      previous_position;         ///< Posición antes de la última actualización (para interpolar).
             float        scale;                     ///< Escala el tamaño del sprite. Por defecto es 1.
 
             Vector2f     speed;                     ///< Velocidad a la que se mueve el sprite. Usar el valor por defecto (0,0) para dejarlo quieto.
@@ -48,6 +53,13 @@
              */
             Sprite(Texture_2D * texture);
 
+            /**
+             * Inicializa una nueva instancia de Sprite cuya imagen está en un atlas (lo que permite
+             * dibujar varios sprites sin cambiar de textura).
+             * @param slice Puntero al slice del atlas con su imagen. No debe ser nullptr.
+             */
+            Sprite(const Atlas::Slice * slice);
+
             /**
              * Destructor virtual para facilitar heredar de esta clase si fuese necesario.
              */
@@ -165,6 +177,15 @@
                 visible = true;
             }
 
+            /**
+             * Hace que el sprite se dibuje directamente en su posición actual aunque se interpole,
+             * lo que se debe hacer cuando se recoloca en lugar de desplazarse.
+             */
+            void skip_interpolation ()
+            {
+                previous_position = position;
+            }
+
         public:
 
             /**
@@ -192,6 +213,8 @@
              */
             virtual void update (float time)
             {
+                previous_position = position;
+
                 if (visible)
                 {
                     Vector2f displacement = speed * time;
@@ -204,12 +227,24 @@
             /**
              * Dibuja la imagen del sprite automáticamente, pero solo cuando es visible.
              * @param canvas Referencia al Canvas que se debe usar para dibujar la imagen.
+             * @param alpha  Fracción del paso de simulación transcurrida desde la última actualización.
+             *               Con 1 (por defecto) el sprite se dibuja en su posición actual y con valores
+             *               menores se interpola entre la posición anterior y la actual.
              */
-            virtual void render (Canvas & canvas)
+            virtual void render (Canvas & canvas, float alpha = 1.f)
             {
                 if (visible)
                 {
-                    canvas.fill_rectangle (position, size * scale, texture, anchor);
+                    Point2f where
+                    {
+                        previous_position.coordinates.x () + (position.coordinates.x () - previous_position.coordinates.x ()) * alpha,
+                        previous_position.coordinates.y () + (position.coordinates.y () - previous_position.coordinates.y ()) * alpha
+                    };
+
+                    if (slice)
+                        canvas.fill_rectangle (where, size * scale, slice,   anchor);
+                    else
+                        canvas.fill_rectangle (where, size * scale, texture, anchor);
                 }
             }
 
@@ -16,6 +16,8 @@
 
     #include "Android_Asset.hpp"
     #include <android/asset_manager.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
     #include "Native_Activity.hpp"
 
     namespace basics { namespace internal
@@ -30,13 +32,21 @@
                 AASSET_MODE_UNKNOWN
             );
 
-            cursor = 0;
-            failed = handle == nullptr;
-            at_end = false;
+            cursor       = 0;
+            failed       = handle == nullptr;
+            at_end       = false;
+            mapping      = nullptr;
+            mapping_size = 0;
+            bytes        = nullptr;
         }
 
         Android_Asset::~Android_Asset()
         {
+            if (mapping != nullptr)
+            {
+                munmap (mapping, mapping_size), mapping = nullptr;
+            }
+
             if (handle != nullptr)
             {
                 AAsset_close (handle), handle = nullptr;
@@ -130,6 +140,47 @@
             return false;
         }
 
+        const byte * Android_Asset::map ()
+        {
+            if (bytes == nullptr && good ())
+            {
+                // Los assets que se guardan sin comprimir en el APK se pueden mapear directamente
+                // desde el archivo. El offset de mmap() debe estar alineado con el tamaño de página:
+
+                off_t start  = 0;
+                off_t length = 0;
+                int   file   = AAsset_openFileDescriptor (handle, &start, &length);
+
+                if (file >= 0)
+                {
+                    off_t page_size = off_t(sysconf (_SC_PAGESIZE));
+                    off_t aligned   = start - start % page_size;
+
+                    mapping_size = size_t(length + start - aligned);
+
+                    void * address = mmap (nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file, aligned);
+
+                    close (file);
+
+                    if (address != MAP_FAILED)
+                    {
+                        mapping = address;
+                        bytes   = static_cast< const byte * >(address) + (start - aligned);
+                    }
+                }
+
+                // Los assets comprimidos los descomprime el propio gestor de assets en un buffer
+                // que pertenece al AAsset:
+
+                if (bytes == nullptr)
+                {
+                    bytes = static_cast< const byte * >(AAsset_getBuffer (handle));
+                }
+            }
+
+            return bytes;
+        }
+
         bool Android_Asset::read (uint8_t * buffer, size_t size)
         {
             if (size > 0)
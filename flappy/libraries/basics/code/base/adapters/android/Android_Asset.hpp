@@ -23,10 +23,13 @@
         class Android_Asset final : public Asset
         {
 
-            AAsset * handle;
-            size_t   cursor;
-            bool     failed;
-            bool     at_end;
+            AAsset     * handle;
+            size_t       cursor;
+            bool         failed;
+            bool         at_end;
+            void       * mapping;                           ///< Pages mapped with mmap() or nullptr.
+            size_t       mapping_size;
+            const byte * bytes;                             ///< Start of the contents once mapped.
 
         public:
 
@@ -46,6 +49,8 @@
             bool   read_all (std::vector< byte > & buffer) override;
             bool   read_all (std::string & buffer) override;
 
+            const byte * map () override;
+
         private:
 
             bool read (uint8_t * buffer, size_t size);
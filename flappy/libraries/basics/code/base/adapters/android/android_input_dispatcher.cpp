@@ -15,19 +15,63 @@
 #if defined(BASICS_ANDROID_OS)
 
     #include <basics/Director>
-    #include <basics/Id>
+    #include <basics/Touch_Batch>
     #include <android/input.h>
 
     namespace basics { namespace internal
     {
 
+        namespace
+        {
+
+            // Acumula las muestras de un evento de Android para entregarlas al director de una vez:
+
+            class Touch_Writer
+            {
+
+                static constexpr size_t capacity = 64;
+
+                Touch_Sample samples[capacity];
+                size_t       count;
+
+            public:
+
+                Touch_Writer() : count(0)
+                {
+                }
+
+               ~Touch_Writer()
+                {
+                    flush ();
+                }
+
+                void add (Touch_Sample::Phase phase, int32_t pointer_id, float x, float y, int64_t time)
+                {
+                    if (count == capacity) flush ();
+
+                    samples[count++] = Touch_Sample{ time, x, y, pointer_id, phase, false };
+                }
+
+                void flush ()
+                {
+                    if (count > 0) director.handle (samples, count);
+
+                    count = 0;
+                }
+
+            };
+
+        }
+
         int handle_motion_event (AInputEvent * android_event)
         {
             switch (AInputEvent_getSource (android_event))
             {
                 case AINPUT_SOURCE_TOUCHSCREEN:
                 {
-                    int32_t action = AMotionEvent_getAction (android_event);
+                    int32_t      action = AMotionEvent_getAction    (android_event);
+                    int64_t      time   = AMotionEvent_getEventTime (android_event);
+                    Touch_Writer writer;
 
                     switch (action & AMOTION_EVENT_ACTION_MASK)
                     {
@@ -36,34 +80,59 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-started));
-
-                            event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                            event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                            event[ID(y) ] = AMotionEvent_getY         (android_event, index);
-
-                            director.handle (event);
+                            writer.add
+                            (
+                                Touch_Sample::STARTED,
+                                AMotionEvent_getPointerId (android_event, index),
+                                AMotionEvent_getX         (android_event, index),
+                                AMotionEvent_getY         (android_event, index),
+                                time
+                            );
 
                             break;
                         }
 
                         case AMOTION_EVENT_ACTION_MOVE:
                         {
-                            // Parece ser que para el evento de movimiento el index que indica action es siempre cero,
-                            // por lo que no veo clara la manera de identificar el puntero que se ha movido. Por ello
-                            // se envían eventos de movimiento para todos los punteros...
+                            // Un evento de movimiento trae la posición actual de todos los punteros
+                            // y, agrupadas, las posiciones intermedias que ha habido desde el evento
+                            // anterior. El director se queda solo con la última de cada puntero en
+                            // cada fotograma, salvo que se le pida que conserve el historial:
 
                             size_t pointer_count = AMotionEvent_getPointerCount (android_event);
 
-                            for (size_t index = 0; index < pointer_count; ++index)
+                            if (director.is_keeping_touch_history ())
                             {
-                                Event event(ID(touch-moved));
-
-                                event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                                event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                                event[ID(y) ] = AMotionEvent_getY         (android_event, index);
+                                size_t history_size = AMotionEvent_getHistorySize (android_event);
+
+                                for (size_t sample = 0; sample < history_size; ++sample)
+                                {
+                                    int64_t sample_time = AMotionEvent_getHistoricalEventTime (android_event, sample);
+
+                                    for (size_t index = 0; index < pointer_count; ++index)
+                                    {
+                                        writer.add
+                                        (
+                                            Touch_Sample::MOVED,
+                                            AMotionEvent_getPointerId   (android_event, index),
+                                            AMotionEvent_getHistoricalX (android_event, index, sample),
+                                            AMotionEvent_getHistoricalY (android_event, index, sample),
+                                            sample_time
+                                        );
+                                    }
+                                }
+                            }
 
-                                director.handle (event);
+                            for (size_t index = 0; index < pointer_count; ++index)
+                            {
+                                writer.add
+                                (
+                                    Touch_Sample::MOVED,
+                                    AMotionEvent_getPointerId (android_event, index),
+                                    AMotionEvent_getX         (android_event, index),
+                                    AMotionEvent_getY         (android_event, index),
+                                    time
+                                );
                             }
 
                             break;
@@ -75,13 +144,14 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-ended));
-
-                            event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                            event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                            event[ID(y) ] = AMotionEvent_getY         (android_event, index);
-
-                            director.handle (event);
+                            writer.add
+                            (
+                                Touch_Sample::ENDED,
+                                AMotionEvent_getPointerId (android_event, index),
+                                AMotionEvent_getX         (android_event, index),
+                                AMotionEvent_getY         (android_event, index),
+                                time
+                            );
 
                             break;
                         }
@@ -0,0 +1,35 @@
+/*
+ * ACCELEROMETER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <basics/Accelerometer>
+    #include "Linux_Accelerometer.hpp"
+
+    namespace basics
+    {
+
+        bool Accelerometer::is_available ()
+        {
+            return true;
+        }
+
+        Accelerometer * Accelerometer::get_instance ()
+        {
+            static internal::Linux_Accelerometer accelerometer;
+
+            return &accelerometer;
+        }
+
+    }
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * LOG
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121825
+ */
+
+#include <basics/Log>
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdio>
+
+    namespace basics
+    {
+
+        static const char linux_log_priorities[] =
+        {
+            'V',
+            'D',
+            'I',
+            'W',
+            'E',
+            'F',
+        };
+
+        void Log::dump (Level level, const char * tag, const char * cstring)
+        {
+            // Se usa la salida de error, que no tiene buffer, para no perder mensajes si el proceso
+            // termina de manera abrupta:
+
+            std::fprintf (stderr, "%c/%s: %s\n", linux_log_priorities[level], tag ? tag : "*", cstring);
+        }
+
+        Log log;
+
+    }
+
+#endif
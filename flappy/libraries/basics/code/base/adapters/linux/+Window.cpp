@@ -0,0 +1,98 @@
+/*
+ * WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121815
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdio>
+    #include <cstdlib>
+    #include <basics/Window>
+    #include "Linux_Application.hpp"
+    #include "Offscreen_Window.hpp"
+
+    namespace basics
+    {
+
+        namespace internal
+        {
+
+            static std::shared_ptr< Offscreen_Window > default_window;
+
+            /**
+             * The size can be given as "<width>x<height>" through BASICS_WINDOW_SIZE. By default
+             * it's the one of a common portrait phone screen.
+             */
+            static Size2u get_default_window_size ()
+            {
+                Size2u       size{ 720, 1280 };
+                const char * text = std::getenv ("BASICS_WINDOW_SIZE");
+
+                if (text)
+                {
+                    unsigned width, height;
+
+                    if (std::sscanf (text, "%ux%u", &width, &height) == 2 && width > 0 && height > 0)
+                    {
+                        size = { width, height };
+                    }
+                }
+
+                return size;
+            }
+
+        }
+
+        #pragma RETAIN(Window::can_be_instantiated)
+
+        const bool Window::can_be_instantiated __attribute__((__used__)) = true;
+
+        Window::Handle Window::create_window (Id id)
+        {
+            if (id == default_window_id && !internal::default_window)
+            {
+                internal::default_window.reset (new internal::Offscreen_Window(id, internal::get_default_window_size ()));
+                internal::default_window->push (Event(GOT_FOCUS));
+
+                internal::application.push (Event(Application::WINDOW_CREATED));
+            }
+
+            return get_window (id);
+        }
+
+        bool Window::destroy_window (Id id)
+        {
+            if (id == default_window_id && internal::default_window)
+            {
+                internal::default_window.reset ();
+
+                internal::application.push (Event(Application::WINDOW_DESTROYED));
+
+                return true;
+            }
+
+            return false;
+        }
+
+        Window::Handle Window::get_window (Id id)
+        {
+            if (id == default_window_id && internal::default_window)
+            {
+                return Handle(internal::default_window);
+            }
+
+            return Handle();
+        }
+
+    }
+
+#endif
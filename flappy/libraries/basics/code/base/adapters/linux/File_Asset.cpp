@@ -0,0 +1,199 @@
+/*
+ * FILE ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121835
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdlib>
+    #include <sys/mman.h>
+    #include "File_Asset.hpp"
+
+    namespace basics { namespace internal
+    {
+
+        static std::string get_file_path (const std::string & path)
+        {
+            const char * root = std::getenv ("BASICS_ASSETS_PATH");
+
+            return std::string(root ? root : "assets") + '/' + path;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        File_Asset::File_Asset(const std::string & path)
+        {
+            handle  = std::fopen (get_file_path (path).c_str (), "rb");
+            length  = 0;
+            cursor  = 0;
+            failed  = handle == nullptr;
+            at_end  = false;
+            mapping = nullptr;
+
+            if (handle != nullptr)
+            {
+                if (std::fseek (handle, 0, SEEK_END) == 0)
+                {
+                    long end = std::ftell (handle);
+
+                    if (end >= 0) length = size_t(end);
+                }
+
+                failed = std::fseek (handle, 0, SEEK_SET) != 0;
+            }
+        }
+
+        File_Asset::~File_Asset()
+        {
+            if (mapping != nullptr)
+            {
+                munmap (mapping, length), mapping = nullptr;
+            }
+
+            if (handle != nullptr)
+            {
+                std::fclose (handle), handle = nullptr;
+            }
+        }
+
+        bool File_Asset::good () const
+        {
+            return not failed;
+        }
+
+        bool File_Asset::fail () const
+        {
+            return failed;
+        }
+
+        bool File_Asset::eof () const
+        {
+            return at_end;
+        }
+
+        size_t File_Asset::size () const
+        {
+            return good () ? length : 0;
+        }
+
+        bool File_Asset::seek (ptrdiff_t offset, Anchor anchor)
+        {
+            if (good ())
+            {
+                if (std::fseek (handle, long(offset), anchor == BEGINNING ? SEEK_SET : anchor == END ? SEEK_END : SEEK_CUR) == 0)
+                {
+                    cursor = size_t(std::ftell (handle));
+                    at_end = false;
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        size_t File_Asset::tell () const
+        {
+            return cursor;
+        }
+
+        byte File_Asset::read ()
+        {
+            byte data = 0;
+
+            if (good ())
+            {
+                read (&data, 1);
+            }
+
+            return data;
+        }
+
+        bool File_Asset::read_all (std::vector< byte > & buffer)
+        {
+            if (good () && seek (0, BEGINNING))
+            {
+                buffer.resize (length);
+
+                return read (buffer.data (), length);
+            }
+
+            return false;
+        }
+
+        bool File_Asset::read_all (std::string & buffer)
+        {
+            if (good () && seek (0, BEGINNING))
+            {
+                buffer.resize (length);
+
+                return read ((uint8_t *)&buffer[0], length);
+            }
+
+            return false;
+        }
+
+        const byte * File_Asset::map ()
+        {
+            if (mapping == nullptr && good ())
+            {
+                // mmap() doesn't accept empty ranges, but any valid address will do for them:
+
+                if (length == 0)
+                {
+                    static const byte nothing = 0;
+
+                    return &nothing;
+                }
+
+                void * address = mmap (nullptr, length, PROT_READ, MAP_PRIVATE, fileno (handle), 0);
+
+                if (address == MAP_FAILED)
+                {
+                    return nullptr;
+                }
+
+                mapping = address;
+            }
+
+            return static_cast< const byte * >(mapping);
+        }
+
+        bool File_Asset::read (uint8_t * buffer, size_t size)
+        {
+            if (size > 0)
+            {
+                size_t result = std::fread (buffer, 1, size, handle);
+
+                cursor += result;
+
+                if (result == size)
+                {
+                    return true;
+                }
+                else
+                if (std::feof (handle))
+                {
+                    at_end = true;
+                }
+                else
+                    failed = true;
+
+                return false;
+            }
+
+            return true;
+        }
+
+    }}
+
+#endif
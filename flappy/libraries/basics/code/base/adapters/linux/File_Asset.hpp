@@ -0,0 +1,65 @@
+/*
+ * FILE ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121830
+ */
+
+#ifndef BASICS_FILE_ASSET_HEADER
+#define BASICS_FILE_ASSET_HEADER
+
+    #include <cstdio>
+    #include <basics/Asset>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Asset read from a regular file. The paths are relative to the folder that
+         * BASICS_ASSETS_PATH names or, by default, to the "assets" folder of the working directory,
+         * so that they're the same ones used inside the APK.
+         */
+        class File_Asset final : public Asset
+        {
+
+            std::FILE * handle;
+            size_t      length;
+            size_t      cursor;
+            bool        failed;
+            bool        at_end;
+            void      * mapping;                            ///< Address returned by mmap() or nullptr.
+
+        public:
+
+            File_Asset(const std::string & path);
+           ~File_Asset();
+
+        public:
+
+            bool   good () const override;
+            bool   fail () const override;
+            bool   eof  () const override;
+
+            size_t size () const override;
+            bool   seek (ptrdiff_t offset, Anchor = CURRENT) override;
+            size_t tell () const override;
+            byte   read () override;
+            bool   read_all (std::vector< byte > & buffer) override;
+            bool   read_all (std::string & buffer) override;
+
+            const byte * map () override;
+
+        private:
+
+            bool read (uint8_t * buffer, size_t size);
+
+        };
+
+    }}
+
+#endif
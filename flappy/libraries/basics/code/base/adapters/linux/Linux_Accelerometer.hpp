@@ -0,0 +1,47 @@
+/*
+ * LINUX ACCELEROMETER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_LINUX_ACCELEROMETER_HEADER
+#define BASICS_LINUX_ACCELEROMETER_HEADER
+
+    #include <basics/Accelerometer>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * There is no sensor behind it: its state stays at rest (1 g towards -Y, as a phone held
+         * upright) unless somebody changes it with set_state().
+         */
+        class Linux_Accelerometer final : public Accelerometer
+        {
+        public:
+
+            Linux_Accelerometer()
+            {
+                set_state (0.f, -9.80665f, 0.f);
+            }
+
+        public:
+
+            bool switch_on  () override
+            {
+                return true;
+            }
+
+            void switch_off () override
+            {
+            }
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,296 @@
+/*
+ * LINUX APPLICATION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121805
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <chrono>
+    #include <cstdlib>
+    #include <cstring>
+    #include <fstream>
+    #include <sstream>
+    #include <string>
+    #include <basics/Director>
+    #include <basics/Log>
+    #include <basics/Profiler>
+    #include <basics/Window>
+    #include "Linux_Application.hpp"
+
+    namespace basics { namespace internal
+    {
+
+        Linux_Application::Linux_Application()
+        {
+            frame            = 0;
+            profile_frames   = 0;
+            profile_start    = 0;
+            save_frame_index = 0;
+
+            // There is nothing that could keep a headless process in the background:
+
+            state = INTERACTIVE;
+
+            push (Event(RESUME));
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Linux_Application::prepare_events ()
+        {
+            if (frame == 0)
+            {
+                // The environment is read here instead of in the constructor because the log and
+                // the director may not be constructed yet at that moment:
+
+                const char * script_path = std::getenv ("BASICS_SCRIPT");
+                const char * frame_limit = std::getenv ("BASICS_FRAME_LIMIT");
+                const char * pipelining  = std::getenv ("BASICS_PIPELINING");
+                const char * profile     = std::getenv ("BASICS_PROFILE");
+                const char * profile_to  = std::getenv ("BASICS_PROFILE_PATH");
+                const char * overlay     = std::getenv ("BASICS_OVERLAY");
+                const char * font        = std::getenv ("BASICS_OVERLAY_FONT");
+                const char * statistics  = std::getenv ("BASICS_FRAME_STATISTICS");
+                const char * save_frame  = std::getenv ("BASICS_SAVE_FRAME");
+
+                if (script_path && !load_script (script_path))
+                {
+                    log.e (std::string("ERROR: failed to load the script ") + script_path);
+                }
+
+                if (frame_limit)
+                {
+                    schedule (unsigned(std::strtoul (frame_limit, nullptr, 10)), KERNEL, Event(QUIT));
+                }
+
+                if (pipelining)
+                {
+                    director.set_pipelining (std::strcmp (pipelining, "0") != 0);
+                }
+
+                if (profile)
+                {
+                    const char * start = std::strchr (profile, '@');
+
+                    profile_frames = unsigned(std::strtoul (profile, nullptr, 10));
+                    profile_start  = start ? unsigned(std::strtoul (start + 1, nullptr, 10)) : 0;
+                    profile_path   = profile_to ? profile_to : "profile.json";
+                }
+
+                if (overlay && std::strcmp (overlay, "0") != 0)
+                {
+                    director.show_performance_overlay (true);
+                }
+
+                if (font)
+                {
+                    director.set_performance_overlay_font (font);
+                }
+
+                if (statistics && std::strcmp (statistics, "0") != 0)
+                {
+                    director.report_frame_statistics_on_exit (true);
+                }
+
+                // BASICS_SAVE_FRAME=<frame>@<path> saves the image of that frame (counted from 0)
+                // when the backend supports it, as the golden frames of the regression checks:
+
+                if (save_frame)
+                {
+                    const char * at = std::strchr (save_frame, '@');
+
+                    if (at && at[1])
+                    {
+                        save_frame_index = unsigned(std::strtoul (save_frame, nullptr, 10));
+                        save_frame_path  = at + 1;
+                    }
+                    else
+                        log.e ("ERROR: BASICS_SAVE_FRAME must be <frame>@<path>");
+                }
+            }
+
+            // The frame has been presented when the next one starts:
+
+            if (!save_frame_path.empty () && frame == save_frame_index + 1 && !director.save_frame (save_frame_path))
+            {
+                log.e ("ERROR: failed to save the frame " + std::to_string (save_frame_index) + " to " + save_frame_path);
+            }
+
+            if (profile_frames > 0 && frame == profile_start)
+            {
+                profiler.capture (profile_frames, profile_path);
+            }
+
+            dispatch (frame++);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Linux_Application::schedule (unsigned frame, Target target, const Event & event)
+        {
+            script.insert (Script::value_type(frame, Scripted_Event{ target, event }));
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        bool Linux_Application::load_script (std::istream & input)
+        {
+            static const struct { const char * name; Event_Id id; } kernel_events[] =
+            {
+                { "restart",               RESTART               },
+                { "resume",                RESUME                },
+                { "suspend",               SUSPEND               },
+                { "squeeze",               SQUEEZE               },
+                { "quit",                  QUIT                  },
+                { "configuration-changed", CONFIGURATION_CHANGED },
+            };
+
+            std::string line;
+
+            while (std::getline (input, line))
+            {
+                line = line.substr (0, line.find ('#'));
+
+                std::istringstream fields(line);
+                unsigned           event_frame;
+                std::string        name;
+
+                if (!(fields >> event_frame))
+                {
+                    if (line.find_first_not_of (" \t\r") == std::string::npos) continue;
+
+                    return false;
+                }
+
+                if (!(fields >> name)) return false;
+
+                Target target = name.compare (0, 7, "window-") == 0 ? WINDOW : SCENE;
+                Event  event(fnv32 (name));
+
+                for (auto & kernel_event : kernel_events)
+                {
+                    if (name == kernel_event.name)
+                    {
+                        target   = KERNEL;
+                        event.id = kernel_event.id;
+                    }
+                }
+
+                std::string property;
+
+                while (fields >> property)
+                {
+                    size_t separator = property.find ('=');
+
+                    if (separator == std::string::npos) return false;
+
+                    std::string key   = property.substr (0, separator);
+                    std::string value = property.substr (separator + 1);
+                    Var       & slot  = event[fnv32 (key)];
+
+                    if (value == "true" ) slot = true;  else
+                    if (value == "false") slot = false; else
+                    if (key   == "id"   ) slot = int32_t(std::strtol (value.c_str (), nullptr, 10));
+                    else                  slot = std::strtof (value.c_str (), nullptr);
+                }
+
+                schedule (event_frame, target, event);
+            }
+
+            return input.eof ();
+        }
+
+        bool Linux_Application::load_script (const char * path)
+        {
+            std::ifstream input(path);
+
+            return input.good () && load_script (input);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Linux_Application::dispatch (unsigned frame)
+        {
+            auto range = script.equal_range (frame);
+
+            for (auto i = range.first; i != range.second; ++i)
+            {
+                Event & event = i->second.event;
+
+                switch (i->second.target)
+                {
+                    case KERNEL:
+                    {
+                        switch (event.id)
+                        {
+                            case RESUME:  state = INTERACTIVE; break;
+                            case SUSPEND: state = SUSPENDED;   break;
+                            case QUIT:    state = DESTROYED;   break;
+                        }
+
+                        prepared_events.push_back (event);
+                        break;
+                    }
+
+                    case WINDOW:
+                    {
+                        Window::Accessor window = Window::get_window (default_window_id).lock ();
+
+                        if (window) window->push (event);
+
+                        break;
+                    }
+
+                    case SCENE:
+                    {
+                        // The touches go through the same batches as the ones of a real screen:
+
+                        Touch_Sample::Phase phase;
+
+                        switch (event.id)
+                        {
+                            case ID(touch-started): phase = Touch_Sample::STARTED; break;
+                            case ID(touch-moved):   phase = Touch_Sample::MOVED;   break;
+                            case ID(touch-ended):   phase = Touch_Sample::ENDED;   break;
+
+                            default:
+                            {
+                                director.handle (event);
+                                continue;
+                            }
+                        }
+
+                        var::Int32 * id = event[ID(id)].as< var::Int32 > ();
+                        var::Float * x  = event[ID(x) ].as< var::Float > ();
+                        var::Float * y  = event[ID(y) ].as< var::Float > ();
+
+                        Touch_Sample touch;
+
+                        touch.time       = std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+                        touch.x          = x  ? float  (*x ) : 0.f;
+                        touch.y          = y  ? float  (*y ) : 0.f;
+                        touch.pointer_id = id ? int32_t(*id) : 0;
+                        touch.phase      = phase;
+                        touch.historical = false;
+
+                        director.handle (touch);
+                        break;
+                    }
+                }
+            }
+
+            script.erase (range.first, range.second);
+        }
+
+    }}
+
+#endif
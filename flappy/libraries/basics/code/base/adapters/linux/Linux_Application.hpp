@@ -0,0 +1,128 @@
+/*
+ * LINUX APPLICATION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121800
+ */
+
+#ifndef BASICS_LINUX_APPLICATION_HEADER
+#define BASICS_LINUX_APPLICATION_HEADER
+
+    #include <atomic>
+    #include <istream>
+    #include <map>
+    #include <string>
+    #include <basics/Application>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Application of a plain Linux process, without any window system. Since nobody else
+         * generates its events, they are read from a script that tells in which frame each one
+         * must be delivered. The script is loaded from the file that BASICS_SCRIPT names (if any)
+         * and BASICS_FRAME_LIMIT can be used to quit after a given number of frames. Setting
+         * BASICS_PIPELINING to 0 or 1 forbids or allows the render thread of the Director.
+         * BASICS_PROFILE="<frames>[@<frame>]" captures that many frames with the profiler from the
+         * given frame (0 by default) and writes them to BASICS_PROFILE_PATH (profile.json by
+         * default) in the trace event format of Chrome. BASICS_OVERLAY=1 shows the performance
+         * overlay (with the font that BASICS_OVERLAY_FONT names, if any) and
+         * BASICS_FRAME_STATISTICS=1 logs the summary of the frame times when the kernel stops.
+         *
+         * Each line of a script has the form "<frame> <event> [<property>=<value> ...]":
+         *
+         *     0   touch-started id=0 x=360 y=640
+         *     1   touch-ended   id=0 x=360 y=640
+         *     300 quit
+         *
+         * The application events (resume, suspend, restart, squeeze, quit, configuration-changed)
+         * go to the kernel, the ones whose name starts with "window-" go to the default window and
+         * the rest go to the scene through the Director. The values are stored as floats, except the
+         * ones of the property "id" (ints, like the Android dispatcher does) and true/false (bools).
+         * Everything after a # is a comment.
+         */
+        class Linux_Application : public Application
+        {
+        public:
+
+            enum Target
+            {
+                KERNEL,
+                WINDOW,
+                SCENE
+            };
+
+        private:
+
+            struct Scripted_Event
+            {
+                Target target;
+                Event  event;
+            };
+
+            typedef std::multimap< unsigned, Scripted_Event > Script;
+
+        private:
+
+            std::atomic< Application::State > state;
+
+            Script      script;
+            unsigned    frame;                              ///< Frames the kernel has started so far.
+
+            unsigned    profile_frames;                     ///< Frames to capture with the profiler.
+            unsigned    profile_start;
+            std::string profile_path;
+
+            unsigned    save_frame_index;                   ///< Frame whose image is saved to save_frame_path (if any).
+            std::string save_frame_path;
+
+        public:
+
+            Linux_Application();
+
+        public:
+
+            State get_state () const override
+            {
+                return state;
+            }
+
+            void set_state (State new_state)
+            {
+                state = new_state;
+            }
+
+            unsigned get_frame () const
+            {
+                return frame;
+            }
+
+        protected:
+
+            /**
+             * Delivers the scripted events of a new frame before the kernel drains the queue.
+             */
+            void prepare_events () override;
+
+        public:
+
+            void schedule    (unsigned frame, Target target, const Event & event);
+            bool load_script (std::istream & input);
+            bool load_script (const char * path);
+
+        private:
+
+            void dispatch (unsigned frame);
+
+        };
+
+        extern Linux_Application application;
+
+    }}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * OFFSCREEN WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121810
+ */
+
+#ifndef BASICS_OFFSCREEN_WINDOW_HEADER
+#define BASICS_OFFSCREEN_WINDOW_HEADER
+
+    #include <basics/Window>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Window that isn't shown anywhere. It only has a size, so the graphics contexts created
+         * for it must render into memory. It's always available and focused.
+         */
+        class Offscreen_Window final : public Window
+        {
+        public:
+
+            class Accessor : public Window::Accessor
+            {
+            public:
+
+                Offscreen_Window * get ()
+                {
+                    return static_cast< Offscreen_Window * >(window.get ());
+                }
+
+            };
+
+        private:
+
+            Size2u size;
+
+        public:
+
+            Offscreen_Window(Id id, const Size2u & size) : Window(id), size(size)
+            {
+                available = true;
+                focused   = true;
+            }
+
+        public:
+
+            Graphics_Context * get_graphics_context ()
+            {
+                return graphics.context.get ();
+            }
+
+            Size2u get_size () override
+            {
+                return size;
+            }
+
+            unsigned get_width () override
+            {
+                return size.width;
+            }
+
+            unsigned get_height () override
+            {
+                return size.height;
+            }
+
+        };
+
+    }}
+
+#endif
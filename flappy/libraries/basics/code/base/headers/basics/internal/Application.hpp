@@ -14,7 +14,9 @@
 #define BASICS_APPLICATION_HEADER
 
     #include <memory>
+    #include <vector>
     #include <basics/Event_Queue>
+    #include <basics/Profiler>
 
     namespace basics
     {
@@ -49,7 +51,16 @@
 
         protected:
 
-            Event_Queue event_queue;
+            // The lifecycle events can't be lost and the kernel drains them every frame, so a push
+            // waits in the unlikely case that the queue is full:
+
+            Event_Queue event_queue{ 64, Overflow_Policy::BLOCK };
+
+            // The kernel is the only consumer of the queue, so the events that it generates itself
+            // in prepare_events() can't be pushed (they could fill it and wait forever). They're
+            // left here and passed to the callback of drain() after the queued ones:
+
+            std::vector< Event > prepared_events;
 
         protected:
 
@@ -69,12 +80,52 @@
 
             void push (Event && event)
             {
-                event_queue.push (event);
+                event_queue.push (std::move (event));
             }
 
             bool poll (Event & event)
             {
-                return event_queue.poll (event);
+                return event_queue.pop (event);
+            }
+
+            /**
+             * The kernel drains this queue once per frame, passing each event to the callback.
+             */
+            template< typename CALLBACK >
+            size_t drain (CALLBACK && callback)
+            {
+                BASICS_PROFILE_ZONE ("application-events");
+
+                prepare_events ();
+
+                size_t count = event_queue.drain (callback);
+
+                for (Event & event : prepared_events)
+                {
+                    callback (event);
+                }
+
+                count += prepared_events.size ();
+
+                prepared_events.clear ();
+
+                return count;
+            }
+
+            const Event_Queue & get_event_queue () const
+            {
+                return event_queue;
+            }
+
+        protected:
+
+            /**
+             * Called by the kernel right before the events are drained. Platforms that generate
+             * their events themselves (like the headless one) can override it to add them to
+             * prepared_events at that moment.
+             */
+            virtual void prepare_events ()
+            {
             }
 
         };
@@ -32,12 +32,58 @@
                 END
             };
 
+            /**
+             * Read-only bytes of an asset. The view keeps the asset open, so the bytes stay valid
+             * while any copy of it exists.
+             */
+            class View
+            {
+
+                std::shared_ptr< Asset > asset;
+                const byte             * bytes;
+                size_t                   length;
+
+            public:
+
+                View() : bytes(nullptr), length(0)
+                {
+                }
+
+                View(const std::shared_ptr< Asset > & asset, const byte * bytes, size_t length)
+                :
+                    asset (asset ),
+                    bytes (bytes ),
+                    length(length)
+                {
+                }
+
+            public:
+
+                const byte * data  () const { return bytes;          }
+                size_t       size  () const { return length;         }
+                bool         empty () const { return length == 0;    }
+                const byte * begin () const { return bytes;          }
+                const byte * end   () const { return bytes + length; }
+
+                explicit operator bool () const
+                {
+                    return bytes != nullptr;
+                }
+
+            };
+
         public:
 
             static std::shared_ptr< Asset > open (const std::string & path);
             static bool exists (const std::string & path);
             static size_t size (const std::string & path);
 
+            /**
+             * Opens an asset and maps its whole contents. The returned view is empty and evaluates
+             * to false if the asset doesn't exist or can't be read.
+             */
+            static View map (const std::string & path);
+
         protected:
 
             Asset() = default;
@@ -58,6 +104,13 @@
             virtual bool   read_all (std::vector< byte > & buffer) = 0;
             virtual bool   read_all (std::string & buffer) = 0;
 
+            /**
+             * Gives access to the whole contents without copying them into the caller's memory
+             * (when the platform allows it, the file is mapped). The bytes belong to the asset and
+             * they're valid until it's destroyed. Returns nullptr on failure.
+             */
+            virtual const byte * map () = 0;
+
         };
 
     }
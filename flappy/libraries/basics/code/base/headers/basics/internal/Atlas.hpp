@@ -13,20 +13,42 @@
 #ifndef BASICS_ATLAS_HEADER
 #define BASICS_ATLAS_HEADER
 
-    #include <map>
+    #include <algorithm>
     #include <memory>
     #include <string>
     #include <vector>
-    #include <rapidxml.hpp>
+    #include <basics/Asset>
     #include <basics/Id>
+    #include <basics/Id_Map>
     #include <basics/Point>
     #include <basics/Size>
     #include <basics/Texture_2D>
     #include <basics/Graphics_Context>
+    #include <basics/Xml_Scanner>
 
     namespace basics
     {
 
+        /**
+         * Slices of a texture. They can be read from a .sprites file (XML) or, preferably, from a
+         * binary atlas (.batlas) generated from it with basics-atlas-converter, which is mapped
+         * and used as is:
+         *
+         *     0   "BATL"
+         *     4   uint16 version
+         *     6   uint16 reserved
+         *     8   uint32 record count
+         *    12   uint32 texture width
+         *    16   uint32 texture height
+         *    20   uint32 offset of the texture name (relative to the atlas, without terminator)
+         *    24   uint32 length of the texture name
+         *    28   uint32 reserved
+         *    32   Record array sorted by id, followed by the texture name
+         *
+         * The values are stored in little endian order (the one of every supported target), so
+         * the records can be read through a pointer to the mapped data and searched by id with a
+         * binary search.
+         */
         class Atlas
         {
         public:
@@ -34,35 +56,94 @@
             struct Slice
             {
                 Atlas * atlas;
-                float   left;
+                float   left;                               ///< Pixels.
                 float   right;
                 float   bottom;
                 float   top;
                 float   width;
                 float   height;
+                float   uv_left;                            ///< Normalized texture coordinates.
+                float   uv_right;
+                float   uv_bottom;
+                float   uv_top;
             };
 
+            /**
+             * A slice as stored in a binary atlas.
+             */
+            struct Record
+            {
+                uint32_t id;
+                float    left;
+                float    right;
+                float    bottom;
+                float    top;
+                float    width;
+                float    height;
+                float    uv_left;
+                float    uv_right;
+                float    uv_bottom;
+                float    uv_top;
+            };
+
+            static constexpr unsigned version     = 1;
+            static constexpr size_t   header_size = 32;
+
         private:
 
             typedef std::shared_ptr< Texture_2D > Texture_Handle;
-            typedef std::map< Id, Slice >         Slice_Map;
-            typedef std::vector< byte >           Buffer;
+            typedef Id_Map< Slice >               Slice_Map;
 
         private:
 
-            Texture_Handle texture;
-            Slice_Map      slices;
+            Texture_Handle          texture;
+            Slice_Map               slices;                 ///< Slices added with add_slice().
+
+            Asset::View             binary_data;            ///< Mapped binary atlas.
+            std::vector< Record >   own_records;            ///< Records read from XML (or copied from
+            const Record          * records;                ///< a binary atlas that isn't aligned).
+            size_t                  record_count;
+            std::vector< Slice >    record_slices;          ///< Parallel to records.
+
+        public:
+
+            /**
+             * Path of the binary atlas that replaces a .sprites file (the extension is replaced by .batlas).
+             */
+            static std::string get_binary_path_for (const std::string & path);
+
+            /**
+             * Converts the text of a .sprites file into a binary atlas. The size of the texture is
+             * taken from the attributes w and h of the tag img.
+             */
+            static bool encode (const char * sprites_text, size_t size, std::vector< byte > & binary_atlas);
 
         public:
 
+            /**
+             * Reads the slices from the given file (.sprites or .batlas). The binary atlas next to a
+             * .sprites file is used instead of it when it exists.
+             */
             Atlas(const std::string    & path, Graphics_Context::Accessor & context);
             Atlas(const Texture_Handle & texture);
 
+            /**
+             * Reads the slices from the given file (or its binary atlas), but uses a texture that has
+             * already been loaded (for example, by a Texture_Loader) instead of the one named by it.
+             */
+            Atlas(const std::string    & path, const Texture_Handle & texture);
+
+            /**
+             * Reads the slices from the text of a .sprites file that is already in memory. The
+             * texture named by it isn't loaded.
+             */
+            Atlas(const char * sprites_text, size_t size, const Texture_Handle & texture = Texture_Handle());
+
         public:
 
             bool good () const
             {
-                return texture.get () != nullptr && slices.size () > 0;
+                return texture.get () != nullptr && (slices.size () > 0 || record_count > 0);
             }
 
             const Texture_Handle & get_texture () const
@@ -70,8 +151,24 @@
                 return texture;
             }
 
+            size_t get_slice_count () const
+            {
+                return record_count + slices.size ();
+            }
+
             const Slice * get_slice (Id id) const
             {
+                if (record_count > 0)
+                {
+                    const Record * end    = records + record_count;
+                    const Record * record = std::lower_bound
+                    (
+                        records, end, id, [] (const Record & record, Id id) { return record.id < id; }
+                    );
+
+                    if (record != end && record->id == id) return &record_slices[record - records];
+                }
+
                 Slice_Map::const_iterator slice = slices.find (id);
 
                 return slice != slices.end () ? &slice->second : nullptr;
@@ -83,6 +180,7 @@
              * @param position Coordenadas del vértice inferior izquierdo del slice sobre la textura.
              * @param size Tamaño del slice dentro de la textura.
              * @return Puntero al slice si no existía otro con el mismo id o nullptr en caso contrario.
+             *         Deja de ser válido al añadir otro slice (se puede volver a obtener con get_slice()).
              */
             Slice * add_slice (Id id, const Point2f & position, const Size2f & size);
 
@@ -93,10 +191,12 @@
 
         private:
 
-            void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor & context);
-            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context);
-            void parse_dir (rapidxml::xml_node<> * dir_tag, const std::string & prefix = std::string());
-            void parse_spr (rapidxml::xml_node<> * spr_tag, const std::string & id);
+            bool load      (const Asset::View & binary_data, const std::string & path, Graphics_Context::Accessor & context);
+            void index     (const Record * records, size_t count);
+            void parse     (const char * text, size_t size, const std::string & path, Graphics_Context::Accessor & context);
+            void parse_img (Xml_Scanner & xml, const std::string & path, Graphics_Context::Accessor & context);
+            bool parse_dir (Xml_Scanner & xml, uint32_t prefix, bool has_prefix);
+            bool parse_spr (Xml_Scanner & xml, uint32_t prefix);
 
         };
 
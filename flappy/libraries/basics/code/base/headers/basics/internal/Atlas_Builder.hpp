@@ -0,0 +1,200 @@
+/*
+ * ATLAS BUILDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802241000
+ */
+
+#ifndef BASICS_ATLAS_BUILDER_HEADER
+#define BASICS_ATLAS_BUILDER_HEADER
+
+    #include <atomic>
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Color_Buffer>
+    #include <basics/Graphics_Context>
+    #include <basics/Id>
+    #include <basics/Id_Map>
+    #include <basics/Non_Copyable>
+    #include <basics/Thread_Pool>
+
+    namespace basics
+    {
+
+        /**
+         * Packs images that are loaded separately into one or a few shared pages at run time, so
+         * that the sprites that use them can be drawn without switching textures. The images are
+         * decoded and packed (with a skyline packer) in a background thread after start(), and
+         * upload() creates a texture and an Atlas for each page once that's done. The slices
+         * returned by get_slice() can be drawn with Canvas::fill_rectangle() as any other slice.
+         *
+         * Every image is surrounded by a border that repeats its edge pixels (extrusion) plus some
+         * empty space (padding), so that the bilinear filtering never picks texels of neighbours.
+         */
+        class Atlas_Builder : Non_Copyable
+        {
+        public:
+
+            struct Settings
+            {
+                unsigned page_width;                        ///< Maximum size of a page. The pages
+                unsigned page_height;                       ///< are cropped to the space used.
+                unsigned padding;                           ///< Empty pixels between the images.
+                unsigned extrusion;                         ///< Pixels that repeat the edges of each image.
+            };
+
+            struct Page_Occupancy
+            {
+                unsigned width;
+                unsigned height;
+                size_t   used_pixels;                       ///< Pixels of the images, without borders.
+
+                float get_ratio () const
+                {
+                    return width && height ? float(used_pixels) / float(size_t(width) * height) : 0.f;
+                }
+            };
+
+        private:
+
+            struct Image
+            {
+                Id                       id;
+                std::string              asset_path;        ///< Empty when the pixels were given.
+                Color_Buffer< Rgba8888 > pixels;            ///< Released once copied into its page.
+                unsigned                 width;
+                unsigned                 height;
+                unsigned                 page;
+                unsigned                 x;                 ///< Position of the border on the page.
+                unsigned                 y;
+            };
+
+            struct Page
+            {
+                Color_Buffer< Rgba8888 > pixels;
+                Page_Occupancy           occupancy;
+            };
+
+            // The background thread only touches this part, which outlives the builder if needed:
+
+            struct Shared_State
+            {
+                Settings                 settings;
+                std::vector< Image >     images;
+                std::vector< Page  >     pages;
+                bool                     good;
+                std::atomic< bool >      packed;
+                std::atomic< bool >      cancelled;
+            };
+
+            typedef std::unique_ptr< Atlas > Atlas_Handle;
+
+        private:
+
+            std::shared_ptr< Shared_State >      shared;
+            std::vector< Atlas_Handle >          atlases;
+            Id_Map< const Atlas::Slice * >       slices;
+            std::vector< Page_Occupancy >        occupancy;
+            bool                                 started;
+            bool                                 uploaded;
+            std::unique_ptr< Thread_Pool >       thread_pool;   ///< Declared last to be joined first.
+
+        public:
+
+            static constexpr Settings default_settings = { 2048, 2048, 2, 1 };
+
+            explicit Atlas_Builder(const Settings & settings = default_settings);
+
+           ~Atlas_Builder();
+
+        public:
+
+            /**
+             * Adds an image that will be read and decoded from an asset. The images must be added
+             * before calling start().
+             */
+            void add (Id id, const std::string & asset_path);
+
+            /**
+             * Adds an image whose pixels are already decoded (they're copied).
+             */
+            void add (Id id, const Color_Buffer< Rgba8888 > & pixels);
+
+            /**
+             * Decodes and packs the images in a background thread.
+             */
+            void start ();
+
+            /**
+             * Creates the textures of the pages once the packing has finished. It must be called
+             * from the thread that owns the context.
+             * @return true once the atlases are ready (or have failed, see good()).
+             */
+            bool upload (Graphics_Context::Accessor & context);
+
+        public:
+
+            bool is_started () const
+            {
+                return started;
+            }
+
+            bool is_packed () const
+            {
+                return shared->packed;
+            }
+
+            bool is_uploaded () const
+            {
+                return uploaded;
+            }
+
+            /**
+             * true when every image has been decoded, packed and uploaded.
+             */
+            bool good () const
+            {
+                return uploaded && !atlases.empty ();
+            }
+
+            const Atlas::Slice * get_slice (Id id) const
+            {
+                auto slice = slices.find (id);
+
+                return slice != slices.end () ? slice->second : nullptr;
+            }
+
+            unsigned get_page_count () const
+            {
+                return unsigned(atlases.size ());
+            }
+
+            const Atlas & get_atlas (unsigned page) const
+            {
+                return *atlases[page];
+            }
+
+            /**
+             * How much of each page is used by the images (available after upload()).
+             */
+            const std::vector< Page_Occupancy > & get_occupancy () const
+            {
+                return occupancy;
+            }
+
+        private:
+
+            static void pack (Shared_State & shared);
+
+        };
+
+    }
+
+#endif
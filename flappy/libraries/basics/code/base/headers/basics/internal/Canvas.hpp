@@ -57,6 +57,23 @@
                 Size2u size;
             };
 
+            /**
+             * What the drawing of a frame cost to the backend. The counters accumulate from the
+             * last reset, which happens on clear() and at the end of every frame (the Director
+             * keeps a copy of them before). Only the canvases that draw through a GPU fill them.
+             */
+            struct Frame_Stats
+            {
+                unsigned draw_calls;
+                unsigned vertices;                      ///< Submitted by the draw calls.
+                unsigned quads;                         ///< Merged into the draw calls by the backends that batch them.
+                unsigned program_switches;
+                unsigned texture_binds;
+                unsigned uniform_uploads;
+                size_t   bytes_streamed;                ///< Vertex data sent along with the draw calls.
+                size_t   texture_upload_bytes;          ///< Pixels of the textures created in the frame.
+            };
+
         public:
 
             typedef Canvas * (* Factory) (Id id, Graphics_Context::Accessor & context, const Options & options);
@@ -82,6 +99,15 @@
 
         protected:
 
+            Frame_Stats frame_stats;
+
+        protected:
+
+            Canvas()
+            {
+                reset_frame_stats ();
+            }
+
             virtual ~Canvas() = default;
 
         public:
@@ -92,6 +118,13 @@
 
             virtual void set_size        (const Size2u & size) { }
 
+            /**
+             * Chooses the layer of the following drawings. The canvases that draw immediately
+             * ignore it, but a Render_Queue replays the layers in increasing order and may group the
+             * opaque drawings (Blending NONE) of a layer by texture, so they shouldn't overlap.
+             */
+            virtual void set_layer       (unsigned layer) { }
+
         public:
 
             virtual void set_clear_color (float r, float g, float b) { }
@@ -114,6 +147,26 @@
             virtual void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) { }
             virtual void draw_text       (const Point2f & where, const Text_Layout & text_layout, int handling = TOP | LEFT);
 
+        public:
+
+            /**
+             * Submits the drawing that the canvas may have deferred. The Director calls it once at
+             * the end of every frame, right before presenting it.
+             */
+            virtual void flush           () { }
+
+        public:
+
+            const Frame_Stats & get_frame_stats () const
+            {
+                return frame_stats;
+            }
+
+            void reset_frame_stats ()
+            {
+                frame_stats = Frame_Stats();
+            }
+
         };
 
     }
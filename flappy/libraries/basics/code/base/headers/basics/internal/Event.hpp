@@ -13,9 +13,9 @@
 #ifndef BASICS_EVENT_HEADER
 #define BASICS_EVENT_HEADER
 
-    #include <map>
     #include <basics/fnv>
     #include <basics/Id>
+    #include <basics/Tiny_Map>
     #include <basics/Var>
 
     namespace basics
@@ -25,7 +25,12 @@
         {
         public:
 
-            typedef std::map< Id, Var > Property_List;      // REEMPLAZAR POR UN MAPA "LIGERO"
+            // Las propiedades se guardan dentro del propio evento, por lo que crearlo, copiarlo o
+            // sacarlo de una cola no reserva memoria dinámica. Las que no caben se descartan:
+
+            static constexpr size_t max_properties = 8;
+
+            typedef Tiny_Map< Id, Var, max_properties > Property_List;
 
         public:
 
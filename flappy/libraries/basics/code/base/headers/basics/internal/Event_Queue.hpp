@@ -13,71 +13,22 @@
 #ifndef BASICS_EVENT_QUEUE_HEADER
 #define BASICS_EVENT_QUEUE_HEADER
 
-    #include <queue>
-    #include <mutex>
     #include <basics/Event>
+    #include <basics/Ring_Queue>
 
     namespace basics
     {
 
-        class Event_Queue
-        {
+        /**
+         * Events that any thread can push (the lifecycle callbacks of the platform, the window
+         * system...) and that the kernel drains once per frame.
+         */
+        typedef Mpsc_Queue< Event > Event_Queue;
 
-            std::queue< Event > queue;
-            std::mutex          mutex;
-
-        public:
-
-            void clear ()
-            {
-                std::queue< Event >().swap (queue);
-            }
-
-            void push (const Event & event)
-            {
-                std::lock_guard< std::mutex > lock(mutex);
-
-                queue.push (event);
-            }
-
-            void push (Event && event)
-            {
-                std::lock_guard< std::mutex > lock(mutex);
-
-                queue.push (event);
-            }
-
-            bool poll (Event & event)
-            {
-                std::lock_guard< std::mutex > lock(mutex);
-
-                if (queue.size () > 0)
-                {
-                    event = queue.front ();
-
-                    queue.pop ();
-
-                    return true;
-                }
-
-                return false;
-            }
-
-            bool peek (Event & event)
-            {
-                std::lock_guard< std::mutex > lock(mutex);
-
-                if (queue.size () > 0)
-                {
-                    event = queue.front ();
-
-                    return true;
-                }
-
-                return false;
-            }
-
-        };
+        /**
+         * Events pushed by the input thread only (touches and such).
+         */
+        typedef Spsc_Queue< Event > Input_Event_Queue;
 
     }
 
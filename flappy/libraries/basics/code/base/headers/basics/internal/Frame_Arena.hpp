@@ -0,0 +1,273 @@
+/*
+ * FRAME ARENA
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803031000
+ */
+
+#ifndef BASICS_FRAME_ARENA_HEADER
+#define BASICS_FRAME_ARENA_HEADER
+
+    #include <cstddef>
+    #include <new>
+    #include <string>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Linear allocator for the memory that's only needed during a frame. Each allocation just
+         * moves a pointer forward within a block and deallocate() doesn't give anything back: all
+         * the memory is recovered at once by reset(), which Director calls at the beginning of
+         * every frame.
+         *
+         * When a frame needs more than the capacity of the block, the excess is taken from extra
+         * blocks of the heap. The next reset() frees them and replaces the block with a bigger one
+         * that fits the high-water mark, so once the frames have reached their usual size nothing
+         * is allocated from the heap.
+         *
+         * In debug mode (enabled by default in the builds that aren't optimized) the memory is
+         * filled with 0xCD when it's allocated and with 0xDD when it's deallocated or reset, so
+         * that the uses after the end of the frame are noticed as soon as possible, and the frames
+         * that raise the high-water mark are logged with the bytes that they used.
+         *
+         * It isn't thread safe: it must only be used by the thread that owns it.
+         */
+        class Frame_Arena : Non_Copyable
+        {
+        public:
+
+            static constexpr size_t        default_capacity = 64 * 1024;
+            static constexpr unsigned char allocated_byte   = 0xCD;
+            static constexpr unsigned char freed_byte       = 0xDD;
+
+        private:
+
+            struct Block
+            {
+                Block * next;
+                size_t  capacity;                   ///< Bytes after the header.
+            };
+
+            Block * block;                          ///< Main block.
+            Block * extra_blocks;                   ///< Most recent first.
+            char  * top;                            ///< First free byte of the current block.
+            char  * end;                            ///< End of the current block.
+
+            size_t  frame_bytes;                    ///< Used since the last reset() (with padding).
+            size_t  last_frame_bytes;
+            size_t  high_water_mark;
+            size_t  frame_count;
+            size_t  heap_allocations;               ///< Extra blocks since the arena was created.
+            bool    debug_mode;
+
+        public:
+
+            explicit Frame_Arena(size_t capacity = default_capacity);
+
+           ~Frame_Arena();
+
+        public:
+
+            /**
+             * Returns uninitialized memory that stays valid until the next reset(). It never
+             * returns nullptr.
+             * @param alignment It must be a power of two.
+             */
+            void * allocate (size_t size, size_t alignment = alignof(std::max_align_t))
+            {
+                char * address = align (top, alignment);
+
+                if (address <= end && size <= size_t(end - address))
+                {
+                    frame_bytes += size_t(address - top) + size;
+
+                    top = address + size;
+
+                    if (debug_mode) poison (address, size, allocated_byte);
+
+                    return address;
+                }
+
+                return allocate_in_extra_block (size, alignment);
+            }
+
+            /**
+             * The memory isn't reused until the next reset(), but it's poisoned in debug mode.
+             */
+            void deallocate (void * address, size_t size)
+            {
+                if (debug_mode && address) poison (address, size, freed_byte);
+            }
+
+            template< typename TYPE >
+            TYPE * allocate_array (size_t count)
+            {
+                return static_cast< TYPE * >(allocate (count * sizeof(TYPE), alignof(TYPE)));
+            }
+
+            /**
+             * Ends the frame: all the memory given since the previous reset() becomes invalid.
+             */
+            void reset ();
+
+        public:
+
+            void set_debug_mode (bool enabled)
+            {
+                debug_mode = enabled;
+            }
+
+            bool is_in_debug_mode () const
+            {
+                return debug_mode;
+            }
+
+            /**
+             * Capacity of the main block, which is the amount that can be allocated in a frame
+             * without using the heap.
+             */
+            size_t get_capacity () const
+            {
+                return block->capacity;
+            }
+
+            size_t get_frame_bytes () const
+            {
+                return frame_bytes;
+            }
+
+            /**
+             * Bytes that were allocated in the previous frame (between the last two resets).
+             */
+            size_t get_last_frame_bytes () const
+            {
+                return last_frame_bytes;
+            }
+
+            /**
+             * Most bytes allocated in a single frame since the arena was created.
+             */
+            size_t get_high_water_mark () const
+            {
+                return high_water_mark;
+            }
+
+            size_t get_frame_count () const
+            {
+                return frame_count;
+            }
+
+            /**
+             * Number of times that the arena has had to take memory from the heap during a frame
+             * because the main block was full.
+             */
+            size_t get_heap_allocations () const
+            {
+                return heap_allocations;
+            }
+
+        private:
+
+            static char * data (Block * block);
+
+            static char * align (char * address, size_t alignment)
+            {
+                return reinterpret_cast< char * >((reinterpret_cast< size_t >(address) + alignment - 1) & ~(alignment - 1));
+            }
+
+            static Block * create_block  (size_t capacity);
+            static void    destroy_block (Block * block);
+            static void    poison        (void * address, size_t size, unsigned char byte);
+
+            void * allocate_in_extra_block (size_t size, size_t alignment);
+
+        };
+
+        /**
+         * Allocator for the standard containers that takes the memory from a Frame_Arena, so that
+         * the transient containers of a frame don't use the heap. A container that uses it must be
+         * destroyed (or at least never accessed again) before the arena is reset. Without arena it
+         * uses the heap, as std::allocator.
+         */
+        template< typename TYPE >
+        class Frame_Allocator
+        {
+
+            template< typename OTHER_TYPE > friend class Frame_Allocator;
+
+            Frame_Arena * arena;
+
+        public:
+
+            typedef TYPE value_type;
+
+        public:
+
+            Frame_Allocator() noexcept : arena(nullptr)
+            {
+            }
+
+            Frame_Allocator(Frame_Arena & arena) noexcept : arena(&arena)
+            {
+            }
+
+            template< typename OTHER_TYPE >
+            Frame_Allocator(const Frame_Allocator< OTHER_TYPE > & other) noexcept : arena(other.arena)
+            {
+            }
+
+        public:
+
+            TYPE * allocate (size_t count)
+            {
+                return arena
+                    ? arena->allocate_array< TYPE > (count)
+                    : static_cast< TYPE * >(::operator new (count * sizeof(TYPE)));
+            }
+
+            void deallocate (TYPE * address, size_t count)
+            {
+                if (arena)
+                    arena->deallocate (address, count * sizeof(TYPE));
+                else
+                    ::operator delete (address);
+            }
+
+            Frame_Arena * get_arena () const
+            {
+                return arena;
+            }
+
+        public:
+
+            template< typename OTHER_TYPE >
+            bool operator == (const Frame_Allocator< OTHER_TYPE > & other) const
+            {
+                return arena == other.arena;
+            }
+
+            template< typename OTHER_TYPE >
+            bool operator != (const Frame_Allocator< OTHER_TYPE > & other) const
+            {
+                return arena != other.arena;
+            }
+
+        };
+
+        template< typename TYPE >
+        using Frame_Vector  = std::vector< TYPE, Frame_Allocator< TYPE > >;
+
+        typedef std::basic_string< char,    std::char_traits< char    >, Frame_Allocator< char    > > Frame_String;
+        typedef std::basic_string< wchar_t, std::char_traits< wchar_t >, Frame_Allocator< wchar_t > > Frame_Wstring;
+
+    }
+
+#endif
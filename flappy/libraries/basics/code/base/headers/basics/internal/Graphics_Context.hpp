@@ -13,9 +13,9 @@
 #ifndef BASICS_GRAPHICS_CONTEXT_HEADER
 #define BASICS_GRAPHICS_CONTEXT_HEADER
 
-    #include <map>
     #include <memory>
     #include <mutex>
+    #include <string>
     #include <utility>
     #include <vector>
 
@@ -23,6 +23,7 @@
     #include <basics/declarations>
     #include <basics/Graphics_Resource_Cache>
     #include <basics/Id>
+    #include <basics/Id_Map>
     #include <basics/Point>
     #include <basics/Size>
     #include <basics/types>
@@ -126,7 +127,7 @@
 
         private:
 
-            typedef std::map< Id, std::shared_ptr< Renderer > >          Renderer_List;
+            typedef Id_Map< std::shared_ptr< Renderer > >                Renderer_List;
             typedef std::vector<  std::shared_ptr< Graphics_Resource > > Resource_List;
 
         protected:
@@ -159,7 +160,7 @@
 
             bool add (Id id, const std::shared_ptr< Renderer > & renderer)
             {
-                return renderers.find (id) == renderers.end () ? renderers[id] = renderer, true : false;
+                return renderers.emplace (id, renderer).second;
             }
 
             // CUIDADO CON AÑADIR DUPLICADOS. PODRÍA ESTAR BIEN QUE CADA RECURSO TUVIESE UN Id ÚNICO Y
@@ -168,6 +169,10 @@
             {
                 if (resource)
                 {
+                    // Se recuerda en la caché para poder reconstruirlo si el contexto se pierde:
+
+                    if (graphics_resource_cache) graphics_resource_cache->add (resource);
+
                     resources.push_back (resource);
 
                     return resource->initialize ();
@@ -178,13 +183,23 @@
 
         public:
 
+            /**
+             * Vuelve a inicializar en este contexto los recursos que siguen vivos en la caché (los
+             * que se crearon con un contexto anterior que se perdió).
+             */
             virtual void initialize ()
             {
                 if (graphics_resource_cache)
                 {
                     for (auto iterator = graphics_resource_cache->begin (); iterator != graphics_resource_cache->end (); ++iterator)
                     {
-                        add (iterator->lock ());
+                        auto resource = iterator->lock ();
+
+                        if  (resource)
+                        {
+                            resources.push_back (resource);
+                            resource->initialize ();
+                        }
                     }
                 }
             }
@@ -218,8 +233,24 @@
             virtual void set_viewport (const Point2u & bottom_left, const Size2u & size) = 0;
 
             virtual bool make_current () = 0;
+
+            /**
+             * Detaches the context from the calling thread, so that another thread can make it
+             * current (a context can only be current in one thread at a time).
+             */
+            virtual bool release_current () = 0;
             virtual bool flush_and_display () = 0;
 
+            /**
+             * Writes the last frame presented to an image file, which can be used as a golden frame
+             * by the regression checks. Only the backends that can read their surface back (such as
+             * the software one) support it.
+             */
+            virtual bool save_frame (const std::string & ) const
+            {
+                return false;
+            }
+
         };
 
     }
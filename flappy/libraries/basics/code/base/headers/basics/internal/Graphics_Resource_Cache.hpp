@@ -36,6 +36,29 @@
 
             Graphics_Resource_List resources;
 
+        public:
+
+            /**
+             * Registra un recurso (una sola vez) y de paso olvida los que ya se han destruido.
+             */
+            void add (const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                bool found = false;
+
+                for (auto iterator = resources.begin (); iterator != resources.end (); )
+                {
+                    auto cached = iterator->lock ();
+
+                    if (!cached) iterator = resources.erase (iterator); else
+                    {
+                        found = found || cached == resource;
+                        ++iterator;
+                    }
+                }
+
+                if (!found) resources.push_back (resource);
+            }
+
         public:
 
             Iterator begin ()
@@ -0,0 +1,233 @@
+/*
+ * ID MAP
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802260930
+ */
+
+#ifndef BASICS_ID_MAP_HEADER
+#define BASICS_ID_MAP_HEADER
+
+    #include <cstdint>
+    #include <tuple>
+    #include <utility>
+    #include <vector>
+    #include <basics/Id>
+
+    namespace basics
+    {
+
+        /**
+         * Map keyed by Id with open addressing. The items are kept together in a vector (in
+         * insertion order, until one is erased) and a table of slots with linear probing stores the
+         * index of each item. The Ids are FNV hashes or small sequential numbers, so the low bits of
+         * the Id are used as is to choose the slot, without hashing it again.
+         *
+         * Unlike std::map, the pointers, references and iterators to the items are invalidated by
+         * the insertions that add a new item and by erase().
+         */
+        template< typename VALUE >
+        class Id_Map
+        {
+        public:
+
+            typedef VALUE                                        Value;
+            typedef std::pair< Id, Value >                       Item;
+            typedef typename std::vector< Item >::iterator       iterator;
+            typedef typename std::vector< Item >::const_iterator const_iterator;
+
+        private:
+
+            static constexpr uint32_t empty_slot = 0;      ///< The slots store the index + 1.
+
+            std::vector< Item     > items;
+            std::vector< uint32_t > slots;                  ///< Its size is 0 or a power of two.
+
+        public:
+
+            size_t size () const
+            {
+                return items.size ();
+            }
+
+            bool empty () const
+            {
+                return items.empty ();
+            }
+
+            void clear ()
+            {
+                items.clear ();
+                slots.assign (slots.size (), empty_slot);
+            }
+
+            /**
+             * Makes room for the given number of items, so that adding them won't move the items.
+             */
+            void reserve (size_t count)
+            {
+                items.reserve (count);
+
+                if (count * 2 > slots.size ()) rebuild (count * 2);
+            }
+
+        public:
+
+            iterator       begin ()       { return items.begin (); }
+            const_iterator begin () const { return items.begin (); }
+            iterator       end   ()       { return items.end   (); }
+            const_iterator end   () const { return items.end   (); }
+
+        public:
+
+            iterator find (Id id)
+            {
+                size_t slot = find_slot (id);
+
+                return slots.empty () || slots[slot] == empty_slot ? items.end () : items.begin () + (slots[slot] - 1);
+            }
+
+            const_iterator find (Id id) const
+            {
+                size_t slot = find_slot (id);
+
+                return slots.empty () || slots[slot] == empty_slot ? items.end () : items.begin () + (slots[slot] - 1);
+            }
+
+            size_t count (Id id) const
+            {
+                return find (id) != items.end () ? 1 : 0;
+            }
+
+            /**
+             * Adds an item unless there's one with the same id.
+             * @return The item with the id and whether it has been added.
+             */
+            template< typename ... ARGUMENTS >
+            std::pair< iterator, bool > emplace (Id id, ARGUMENTS && ... arguments)
+            {
+                // The table is kept at most half full, so the probe sequences stay short:
+
+                if ((items.size () + 1) * 2 > slots.size ())
+                {
+                    rebuild (slots.empty () ? 16 : slots.size () * 2);
+                }
+
+                size_t slot = find_slot (id);
+
+                if (slots[slot] != empty_slot)
+                {
+                    return { items.begin () + (slots[slot] - 1), false };
+                }
+
+                items.emplace_back
+                (
+                    std::piecewise_construct,
+                    std::forward_as_tuple (id),
+                    std::forward_as_tuple (std::forward< ARGUMENTS > (arguments)...)
+                );
+
+                slots[slot] = uint32_t(items.size ());
+
+                return { items.end () - 1, true };
+            }
+
+            Value & operator [] (Id id)
+            {
+                return emplace (id).first->second;
+            }
+
+            /**
+             * Removes the item with the id. The last item takes its place in the vector.
+             */
+            bool erase (Id id)
+            {
+                if (slots.empty ()) return false;
+
+                size_t slot = find_slot (id);
+
+                if (slots[slot] == empty_slot) return false;
+
+                size_t index = slots[slot] - 1;
+
+                remove_slot (slot);
+
+                if (index + 1 < items.size ())
+                {
+                    slots[find_slot (items.back ().first)] = uint32_t(index + 1);
+
+                    items[index] = std::move (items.back ());
+                }
+
+                items.pop_back ();
+
+                return true;
+            }
+
+        private:
+
+            // Slot of the item with the id, or the empty slot where it would go:
+
+            size_t find_slot (Id id) const
+            {
+                if (slots.empty ()) return 0;
+
+                size_t mask = slots.size () - 1;
+                size_t slot = size_t(id) & mask;
+
+                while (slots[slot] != empty_slot && items[slots[slot] - 1].first != id)
+                {
+                    slot = (slot + 1) & mask;
+                }
+
+                return slot;
+            }
+
+            void rebuild (size_t minimum_size)
+            {
+                size_t size = 16;
+
+                while (size < minimum_size) size *= 2;
+
+                slots.assign (size, empty_slot);
+
+                for (size_t index = 0; index < items.size (); ++index)
+                {
+                    slots[find_slot (items[index].first)] = uint32_t(index + 1);
+                }
+            }
+
+            // Empties a slot moving back the items of the following slots whose probe sequence
+            // passes through it, so that no tombstones are needed:
+
+            void remove_slot (size_t hole)
+            {
+                size_t mask = slots.size () - 1;
+
+                for (size_t next = (hole + 1) & mask; slots[next] != empty_slot; next = (next + 1) & mask)
+                {
+                    size_t home = size_t(items[slots[next] - 1].first) & mask;
+
+                    if (((next - home) & mask) >= ((next - hole) & mask))
+                    {
+                        slots[hole] = slots[next];
+                        hole        = next;
+                    }
+                }
+
+                slots[hole] = empty_slot;
+            }
+
+        };
+
+        template< typename VALUE >
+        constexpr uint32_t Id_Map< VALUE >::empty_slot;
+
+    }
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * PROFILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803041000
+ */
+
+#ifndef BASICS_PROFILER_HEADER
+#define BASICS_PROFILER_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <memory>
+    #include <mutex>
+    #include <ostream>
+    #include <string>
+    #include <vector>
+    #include <time.h>
+    #include <basics/Non_Copyable>
+
+    // BASICS_PROFILER can be defined as 0 (the CMake option of the same name does it) to remove
+    // the zones from the code completely:
+
+    #if !defined(BASICS_PROFILER)
+        #define BASICS_PROFILER 1
+    #endif
+
+    #define BASICS_PROFILE_CONCATENATE_(A, B) A##B
+    #define BASICS_PROFILE_CONCATENATE(A, B)  BASICS_PROFILE_CONCATENATE_(A, B)
+
+    #if BASICS_PROFILER
+
+        /**
+         * Measures the time from this point to the end of the enclosing scope when the profiler
+         * is capturing. The name must be a string literal (or live as long as the profiler).
+         */
+        #define BASICS_PROFILE_ZONE(NAME) ::basics::Profile_Zone BASICS_PROFILE_CONCATENATE(basics_profile_zone_, __LINE__)(NAME)
+
+    #else
+
+        #define BASICS_PROFILE_ZONE(NAME)
+
+    #endif
+
+    namespace basics
+    {
+
+        /**
+         * Collects the zones (see BASICS_PROFILE_ZONE) that end during a capture of a number of
+         * frames and exports them in the trace event format of Chrome (chrome://tracing or
+         * https://ui.perfetto.dev can open the files).
+         *
+         * Each thread writes its zones into its own ring buffer without locking: the ring is
+         * created (under a lock) the first time a thread ends a zone during a capture. When no
+         * capture is running, a zone only reads an atomic flag. The clock is CLOCK_MONOTONIC_RAW,
+         * which isn't affected by the adjustments of NTP and is read without a system call.
+         *
+         * The frames are counted by Director, which also writes the capture when it's complete.
+         */
+        class Profiler : Non_Copyable
+        {
+        public:
+
+            static constexpr size_t ring_capacity = 16384;      ///< Zones per thread and capture.
+
+            struct Record
+            {
+                const char * name;
+                int64_t      start;                             ///< Nanoseconds.
+                int64_t      end;
+            };
+
+        private:
+
+            // The slots are written while a capture may be being exported, so they're read and
+            // written as relaxed atomics and checked afterwards against the written counter (as a
+            // seqlock does):
+
+            struct Slot
+            {
+                std::atomic< const char * > name;
+                std::atomic< int64_t      > start;
+                std::atomic< int64_t      > end;
+            };
+
+            struct Thread_Ring
+            {
+                uint32_t                thread_id;
+                std::string             thread_name;
+                Slot                    slots[ring_capacity];
+                std::atomic< uint64_t > written;                ///< Only the owner thread increments it.
+                uint64_t                capture_begin;          ///< Value of written when the capture began.
+            };
+
+            typedef std::unique_ptr< Thread_Ring > Thread_Ring_Handle;
+
+        private:
+
+            std::atomic< bool >               capturing;
+            std::atomic< unsigned >           requested_frames;
+
+            std::mutex                        mutex;
+            std::vector< Thread_Ring_Handle > rings;
+            std::string                       requested_path;
+
+            // These are only used by the thread that counts the frames (the kernel one):
+
+            std::string                       path;
+            unsigned                          captured_frames;
+            unsigned                          frames_left;
+            int64_t                           capture_start;
+
+        public:
+
+            static Profiler & get_instance ()
+            {
+                static Profiler profiler;
+                return profiler;
+            }
+
+            static int64_t now ()
+            {
+                timespec time;
+
+                #if defined(CLOCK_MONOTONIC_RAW)
+                    clock_gettime (CLOCK_MONOTONIC_RAW, &time);
+                #else
+                    clock_gettime (CLOCK_MONOTONIC,     &time);
+                #endif
+
+                return int64_t(time.tv_sec) * 1000000000 + time.tv_nsec;
+            }
+
+        private:
+
+            Profiler();
+
+        public:
+
+            /**
+             * Requests a capture of the given number of frames, which starts with the next frame.
+             * The trace is written to the given path when it ends. It can be called from any
+             * thread. A request replaces the previous one if it hadn't started yet.
+             */
+            void capture (unsigned frames, const std::string & path);
+
+            bool is_capturing () const
+            {
+                return capturing.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Gives a name to the calling thread in the traces.
+             */
+            static void set_thread_name (const char * name);
+
+            /**
+             * Saves a zone of the calling thread. BASICS_PROFILE_ZONE calls it.
+             */
+            void record (const char * name, int64_t start, int64_t end);
+
+        public:
+
+            /**
+             * Starts the requested capture (if any). It's called at the beginning of each frame.
+             */
+            void begin_frame ();
+
+            /**
+             * Records the zone of the whole frame and counts it.
+             * @return true when the capture has just ended and can be written.
+             */
+            bool end_frame (int64_t frame_start);
+
+            /**
+             * Writes the last capture to the path given to capture(). The threads that may still
+             * end zones of the capture must have been synchronized before.
+             */
+            bool write_capture ();
+
+            void write_chrome_trace (std::ostream & output);
+
+        private:
+
+            Thread_Ring * get_thread_ring ();
+
+        };
+
+        extern Profiler & profiler;
+
+        /**
+         * Zone of code that is measured while it's in scope. Use BASICS_PROFILE_ZONE instead, so
+         * that it can be removed at compile time.
+         */
+        class Profile_Zone : Non_Copyable
+        {
+
+            const char * name;
+            int64_t      start;
+
+        public:
+
+            explicit Profile_Zone(const char * name)
+            :
+                name(profiler.is_capturing () ? name : nullptr)
+            {
+                if (this->name) start = Profiler::now ();
+            }
+
+           ~Profile_Zone()
+            {
+                if (name) profiler.record (name, start, Profiler::now ());
+            }
+
+        };
+
+    }
+
+#endif
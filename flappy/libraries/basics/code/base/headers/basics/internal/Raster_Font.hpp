@@ -14,11 +14,12 @@
 #define BASICS_RASTER_FONT_HEADER
 
     #include <memory>
-    #include <unordered_map>
     #include <vector>
     #include <basics/Atlas>
     #include <basics/Font>
+    #include <basics/Id_Map>
     #include <basics/Vector>
+    #include <basics/Xml_Scanner>
 
     namespace basics
     {
@@ -35,15 +36,14 @@
 
             struct Character : public Font::Character
             {
-                Atlas::Slice * slice;
-                Vector2f       offset;
-                float          advance;
+                const Atlas::Slice * slice;
+                Vector2f             offset;
+                float                advance;
             };
 
         private:
 
-            typedef std::unordered_map< uint32_t, Character > Character_Map;
-            typedef std::vector< byte >                       Buffer;
+            typedef Id_Map< Character >                       Character_Map;
             typedef std::unique_ptr< Atlas >                  Atlas_Handle;
 
         private:
@@ -72,13 +72,13 @@
 
         private:
 
-            bool parse        (Buffer & font_data, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_font   (rapidxml::xml_node<> *   font_tag, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_pages  (rapidxml::xml_node<> *  pages_tag, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_info   (rapidxml::xml_node<> *   info_tag);
-            bool parse_common (rapidxml::xml_node<> * common_tag);
-            bool parse_chars  (rapidxml::xml_node<> *  chars_tag);
-            bool parse_char   (rapidxml::xml_node<> *   char_tag);
+            bool parse        (const Asset::View & font_data, const std::string & path, Graphics_Context::Accessor & context);
+            bool parse_font   (Xml_Scanner & xml, const std::string & path, Graphics_Context::Accessor & context);
+            bool parse_pages  (Xml_Scanner & xml, const std::string & path, Graphics_Context::Accessor & context);
+            bool parse_info   (Xml_Scanner & xml);
+            bool parse_common (Xml_Scanner & xml);
+            bool parse_chars  (Xml_Scanner & xml);
+            bool parse_char   (Xml_Scanner & xml);
 
         };
 
@@ -0,0 +1,177 @@
+/*
+ * RENDER QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803021000
+ */
+
+#ifndef BASICS_RENDER_QUEUE_HEADER
+#define BASICS_RENDER_QUEUE_HEADER
+
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Canvas that doesn't draw anything, but records the drawing it receives so that it can be
+         * replayed later on any other canvas (and possibly from another thread). Each drawing keeps
+         * the color, opacity, blending and transform that were set when it was recorded, along with
+         * a 64 bit key made of the layer, the blending, the shader and the texture that it uses.
+         *
+         * Before the replay the drawings are sorted by key with a stable radix sort: the layers are
+         * drawn in increasing order and, within a layer, the opaque drawings (Blending NONE) go
+         * first grouped by state, while the translucent ones keep the order in which they were
+         * recorded. The calls that affect the whole canvas (clear(), set_size(), etc.) are never
+         * moved across. The replay only sets the state that changes between consecutive drawings.
+         *
+         * The commands are stored in buffers that keep their memory from one frame to the next, so
+         * recording a frame doesn't allocate once the queue has grown enough. The textures and the
+         * slices are kept as pointers, so they must outlive the replay.
+         */
+        class Render_Queue : public Canvas
+        {
+
+            enum Type
+            {
+                RESET_STATE,
+                SET_SIZE,
+                SET_CLEAR_COLOR,
+                CLEAR,
+                DRAW_POINT,
+                DRAW_SEGMENT,
+                DRAW_TRIANGLE,
+                FILL_TRIANGLE,
+                DRAW_RECTANGLE,
+                FILL_RECTANGLE,
+                FILL_TEXTURED_RECTANGLE,
+                FILL_SLICED_RECTANGLE,
+            };
+
+            struct State
+            {
+                unsigned transform;                     ///< Index in transforms.
+                float    color[3];                      ///< Also the clear color of SET_CLEAR_COLOR.
+                float    opacity;
+                Blending blending;
+            };
+
+            struct Command
+            {
+                Type         type;
+                int          handling;
+                unsigned     state;                     ///< Index in states.
+                Point2f      points[3];
+                Size2f       size;
+                const void * image;                     ///< Texture_2D or Atlas::Slice.
+            };
+
+            struct Entry
+            {
+                uint64_t key;
+                uint32_t index;                         ///< Index in commands.
+            };
+
+        private:
+
+            std::vector< Command          > commands;
+            std::vector< State            > states;
+            std::vector< Transformation2f > transforms;
+            std::vector< Entry            > entries;            ///< In recording order until sorted.
+            std::vector< Entry            > sorting_buffer;
+
+            State            current;                  ///< State that the next drawing will use.
+            Transformation2f current_transform;
+            bool             state_changed;
+            bool             transform_changed;
+            unsigned         layer;
+            bool             sorted;
+
+        public:
+
+            Render_Queue();
+           ~Render_Queue() = default;
+
+        public:
+
+            size_t size () const
+            {
+                return commands.size ();
+            }
+
+            bool empty () const
+            {
+                return commands.empty ();
+            }
+
+            /**
+             * Forgets the recorded commands, keeping the memory for the next frame. The current
+             * state (color, transform, layer...) is kept, as a canvas would keep it.
+             */
+            void discard ();
+
+            /**
+             * Takes the current state (color, transform, layer...) of another queue, so that the
+             * recording can go on in this one as if it were the same canvas.
+             */
+            void copy_state (const Render_Queue & other);
+
+            /**
+             * Sorts the commands. It's done by replay() if it wasn't done before.
+             */
+            void sort ();
+
+            /**
+             * Draws the recorded commands on another canvas. It can be called more than once.
+             */
+            void replay (Canvas & canvas);
+
+        public:
+
+            void reset_state     () override;
+
+        public:
+
+            void set_size        (const Size2u & size) override;
+            void set_layer       (unsigned layer) override;
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Texture_2D   * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) override;
+
+        private:
+
+            Command & add_barrier (Type type);
+            Command & add_drawing (Type type, bool textured, const void * texture);
+
+            void      sort_range  (Entry * begin, Entry * end);
+
+        };
+
+    }
+
+#endif
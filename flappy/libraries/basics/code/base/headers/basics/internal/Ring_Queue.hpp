@@ -0,0 +1,325 @@
+/*
+ * RING QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802271000
+ */
+
+#ifndef BASICS_RING_QUEUE_HEADER
+#define BASICS_RING_QUEUE_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <memory>
+    #include <thread>
+    #include <utility>
+    #include <basics/assert>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * What a push does when the queue is full.
+         */
+        enum class Overflow_Policy
+        {
+            DROP_OLDEST,                                    ///< The oldest item is discarded to make room.
+            BLOCK                                           ///< The producer waits until there's room (it can't be the consumer).
+        };
+
+        /**
+         * Totals since the queue was created. They're updated with relaxed atomics, so they're
+         * approximate while the queue is being used.
+         */
+        struct Queue_Counters
+        {
+            uint64_t pushed;
+            uint64_t popped;
+            uint64_t dropped;                               ///< Items discarded by DROP_OLDEST.
+            uint64_t waits;                                 ///< Pushes that found the queue full with BLOCK.
+        };
+
+        /**
+         * Bounded lock-free queue over a ring of cells that carry a sequence number, which tells
+         * whether a cell is ready to be written or read in the current lap (D. Vyukov's design).
+         * The capacity is rounded up to a power of two and nothing is allocated after construction.
+         *
+         * There must be a single consumer. With SINGLE_PRODUCER the pushes must also come from one
+         * thread, which saves the compare-and-swap of the tail. The head is always advanced with a
+         * compare-and-swap because DROP_OLDEST lets a producer pop (and discard) the oldest item.
+         *
+         * The pops move the items out of the ring, so ITEM only needs to be movable.
+         */
+        template< typename ITEM, bool SINGLE_PRODUCER >
+        class Ring_Queue : Non_Copyable
+        {
+        public:
+
+            typedef ITEM Item;
+
+        private:
+
+            struct Cell
+            {
+                std::atomic< size_t > sequence;
+                Item                  item;
+            };
+
+            static constexpr size_t cache_line_size = 64;
+
+        private:
+
+            // The head, the tail and the counters are kept in different cache lines, so that the
+            // producers and the consumer don't invalidate each other's. The queues are usually
+            // members of objects created with new, which (before C++17) ignores an alignas larger
+            // than the one of max_align_t, so whole lines of padding are used instead:
+
+            std::unique_ptr< Cell[] >      cells;
+            size_t                         mask;
+            Overflow_Policy                policy;
+
+            char                           padding_0[cache_line_size];
+            std::atomic< size_t   >        head;
+            char                           padding_1[cache_line_size];
+            std::atomic< size_t   >        tail;
+            char                           padding_2[cache_line_size];
+
+            std::atomic< uint64_t >        pushed;
+            std::atomic< uint64_t >        popped;
+            std::atomic< uint64_t >        dropped;
+            std::atomic< uint64_t >        waits;
+
+            std::atomic< std::thread::id > consumer;                ///< Last thread that popped (with BLOCK).
+
+        public:
+
+            explicit Ring_Queue(size_t capacity, Overflow_Policy policy = Overflow_Policy::DROP_OLDEST)
+            :
+                policy  (policy),
+                head    (0),
+                tail    (0),
+                pushed  (0),
+                popped  (0),
+                dropped (0),
+                waits   (0),
+                consumer(std::thread::id())
+            {
+                size_t size = 2;
+
+                while (size < capacity) size <<= 1;
+
+                cells.reset (new Cell[size]);
+                mask = size - 1;
+
+                for (size_t index = 0; index < size; ++index)
+                {
+                    cells[index].sequence.store (index, std::memory_order_relaxed);
+                }
+            }
+
+        public:
+
+            size_t capacity () const
+            {
+                return mask + 1;
+            }
+
+            /**
+             * Number of items queued. It's only a snapshot when other threads use the queue.
+             */
+            size_t size () const
+            {
+                size_t first = head.load (std::memory_order_acquire);
+                size_t last  = tail.load (std::memory_order_acquire);
+
+                return last > first ? last - first : 0;
+            }
+
+            bool empty () const
+            {
+                return size () == 0;
+            }
+
+            Queue_Counters get_counters () const
+            {
+                return Queue_Counters
+                {
+                    pushed .load (std::memory_order_relaxed),
+                    popped .load (std::memory_order_relaxed),
+                    dropped.load (std::memory_order_relaxed),
+                    waits  .load (std::memory_order_relaxed)
+                };
+            }
+
+        public:
+
+            void push (const Item & item)
+            {
+                Item copy(item);
+
+                push (std::move (copy));
+            }
+
+            void push (Item && item)
+            {
+                Cell * cell     = nullptr;
+                size_t position = tail.load (std::memory_order_relaxed);
+                bool   waited   = false;
+
+                for (;;)
+                {
+                    cell = &cells[position & mask];
+
+                    size_t   sequence   = cell->sequence.load (std::memory_order_acquire);
+                    intptr_t difference = intptr_t(sequence) - intptr_t(position);
+
+                    if (difference == 0)
+                    {
+                        if (SINGLE_PRODUCER)
+                        {
+                            tail.store (position + 1, std::memory_order_relaxed);
+                            break;
+                        }
+
+                        if (tail.compare_exchange_weak (position, position + 1, std::memory_order_relaxed)) break;
+                    }
+                    else
+                    if (difference < 0)
+                    {
+                        // The cell still holds the item of the previous lap, so the queue is full:
+
+                        if (policy == Overflow_Policy::DROP_OLDEST)
+                        {
+                            Item oldest;
+
+                            if (take (oldest))
+                                dropped.fetch_add (1, std::memory_order_relaxed);
+                            else
+                                std::this_thread::yield ();     // The consumer is reading that cell
+                        }
+                        else
+                        {
+                            // Only the consumer can make room, so it would wait forever:
+
+                            assert(consumer.load (std::memory_order_relaxed) != std::this_thread::get_id ());
+
+                            if (!waited) waits.fetch_add (1, std::memory_order_relaxed);
+
+                            waited = true;
+
+                            std::this_thread::yield ();
+                        }
+
+                        position = tail.load (std::memory_order_relaxed);
+                    }
+                    else
+                        position = tail.load (std::memory_order_relaxed);
+                }
+
+                cell->item = std::move (item);
+                cell->sequence.store (position + 1, std::memory_order_release);
+
+                pushed.fetch_add (1, std::memory_order_relaxed);
+            }
+
+            /**
+             * Moves the oldest item into the given one.
+             * @return false if the queue was empty.
+             */
+            bool pop (Item & item)
+            {
+                if (policy == Overflow_Policy::BLOCK)
+                {
+                    consumer.store (std::this_thread::get_id (), std::memory_order_relaxed);
+                }
+
+                if (!take (item)) return false;
+
+                popped.fetch_add (1, std::memory_order_relaxed);
+
+                return true;
+            }
+
+            /**
+             * Pops the items that were queued when the call started and passes each one to the
+             * callback (as an Item &), so that the consumer doesn't have to poll them one by one.
+             * The items pushed meanwhile are left for the next call.
+             * @return Number of items passed to the callback.
+             */
+            template< typename CALLBACK >
+            size_t drain (CALLBACK && callback)
+            {
+                size_t count = 0;
+                size_t limit = size ();
+                Item   item;
+
+                while (count < limit && pop (item))
+                {
+                    callback (item);
+                    count++;
+                }
+
+                return count;
+            }
+
+            void clear ()
+            {
+                Item item;
+
+                while (take (item));
+            }
+
+        private:
+
+            bool take (Item & item)
+            {
+                Cell * cell;
+                size_t position = head.load (std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    cell = &cells[position & mask];
+
+                    size_t   sequence   = cell->sequence.load (std::memory_order_acquire);
+                    intptr_t difference = intptr_t(sequence) - intptr_t(position + 1);
+
+                    if (difference == 0)
+                    {
+                        if (head.compare_exchange_weak (position, position + 1, std::memory_order_relaxed)) break;
+                    }
+                    else
+                    if (difference < 0)
+                        return false;
+                    else
+                        position = head.load (std::memory_order_relaxed);
+                }
+
+                item = std::move (cell->item);
+                cell->sequence.store (position + mask + 1, std::memory_order_release);
+
+                return true;
+            }
+
+        };
+
+        /**
+         * Queue for items produced by a single thread and consumed by another (or the same) one.
+         */
+        template< typename ITEM >
+        using Spsc_Queue = Ring_Queue< ITEM, true  >;
+
+        /**
+         * Queue for items produced by any number of threads and consumed by a single one.
+         */
+        template< typename ITEM >
+        using Mpsc_Queue = Ring_Queue< ITEM, false >;
+
+    }
+
+#endif
@@ -15,6 +15,7 @@
 
     #include <string>
     #include <vector>
+    #include <basics/Frame_Arena>
     #include <basics/Raster_Font>
     #include <basics/Point>
     #include <basics/Size>
@@ -39,7 +40,7 @@
                 }
             };
 
-            typedef std::vector< Glyph > Glyph_List;
+            typedef std::vector< Glyph, Frame_Allocator< Glyph > > Glyph_List;
 
         private:
 
@@ -47,10 +48,20 @@
             float      width;
             float      height;
 
+        private:
+
+            void layout (const Raster_Font & font, const wchar_t * text, size_t length);
+
         public:
 
             Text_Layout(const Raster_Font & font, const std::wstring & text);
 
+            /**
+             * Lays out a text that's only going to be drawn in the current frame, taking the memory
+             * for the glyphs from the arena. The layout must not be used after the arena is reset.
+             */
+            Text_Layout(const Raster_Font & font, const wchar_t * text, Frame_Arena & arena);
+
         public:
 
             const Glyph_List & get_glyphs () const
@@ -13,12 +13,14 @@
 #ifndef BASICS_TEXTURE_2D_HEADER
 #define BASICS_TEXTURE_2D_HEADER
 
+    #include <atomic>
     #include <memory>
     #include <string>
     #include <basics/Asset>
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource>
+    #include <basics/Texture_Container>
 
     namespace basics
     {
@@ -27,53 +29,119 @@
         {
         public:
 
+            /**
+             * What a texture does with its pixels once they've been sent to the graphics context.
+             * They're only needed again if the context is lost and the texture has to be rebuilt.
+             */
+            enum Residency
+            {
+                AUTOMATIC,                                  ///< RELEASE_PIXELS when the pixels come from an asset, KEEP_PIXELS otherwise.
+                KEEP_PIXELS,                                ///< A copy of the pixels is kept in main memory.
+                RELEASE_PIXELS,                             ///< The pixels are dropped and decoded again from the asset when needed.
+                COMPACT_CACHE,                              ///< Only the encoded asset is kept, to be decoded again when needed.
+            };
+
             struct Options
             {
-                unsigned width;
-                unsigned height;
+                unsigned                  width;
+                unsigned                  height;
+                Residency                 residency;
+                std::string               asset_path;       ///< Set by decode() so that the texture can be rebuilt.
+                Texture_Container::Format upload_format;    ///< Format sent to the context (UNKNOWN keeps the decoded RGBA8888).
+                bool                      dither;           ///< Ordered dithering when upload_format has 16 bits.
             };
 
         public:
 
             typedef std::shared_ptr< Texture_2D > (* Factory) (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options);
+            typedef std::shared_ptr< Texture_2D > (* Container_Factory) (Id id, const Texture_Container & container, const Options & options);
 
         private:
 
-            static Id      texture_2d_specialization_ids      [10];
-            static Factory texture_2d_specialization_factories[10];
-            static size_t  texture_2d_specialization_count;
+            static Id                texture_2d_specialization_ids      [10];
+            static Factory           texture_2d_specialization_factories[10];
+            static Container_Factory texture_2d_container_factories     [10];
+            static size_t            texture_2d_specialization_count;
 
         public:
 
-            static void register_factory (Id id, Factory factory)
+            static void register_factory (Id id, Factory factory, Container_Factory container_factory = nullptr)
             {
                 texture_2d_specialization_ids      [texture_2d_specialization_count] = id;
                 texture_2d_specialization_factories[texture_2d_specialization_count] = factory;
+                texture_2d_container_factories     [texture_2d_specialization_count] = container_factory;
                 texture_2d_specialization_count++;
             }
 
         public:
 
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+            static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const Texture_Container & container, const Options & options = {});
+
+            /**
+             * If there's a texture container (.btex) next to the asset, the texture is created from
+             * it without decoding anything. Otherwise the asset is decoded as a PNG.
+             */
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options = {});
 
+            /**
+             * Maps the texture container that replaces an asset (or the asset itself when it's a
+             * container). The result isn't good() if there's none.
+             */
+            static Texture_Container find_container (const std::string & asset_path);
+
+            /**
+             * Loads and decodes the pixels of an asset (a PNG or a texture container) without
+             * touching any graphics context, so it can be called from any thread. The dimensions
+             * are returned through the options.
+             */
+            static bool decode (const std::string & asset_path, Color_Buffer< Rgba8888 > & color_buffer, Options & options);
+            static bool decode (const Asset::View  & asset_data, Color_Buffer< Rgba8888 > & color_buffer, Options & options);
+
+        private:
+
+            static std::atomic< size_t > total_resident_bytes;
+
+        public:
+
+            /**
+             * Bytes held in main memory by all the textures (pixels or encoded data kept in order
+             * to rebuild them), not counting the memory of the graphics context.
+             */
+            static size_t get_total_resident_bytes ()
+            {
+                return total_resident_bytes;
+            }
+
         protected:
 
-            float width;
-            float height;
+            float  width;
+            float  height;
+            size_t resident_bytes;
 
         protected:
 
             Texture_2D(unsigned width, unsigned height)
             :
                 width (float(width )),
-                height(float(height))
+                height(float(height)),
+                resident_bytes(0)
+            {
+            }
+
+            void set_resident_bytes (size_t bytes)
             {
+                total_resident_bytes += bytes;
+                total_resident_bytes -= resident_bytes;
+                resident_bytes        = bytes;
             }
 
         public:
 
-            virtual ~Texture_2D() = default;
+            virtual ~Texture_2D()
+            {
+                set_resident_bytes (0);
+            }
 
         public:
 
@@ -87,6 +155,14 @@
                 return height;
             }
 
+            /**
+             * Bytes that this texture holds in main memory.
+             */
+            size_t get_resident_bytes () const
+            {
+                return resident_bytes;
+            }
+
         };
 
     }
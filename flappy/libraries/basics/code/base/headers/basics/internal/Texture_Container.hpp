@@ -0,0 +1,168 @@
+/*
+ * TEXTURE CONTAINER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802201040
+ */
+
+#ifndef BASICS_TEXTURE_CONTAINER_HEADER
+#define BASICS_TEXTURE_CONTAINER_HEADER
+
+    #include <string>
+    #include <vector>
+    #include <basics/Asset>
+    #include <basics/Color>
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Read-only view of a texture container (.btex): a small header followed by the pixels of
+         * each level already in the format in which they're sent to the graphics context, so they
+         * can be uploaded straight from the mapped asset without any decoding.
+         *
+         * Layout (little endian):
+         *
+         *     0   "BTEX"
+         *     4   uint16 version
+         *     6   uint16 format
+         *     8   uint32 width
+         *    12   uint32 height
+         *    16   uint32 level count
+         *    20   uint32 reserved
+         *    24   { uint32 offset, uint32 size } for each level, followed by the pixels
+         *
+         * The rows of each level are tightly packed, with the first row at the top of the image
+         * (the same order produced by png_decode) and every level starting at an offset multiple
+         * of 4. Each level halves the size of the previous one.
+         */
+        class Texture_Container
+        {
+        public:
+
+            enum Format
+            {
+                UNKNOWN  = 0,
+                RGBA8888 = 1,
+                RGB565   = 2,
+                RGBA4444 = 3,
+                RGBA5551 = 4,
+            };
+
+            struct Level
+            {
+                unsigned     width;
+                unsigned     height;
+                const byte * pixels;
+                size_t       size;
+            };
+
+            static constexpr unsigned version       = 1;
+            static constexpr size_t   header_size   = 24;
+            static constexpr unsigned max_levels    = 16;
+
+        public:
+
+            /**
+             * Path of the container that replaces a PNG asset (the extension is replaced by .btex).
+             */
+            static std::string get_path_for (const std::string & asset_path);
+
+            static bool is_container_path (const std::string & asset_path);
+
+            static size_t get_bytes_per_pixel (Format format)
+            {
+                return format == RGBA8888 ? 4 : format == UNKNOWN ? 0 : 2;
+            }
+
+            /**
+             * Builds a container from decoded pixels, converting them to the given format (with
+             * ordered dithering if requested) and optionally adding every mipmap level down to 1x1
+             * (box filtered).
+             */
+            static bool encode
+            (
+                const Color_Buffer< Rgba8888 > & color_buffer,
+                Format                           format,
+                bool                             mipmaps,
+                bool                             dither,
+                std::vector< byte >            & container
+            );
+
+        private:
+
+            Asset::View          data;
+            Format               format;
+            unsigned             width;
+            unsigned             height;
+            std::vector< Level > levels;
+
+        public:
+
+            Texture_Container() : format(UNKNOWN), width(0), height(0)
+            {
+            }
+
+            /**
+             * Validates the header and the level table. The view is kept, so the pixels of the
+             * levels are valid while the container exists.
+             */
+            explicit Texture_Container(const Asset::View & data);
+
+        public:
+
+            bool good () const
+            {
+                return !levels.empty ();
+            }
+
+            Format get_format () const
+            {
+                return format;
+            }
+
+            unsigned get_width () const
+            {
+                return width;
+            }
+
+            unsigned get_height () const
+            {
+                return height;
+            }
+
+            unsigned get_level_count () const
+            {
+                return unsigned(levels.size ());
+            }
+
+            const Level & get_level (unsigned index) const
+            {
+                return levels[index];
+            }
+
+            /**
+             * Bytes mapped by the container (header included).
+             */
+            size_t get_size () const
+            {
+                return data.size ();
+            }
+
+            /**
+             * Converts the first level to RGBA8888 for the backends that can't use the other
+             * formats directly.
+             */
+            bool expand (Color_Buffer< Rgba8888 > & color_buffer) const;
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * TEXTURE LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802141100
+ */
+
+#ifndef BASICS_TEXTURE_LOADER_HEADER
+#define BASICS_TEXTURE_LOADER_HEADER
+
+    #include <atomic>
+    #include <deque>
+    #include <functional>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <basics/Color_Buffer>
+    #include <basics/Graphics_Context>
+    #include <basics/Id>
+    #include <basics/Id_Map>
+    #include <basics/Non_Copyable>
+    #include <basics/Texture_2D>
+    #include <basics/Texture_Container>
+    #include <basics/Thread_Pool>
+
+    namespace basics
+    {
+
+        /**
+         * Loads textures in the background. The assets are read and decoded (or just mapped when
+         * there's a texture container for them) in parallel by a thread pool, while the creation of the textures (the upload to the graphics context) is
+         * left to upload(), which must be called every frame from the thread that owns the context
+         * and only does as much work as its budget allows.
+         */
+        class Texture_Loader : Non_Copyable
+        {
+        public:
+
+            typedef std::shared_ptr< Texture_2D > Texture_Handle;
+
+            /**
+             * Called from upload() once a texture is ready. The handle is empty if the texture
+             * couldn't be loaded.
+             */
+            typedef std::function< void (Id id, const Texture_Handle & texture) > Callback;
+
+            struct Budget
+            {
+                float  seconds;                             ///< Time that a call to upload() may spend.
+                size_t bytes;                               ///< Pixel bytes that a call to upload() may send.
+            };
+
+            struct Progress
+            {
+                unsigned requested;
+                unsigned decoded;                           ///< Includes the ones that failed.
+                unsigned uploaded;                          ///< Includes the ones that failed.
+                unsigned failed;
+
+                bool is_done () const
+                {
+                    return uploaded == requested;
+                }
+
+                float get_ratio () const
+                {
+                    return requested ? float(decoded + uploaded) / float(2 * requested) : 1.f;
+                }
+            };
+
+        private:
+
+            struct Decoded_Texture
+            {
+                Id                       id;
+                bool                     good;
+                Color_Buffer< Rgba8888 > color_buffer;
+                Texture_Container        container;         ///< Used instead of color_buffer when there's one.
+                Texture_2D::Options      options;
+                Callback                 callback;
+            };
+
+            // The workers only touch this part, which outlives the loader if needed:
+
+            struct Shared_State
+            {
+                std::mutex                    mutex;
+                std::deque< Decoded_Texture > decoded;
+                std::atomic< unsigned >       decoded_count;
+                std::atomic< bool >           cancelled;
+            };
+
+        private:
+
+            std::shared_ptr< Shared_State >  shared;
+            Id_Map< Texture_Handle >         textures;
+            unsigned                         requested;
+            unsigned                         uploaded;
+            unsigned                         failed;
+            Budget                           budget;
+            std::unique_ptr< Thread_Pool >   thread_pool;       ///< Declared last to be joined first.
+
+        public:
+
+            /**
+             * @param worker_count Number of decoding threads (0 uses the default of Thread_Pool).
+             */
+            explicit Texture_Loader(unsigned worker_count = 0);
+
+           ~Texture_Loader();
+
+        public:
+
+            void set_budget (const Budget & new_budget)
+            {
+                budget = new_budget;
+            }
+
+            /**
+             * Queues the loading of a texture whose pixels are read from an asset.
+             */
+            void load (Id id, const std::string & asset_path, const Callback & callback = Callback())
+            {
+                load (id, asset_path, Texture_2D::Options{}, callback);
+            }
+
+            /**
+             * The options (such as the upload format) are passed on to the texture, except for the
+             * size and the asset path, which are filled in when decoding.
+             */
+            void load (Id id, const std::string & asset_path, const Texture_2D::Options & options, const Callback & callback = Callback());
+
+            /**
+             * Creates the textures that have already been decoded, calling their callbacks and
+             * adding them to the context, until the budget has been spent (at least one is created
+             * per call so that the loading always progresses).
+             * @return Number of textures processed.
+             */
+            unsigned upload (Graphics_Context::Accessor & context);
+
+        public:
+
+            Progress get_progress () const
+            {
+                return { requested, shared->decoded_count, uploaded, failed };
+            }
+
+            bool is_done () const
+            {
+                return uploaded == requested;
+            }
+
+            /**
+             * Returns the texture loaded with the given id (once it has been uploaded).
+             */
+            Texture_Handle get (Id id) const
+            {
+                auto texture = textures.find (id);
+
+                return texture != textures.end () ? texture->second : Texture_Handle();
+            }
+
+        };
+
+    }
+
+#endif
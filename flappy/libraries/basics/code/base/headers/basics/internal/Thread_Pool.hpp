@@ -0,0 +1,89 @@
+/*
+ * THREAD POOL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101130
+ */
+
+#ifndef BASICS_THREAD_POOL_HEADER
+#define BASICS_THREAD_POOL_HEADER
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <deque>
+    #include <functional>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Fixed set of worker threads that run the tasks submitted to a shared FIFO queue. The
+         * threads are started by the constructor and joined by the destructor, after the tasks that
+         * were already queued have been completed.
+         */
+        class Thread_Pool : Non_Copyable
+        {
+        public:
+
+            typedef std::function< void () > Task;
+
+        private:
+
+            std::vector< std::thread > workers;
+            std::deque < Task        > tasks;
+
+            std::mutex                 mutex;
+            std::condition_variable    task_available;
+            std::condition_variable    all_done;
+
+            unsigned                   pending;             ///< Queued tasks plus the running ones.
+            bool                       stopping;
+
+        public:
+
+            /**
+             * @param worker_count Number of threads to start. When it's 0, one less than the number
+             *     of hardware threads is used (at least one), as the calling thread usually helps too.
+             */
+            explicit Thread_Pool(unsigned worker_count = 0);
+
+           ~Thread_Pool();
+
+        public:
+
+            unsigned get_worker_count () const
+            {
+                return unsigned(workers.size ());
+            }
+
+            void submit (const Task & task);
+
+            /**
+             * Blocks the calling thread until every submitted task has been completed.
+             */
+            void wait ();
+
+            /**
+             * Calls function(index) for every index in [0, count), spreading the indices among the
+             * workers and the calling thread, and returns when all of them have been processed.
+             */
+            void parallel_for (unsigned count, const std::function< void (unsigned) > & function);
+
+        private:
+
+            void run_worker ();
+
+        };
+
+    }
+
+#endif
@@ -13,115 +13,314 @@
 #ifndef BASICS_TINY_MAP_HEADER
 #define BASICS_TINY_MAP_HEADER
 
+    #include <type_traits>
+    #include <utility>
     #include <basics/types>
-    #include <basics/assert>
+
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define BASICS_TINY_MAP_NEON
+        #include <arm_neon.h>
+    #elif defined(__SSE2__)
+        #define BASICS_TINY_MAP_SSE2
+        #include <emmintrin.h>
+    #endif
 
     namespace basics
     {
 
+        namespace internal
+        {
+
+            /**
+             * Index of the first of count keys that is equal to key (or count if none is). The
+             * array must have room for count rounded up to a multiple of 4, and the keys beyond
+             * count are ignored whatever their value.
+             */
+            inline size_t find_key (const uint32_t * keys, size_t count, uint32_t key)
+            {
+                #if defined(BASICS_TINY_MAP_SSE2)
+
+                    __m128i wanted = _mm_set1_epi32 (int(key));
+
+                    for (size_t index = 0; index < count; index += 4)
+                    {
+                        __m128i  block = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(keys + index));
+                        unsigned mask  = unsigned(_mm_movemask_ps (_mm_castsi128_ps (_mm_cmpeq_epi32 (block, wanted))));
+
+                        if (mask)
+                        {
+                            size_t found = index + size_t(__builtin_ctz (mask));
+
+                            return found < count ? found : count;
+                        }
+                    }
+
+                    return count;
+
+                #elif defined(BASICS_TINY_MAP_NEON)
+
+                    uint32x4_t wanted = vdupq_n_u32 (key);
+
+                    for (size_t index = 0; index < count; index += 4)
+                    {
+                        uint32x4_t equal = vceqq_u32 (vld1q_u32 (keys + index), wanted);
+                        uint32x2_t any   = vorr_u32  (vget_low_u32 (equal), vget_high_u32 (equal));
+
+                        if (vget_lane_u32 (vpmax_u32 (any, any), 0))
+                        {
+                            for (size_t found = index; found < index + 4 && found < count; ++found)
+                            {
+                                if (keys[found] == key) return found;
+                            }
+
+                            return count;
+                        }
+                    }
+
+                    return count;
+
+                #else
+
+                    for (size_t index = 0; index < count; ++index)
+                    {
+                        if (keys[index] == key) return index;
+                    }
+
+                    return count;
+
+                #endif
+            }
+
+            template< typename KEY >
+            inline size_t find_key (const KEY * keys, size_t count, const KEY & key)
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    if (keys[index] == key) return index;
+                }
+
+                return count;
+            }
+
+        }
+
+        /**
+         * Map with a small fixed capacity whose items are stored inside the object, so creating,
+         * copying or moving it doesn't allocate memory. The keys are kept in their own array and
+         * searched linearly, several at a time with SIMD instructions when they're 32 bit values
+         * (such as Id). The items are kept in insertion order, until one is erased.
+         */
         template< typename KEY, typename VALUE, size_t CAPACITY >
         class Tiny_Map
         {
+        public:
+
             typedef KEY   Key;
             typedef VALUE Value;
 
-            static constexpr size_t capacity = CAPACITY;
+            static constexpr size_t fixed_capacity = CAPACITY;
 
-            struct Item
-            {
-                Key   key;
-                Value value,
-            };
+        private:
 
-            template< class ITEM >
+            // The key array is padded to read it in blocks of 4:
+
+            static constexpr size_t key_slots = (CAPACITY + 3) & ~size_t(3);
+
+            typedef typename std::conditional
+            <
+                std::is_integral< Key >::value && sizeof(Key) == 4, uint32_t, Key
+            >
+            ::type Stored_Key;
+
+            template< class MAP, class VALUE_TYPE >
             class Iterator_Template
             {
 
-                ITEM * item;
+                MAP  * map;
+                size_t index;
 
             public:
 
-                Iterator()            : item(nullptr) { }
-                Iterator(Item * item) : item(item   ) { }
+                Iterator_Template()                        : map(nullptr), index(0    ) { }
+                Iterator_Template(MAP * map, size_t index) : map(map    ), index(index) { }
 
-                      Value & operator  * ()       { return  item->value; }
-                const Value & operator  * () const { return  item->value; }
+                const Key  & key   () const { return reinterpret_cast< const Key & >(map->keys[index]); }
+                VALUE_TYPE & value () const { return map->values[index]; }
 
-                      Value * operator -> ()       { return &item->value; }
-                const Value * operator -> () const { return &item->value; }
+                VALUE_TYPE & operator  * () const { return  map->values[index]; }
+                VALUE_TYPE * operator -> () const { return &map->values[index]; }
+
+                Iterator_Template & operator ++ ()
+                {
+                    return ++index, *this;
+                }
 
-                operator bool () const
+                bool operator == (const Iterator_Template & other) const
                 {
-                    return item != nullptr;
+                    return index == other.index && map == other.map;
                 }
+
+                bool operator != (const Iterator_Template & other) const
+                {
+                    return !(*this == other);
+                }
+
             };
 
         public:
 
-            typedef Iterator_Template<       Item >       Iterator;
-            typedef Iterator_Template< const Item > Const_Iterator;
+            typedef Iterator_Template<       Tiny_Map,       Value >       Iterator;
+            typedef Iterator_Template< const Tiny_Map, const Value > Const_Iterator;
 
         private:
 
-            Item   items[capacity];
-            size_t count;
+            Stored_Key keys  [key_slots];
+            Value      values[CAPACITY ];
+            size_t     item_count;
+            Value      overflow;                                ///< Takes the values that don't fit.
+
+        public:
+
+            Tiny_Map() : keys(), item_count(0)
+            {
+            }
+
+            Tiny_Map(const Tiny_Map & other) : keys(), item_count(0)
+            {
+                *this = other;
+            }
+
+            Tiny_Map & operator = (const Tiny_Map & other)
+            {
+                // Only the items in use are copied:
+
+                for (size_t index = 0; index < other.item_count; ++index)
+                {
+                    keys  [index] = other.keys  [index];
+                    values[index] = other.values[index];
+                }
+
+                return item_count = other.item_count, *this;
+            }
 
         public:
 
             size_t size () const
             {
-                return count;
+                return item_count;
             }
 
             size_t capacity () const
             {
-                return capacity;
+                return CAPACITY;
+            }
+
+            bool empty () const
+            {
+                return item_count == 0;
+            }
+
+            bool full () const
+            {
+                return item_count == CAPACITY;
+            }
+
+            void clear ()
+            {
+                item_count = 0;
             }
 
         public:
 
             Iterator begin ()
             {
-                return Iterator(items[0]);
+                return Iterator(this, 0);
             }
 
-            Const_Iterator cbegin () const
+            Const_Iterator begin () const
             {
-                return Const_Iterator(items[0]);
+                return Const_Iterator(this, 0);
             }
 
             Iterator end ()
             {
-                return Iterator(items[count]);
+                return Iterator(this, item_count);
             }
 
-            Const_Iterator cend () const
+            Const_Iterator end () const
             {
-                return Const_Iterator(items[count]);
+                return Const_Iterator(this, item_count);
             }
 
         public:
 
+            Iterator find (const Key & key)
+            {
+                return Iterator(this, internal::find_key (keys, item_count, Stored_Key(key)));
+            }
+
+            Const_Iterator find (const Key & key) const
+            {
+                return Const_Iterator(this, internal::find_key (keys, item_count, Stored_Key(key)));
+            }
+
+            size_t count_of (const Key & key) const
+            {
+                return internal::find_key (keys, item_count, Stored_Key(key)) < item_count ? 1 : 0;
+            }
+
+            /**
+             * Returns the value of the key, adding it (default constructed) if it isn't in the map.
+             * When the map is full the key isn't added: a default constructed value that isn't part
+             * of the map is returned instead, so whatever is assigned to it is lost.
+             */
             Value & operator [] (const Key & key)
             {
-                for (size_t  index = 0; index < count; ++index)
+                size_t index = internal::find_key (keys, item_count, Stored_Key(key));
+
+                if (index == item_count)
                 {
-                    if (item[index].key == key) return item[index].value;
-                }
+                    if (item_count == CAPACITY) return overflow = Value();
+
+                    keys  [item_count] = Stored_Key(key);
+                    values[item_count] = Value();
 
-                assert(count < capacity);
+                    item_count++;
+                }
 
-                return item[count].key = key, item[count++];
+                return values[index];
             }
 
+            /**
+             * Returns the value of the key or, if it isn't in the map, a default constructed value.
+             */
             const Value & operator [] (const Key & key) const
             {
-                for (auto & item : items)
+                static const Value missing{};
+
+                size_t index = internal::find_key (keys, item_count, Stored_Key(key));
+
+                return index < item_count ? values[index] : missing;
+            }
+
+            /**
+             * Removes the key. The last item takes its place.
+             */
+            bool erase (const Key & key)
+            {
+                size_t index = internal::find_key (keys, item_count, Stored_Key(key));
+
+                if (index == item_count) return false;
+
+                if (index + 1 < item_count)
                 {
-                    if (item.key == key) return item.value;
+                    keys  [index] = keys  [item_count - 1];
+                    values[index] = std::move (values[item_count - 1]);
                 }
 
-                return *reinterpret_cast< Value * >(nullptr);
+                values[--item_count] = Value();
+
+                return true;
             }
 
         };
@@ -0,0 +1,202 @@
+/*
+ * TOUCH BATCH
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802281000
+ */
+
+#ifndef BASICS_TOUCH_BATCH_HEADER
+#define BASICS_TOUCH_BATCH_HEADER
+
+    #include <cstdint>
+    #include <cstddef>
+
+    namespace basics
+    {
+
+        struct Touch_Sample
+        {
+            enum Phase : uint8_t
+            {
+                STARTED,
+                MOVED,
+                ENDED
+            };
+
+            int64_t  time;                                  ///< Nanoseconds of the monotonic clock.
+            float    x;
+            float    y;
+            int32_t  pointer_id;
+            Phase    phase;
+            bool     historical;                            ///< Intermediate position of a move that
+                                                            ///< is followed by a newer one.
+        };
+
+        /**
+         * Flat array with the touch samples of a frame in the order in which they happened. The
+         * moves of each pointer are coalesced as they're added: a move that follows another move
+         * of the same pointer replaces it, or turns it into a historical sample when the history
+         * is kept. So, between a start and an end, each pointer has a single non historical move.
+         * When the batch is full the starts and ends make room by discarding moves, so only moves
+         * are ever dropped. Nothing is allocated.
+         */
+        class Touch_Batch
+        {
+        public:
+
+            static constexpr size_t capacity = 128;
+
+        private:
+
+            Touch_Sample samples[capacity];
+            size_t       count;
+            size_t       dropped;                           ///< Moves discarded because they didn't fit.
+
+        public:
+
+            Touch_Batch() : count(0), dropped(0)
+            {
+            }
+
+            Touch_Batch(const Touch_Batch & ) = delete;
+            Touch_Batch & operator = (const Touch_Batch & ) = delete;
+
+        public:
+
+            size_t size () const
+            {
+                return count;
+            }
+
+            bool empty () const
+            {
+                return count == 0;
+            }
+
+            size_t get_dropped () const
+            {
+                return dropped;
+            }
+
+            Touch_Sample & operator [] (size_t index)
+            {
+                return samples[index];
+            }
+
+            const Touch_Sample & operator [] (size_t index) const
+            {
+                return samples[index];
+            }
+
+            Touch_Sample * begin () { return samples; }
+            Touch_Sample * end   () { return samples + count; }
+
+            const Touch_Sample * begin () const { return samples; }
+            const Touch_Sample * end   () const { return samples + count; }
+
+            void clear ()
+            {
+                count   = 0;
+                dropped = 0;
+            }
+
+        public:
+
+            /**
+             * Adds a sample coalescing it with the previous move of the same pointer if possible.
+             * When the batch is full the moves are coalesced even if the history is kept, and the
+             * oldest historical moves (of the same pointer first) are discarded to make room. A
+             * start or an end that still doesn't fit discards the oldest move of any pointer: a
+             * scene that missed an end would keep the pointer down forever.
+             * @return false if the sample (always a move) had to be dropped.
+             */
+            bool add (const Touch_Sample & sample, bool keep_history)
+            {
+                if (sample.phase == Touch_Sample::MOVED)
+                {
+                    Touch_Sample * previous = find_last (sample.pointer_id);
+
+                    if (previous && previous->phase == Touch_Sample::MOVED)
+                    {
+                        if (!keep_history || count == capacity)
+                        {
+                            previous->time = sample.time;
+                            previous->x    = sample.x;
+                            previous->y    = sample.y;
+
+                            return true;
+                        }
+
+                        previous->historical = true;
+                    }
+                }
+
+                if (count == capacity)
+                {
+                    bool room = remove_oldest_move (&sample.pointer_id, true)
+                             || remove_oldest_move (nullptr, true)
+                             || (sample.phase != Touch_Sample::MOVED && remove_oldest_move (nullptr, false));
+
+                    if (!room)
+                    {
+                        dropped++;
+                        return false;
+                    }
+                }
+
+                samples[count] = sample;
+                samples[count].historical = false;
+                count++;
+
+                return true;
+            }
+
+        private:
+
+            Touch_Sample * find_last (int32_t pointer_id)
+            {
+                for (size_t index = count; index > 0; --index)
+                {
+                    if (samples[index - 1].pointer_id == pointer_id) return &samples[index - 1];
+                }
+
+                return nullptr;
+            }
+
+            /**
+             * Removes the oldest move of the given pointer (or of any pointer if it's nullptr),
+             * keeping the order of the rest of samples.
+             * @return false if there was no such move.
+             */
+            bool remove_oldest_move (const int32_t * pointer_id, bool only_historical)
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    const Touch_Sample & sample = samples[index];
+
+                    bool matches = sample.phase == Touch_Sample::MOVED
+                                && (!only_historical || sample.historical)
+                                && (!pointer_id      || sample.pointer_id == *pointer_id);
+
+                    if (matches)
+                    {
+                        for (--count; index < count; ++index) samples[index] = samples[index + 1];
+
+                        dropped++;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+        };
+
+    }
+
+#endif
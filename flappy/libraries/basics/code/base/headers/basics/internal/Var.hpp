@@ -13,11 +13,25 @@
 #ifndef BASICS_VAR_HEADER
 #define BASICS_VAR_HEADER
 
+    #include <cstdio>
+    #include <cstdlib>
+    #include <cstring>
+    #include <string>
+    #include <tuple>
+    #include <type_traits>
+    #include <utility>
     #include <basics/Id>
+    #include <basics/types>
 
     namespace basics
     {
 
+        /**
+         * Variable que puede guardar un valor de cualquiera de los tipos de basics::var. Se trata
+         * de una unión etiquetada: el valor se guarda dentro de la propia variable (las cadenas de
+         * hasta 15 caracteres también) junto con el índice de su tipo, por lo que as<>() solo
+         * compara el índice y los tipos escalares no reservan memoria ni usan llamadas virtuales.
+         */
         class Var final
         {
         public:
@@ -30,37 +44,113 @@
                 {
                     const Id            id;
                     const char        * name;
-                    const void (Type::* clear) ();
-                    // * DEFAULT VALUE? SERÍA DE TIPO "Type"
-                    // * TABLA DE PUNTEROS A FUNCIONES DE CONVERSIÓN A TIPOS BÁSICOS (posiblemente es mejor usar tipos de C++ que Var::Type)
                 };
 
+                static constexpr size_t type_count = 15;
 
             protected:
 
-                      byte   blob[8];
-                const Info * info;
+                static constexpr size_t  blob_size             = 16;
+                static constexpr size_t  small_string_capacity = blob_size - 1;
+                static constexpr uint8_t heap_string           = 0xFF;
+                static constexpr uint8_t string_index          = 14;
+
+                struct Heap_String
+                {
+                    char   * chars;
+                    size_t   size;
+                };
+
+                static const Info infos[type_count];
+
+            protected:
+
+                alignas(8) byte    blob[blob_size];
+                           uint8_t index;
+                           uint8_t string_size;     ///< Tamaño de una cadena corta o heap_string.
 
             public:
 
-                Type(const Info * const info) : info(info)
+                Type() : index(0), string_size(0)
                 {
                 }
 
+                Type(const Type & other) : index(other.index), string_size(0)
+                {
+                    if (other.is_heap_string ())
+                        assign_string (other.get_chars (), other.get_string_size ());
+                    else
+                        copy_blob (other);
+                }
+
+                Type(Type && other) noexcept : index(other.index), string_size(other.string_size)
+                {
+                    std::memcpy (blob, other.blob, blob_size);
+
+                    other.index       = 0;
+                    other.string_size = 0;
+                }
+
                ~Type()
                 {
-                    if (info->clear) (this->*(info->clear)) ();
+                    if (is_heap_string ()) release_string ();
+                }
+
+                Type & operator = (const Type & other)
+                {
+                    if (this != &other)
+                    {
+                        if (other.index == string_index)
+                        {
+                            assign_string (other.get_chars (), other.get_string_size ());
+                        }
+                        else
+                        {
+                            if (is_heap_string ()) release_string ();
+
+                            index = other.index;
+                            copy_blob (other);
+                        }
+                    }
+
+                    return *this;
+                }
+
+                Type & operator = (Type && other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        if (is_heap_string ()) release_string ();
+
+                        std::memcpy (blob, other.blob, blob_size);
+
+                        index             = other.index;
+                        string_size       = other.string_size;
+                        other.index       = 0;
+                        other.string_size = 0;
+                    }
+
+                    return *this;
                 }
 
             public:
 
                 const Info & type_info () const
                 {
-                    return *info;
+                    return infos[index];
+                }
+
+                uint8_t get_index () const
+                {
+                    return index;
                 }
 
             protected:
 
+                Type(uint8_t index) : index(index), string_size(0)
+                {
+                }
+
                 template< typename TYPE >
                 TYPE & data ()
                 {
@@ -75,6 +165,74 @@
                     return const_cast< Type * >(this)->data< TYPE > ();
                 }
 
+            protected:
+
+                bool is_heap_string () const
+                {
+                    return index == string_index && string_size == heap_string;
+                }
+
+                const char * get_chars () const
+                {
+                    return string_size == heap_string ? data< Heap_String > ().chars : reinterpret_cast< const char * >(blob);
+                }
+
+                size_t get_string_size () const
+                {
+                    return string_size == heap_string ? data< Heap_String > ().size : string_size;
+                }
+
+                void assign_string (const char * chars, size_t size)
+                {
+                    // La cadena puede apuntar dentro de este mismo valor, por lo que se copia
+                    // antes de liberar la anterior:
+
+                    if (size <= small_string_capacity)
+                    {
+                        char copy[blob_size];
+
+                        std::memcpy (copy, chars, size);
+
+                        if (is_heap_string ()) release_string ();
+
+                        std::memcpy (blob, copy, size);
+
+                        blob[size]  = 0;
+                        string_size = uint8_t(size);
+                    }
+                    else
+                    {
+                        char * copy = new char[size + 1];
+
+                        std::memcpy (copy, chars, size);
+
+                        copy[size] = 0;
+
+                        if (is_heap_string ()) release_string ();
+
+                        data< Heap_String > () = { copy, size };
+                        string_size            = heap_string;
+                    }
+
+                    index = string_index;
+                }
+
+            private:
+
+                void copy_blob (const Type & other)
+                {
+                    std::memcpy (blob, other.blob, blob_size);
+
+                    string_size = other.string_size;
+                }
+
+                void release_string ()
+                {
+                    delete [] data< Heap_String > ().chars;
+
+                    string_size = 0;
+                }
+
             };
 
         public:
@@ -97,34 +255,44 @@
 
         public:
 
-            Var();
+            Var() = default;
 
             template< typename TYPE >
             bool is () const
             {
-                return value.type_info ().id == TYPE::id;
+                return value.get_index () == TYPE::type_index;
             }
 
             template< typename TYPE >
             TYPE * as ()
             {
-                return value.type_info ().id == TYPE::id ? static_cast< TYPE * >(&value) : nullptr;
+                return value.get_index () == TYPE::type_index ? static_cast< TYPE * >(&value) : nullptr;
             }
 
-            // AL CONTRARIO QUE EL MÉTODO AS(), EL MÉTODO TO() REALIZA CONVERSIÓN ENTRE TIPOS.
-            // UNA PLANTILLA INDEX_OF<TYPE> DEVOLVERÍA EL ÍNDICE EN LA TABLA DE CONVERSIÓN DE UN TIPO
-            // CUALQUIERA EN TIEMPO DE COMPILACIÓN. SI NO EXISTE EL ÍNDICE O SI LA ENTRADA EN DICHO
-            // ÍNDICE ES NULA, SE DEVUELVE UN VALOR POR DEFECTO Y OK A FALSE. EN OTRO CASO, SE INVOCA
-            // A LA FUNCIÓN DE CONVERSIÓN.
             template< typename TYPE >
-            Conversion< TYPE > to ();
+            const TYPE * as () const
+            {
+                return value.get_index () == TYPE::type_index ? static_cast< const TYPE * >(&value) : nullptr;
+            }
 
-            template< typename TYPE >
-            Var & operator = (const TYPE & new_value)
+            const Type::Info & type_info () const
             {
-                return value = new_value, *this;
+                return value.type_info ();
             }
 
+            /**
+             * Al contrario que as(), to() convierte el valor al tipo de C++ indicado (bool, char,
+             * los enteros, float, double o std::string). La conversión se busca en una tabla que
+             * se construye en tiempo de compilación para cada tipo de destino y que se indexa con
+             * el tipo del valor. Si no se puede convertir, se devuelve el valor por defecto y ok
+             * a false.
+             */
+            template< typename TYPE >
+            Conversion< TYPE > to () const;
+
+            template< typename TYPE >
+            Var & operator = (const TYPE & new_value);
+
         };
 
         // -----------------------------------------------------------------------------------------
@@ -132,136 +300,190 @@
         namespace var
         {
 
-            class Void : public Var::Type
+            /**
+             * Base de los tipos escalares, que se guardan tal cual dentro del valor.
+             */
+            template< typename VALUE, uint8_t INDEX >
+            class Scalar : public Var::Type
             {
             public:
 
-                static constexpr Id   id = ID(basics::var::Void);
-                static const     Info info;
+                typedef VALUE Value;
+
+                static constexpr uint8_t type_index = INDEX;
 
             public:
 
-                Void() : Type(&info)
+                Scalar() : Type(INDEX)
                 {
+                    data< Value > () = Value();
                 }
 
-            };
-
-            // -------------------------------------------------------------------------------------
-
-            class Bool : public Var::Type
-            {
-            public:
-
-                static constexpr Id   id = ID(basics::var::Bool);
-                static const     Info info;
-
-            public:
-
-                Bool() : Type(&info)
+                Scalar(Value x) : Type(INDEX)
                 {
+                    data< Value > () = x;
                 }
 
-                Bool(bool x) : Type(&info)
+                Value & get ()
                 {
-                    *this = x;
+                    return data< Value > ();
                 }
 
-                Bool & operator = (const bool value)
+                const Value & get () const
                 {
-                    return data< bool > () = value, *this;
+                    return data< Value > ();
                 }
 
-                operator const bool & () const
+                operator const Value & () const
                 {
-                    return data< bool > ();
+                    return data< Value > ();
                 }
+
             };
 
+            #define BASICS_VAR_SCALAR(NAME, VALUE, INDEX)                                           \
+                                                                                                    \
+                class NAME : public Scalar< VALUE, INDEX >                                          \
+                {                                                                                   \
+                public:                                                                             \
+                                                                                                    \
+                    static constexpr Id id = ID(basics::var::NAME);                                 \
+                                                                                                    \
+                public:                                                                             \
+                                                                                                    \
+                    NAME() = default;                                                               \
+                                                                                                    \
+                    NAME(VALUE x) : Scalar(x)                                                       \
+                    {                                                                               \
+                    }                                                                               \
+                                                                                                    \
+                    NAME & operator = (const VALUE value)                                           \
+                    {                                                                               \
+                        return get () = value, *this;                                               \
+                    }                                                                               \
+                };
+
+            // Tipos simples (el índice de cada uno es su posición en Types):
+
+            BASICS_VAR_SCALAR (Bool,   bool,      1)
+            BASICS_VAR_SCALAR (Char,   char,      2)
+            BASICS_VAR_SCALAR (WChar,  wchar_t,   3)
+            BASICS_VAR_SCALAR (Int8,   int8_t,    4)
+            BASICS_VAR_SCALAR (Int16,  int16_t,   5)
+            BASICS_VAR_SCALAR (Int32,  int32_t,   6)
+            BASICS_VAR_SCALAR (Int64,  int64_t,   7)
+            BASICS_VAR_SCALAR (UInt8,  uint8_t,   8)
+            BASICS_VAR_SCALAR (UInt16, uint16_t,  9)
+            BASICS_VAR_SCALAR (UInt32, uint32_t, 10)
+            BASICS_VAR_SCALAR (UInt64, uint64_t, 11)
+            BASICS_VAR_SCALAR (Float,  float,    12)
+            BASICS_VAR_SCALAR (Double, double,   13)
+
+            #undef BASICS_VAR_SCALAR
+
+            static_assert(sizeof(int) == 4, "basics::var::Int requires a 32 bit int.");
+
+            typedef UInt8  Byte;
+            typedef Int32  Int;
+            typedef UInt32 Unsigned;
+
+            #if BASICS_WORD_SIZE == 4
+                typedef UInt32 Word;
+            #else
+                typedef UInt64 Word;
+            #endif
+
             // -------------------------------------------------------------------------------------
 
-            class Int32 : public Var::Type
+            class Void : public Var::Type
             {
             public:
 
-                static constexpr Id   id = ID(basics::var::Int32);
-                static const     Info info;
+                static constexpr Id      id         = ID(basics::var::Void);
+                static constexpr uint8_t type_index = 0;
+
+            };
+
+            // -------------------------------------------------------------------------------------
 
+            /**
+             * Las cadenas de hasta 15 caracteres se guardan dentro del valor. Las más largas se
+             * guardan en memoria dinámica.
+             */
+            class String : public Var::Type
+            {
             public:
 
-                Int32() : Type(&info)
+                static constexpr Id      id         = ID(basics::var::String);
+                static constexpr uint8_t type_index = string_index;
+
+            public:
+
+                String() : Type(type_index)
                 {
+                    blob[0] = 0;
                 }
 
-                Int32(int32_t x) : Type(&info)
+                String(const char * chars, size_t size) : Type(type_index)
                 {
-                    *this = x;
+                    assign_string (chars, size);
                 }
 
-                Int32 & operator = (const int32_t value)
+                String(const char * chars) : String(chars, std::strlen (chars))
                 {
-                    return data< int32_t > () = value, *this;
                 }
 
-                operator const int32_t & () const
+                String(const std::string & s) : String(s.data (), s.size ())
                 {
-                    return data< int32_t > ();
                 }
-            };
 
-            // -------------------------------------------------------------------------------------
-
-            class Float : public Var::Type
-            {
-            public:
+                String & operator = (const char * chars)
+                {
+                    return assign_string (chars, std::strlen (chars)), *this;
+                }
 
-                static constexpr Id   id = ID(basics::var::Float);
-                static const     Info info;
+                String & operator = (const std::string & s)
+                {
+                    return assign_string (s.data (), s.size ()), *this;
+                }
 
-            public:
+                const char * c_str () const
+                {
+                    return get_chars ();
+                }
 
-                Float() : Type(&info)
+                size_t size () const
                 {
+                    return get_string_size ();
                 }
 
-                Float(float x) : Type(&info)
+                bool is_small () const
                 {
-                    *this = x;
+                    return string_size != heap_string;
                 }
 
-                Float & operator = (const float value)
+                operator std::string () const
                 {
-                    return data< float > () = value, *this;
+                    return std::string(get_chars (), get_string_size ());
                 }
 
-                operator const float & () const
+                bool operator == (const char * chars) const
                 {
-                    return data< float > ();
+                    return std::strlen (chars) == size () && std::memcmp (chars, c_str (), size ()) == 0;
                 }
+
             };
 
             // -------------------------------------------------------------------------------------
 
-            // Tipos simples:
-
-            class Void;
-            class Bool;
-            class Byte;
-            class Word;
-            class Char;
-            class WChar;
-            class Int;
-            class Unsigned;
-            class Int8;
-            class Int16;
-            class Int32;
-            class Int64;
-            class UInt8;
-            class UInt16;
-            class UInt32;
-            class UInt64;
-            class Float;
-            class Double;
+            typedef std::tuple
+            <
+                Void,   Bool,   Char,   WChar,
+                Int8,   Int16,  Int32,  Int64,
+                UInt8,  UInt16, UInt32, UInt64,
+                Float,  Double, String
+            >
+            Types;
 
             // Tipos derivados:
 
@@ -269,7 +491,6 @@
 
             // Tipos complejos:
 
-            class String;
             class Array;
             class Map;
 
@@ -277,15 +498,271 @@
 
         // -----------------------------------------------------------------------------------------
 
-        inline Var::Var() : value(var::Void())
+        namespace internal
         {
+
+            template< size_t INDEX = 0 >
+            constexpr bool check_var_type_indices ()
+            {
+                return std::tuple_element< INDEX, var::Types >::type::type_index == INDEX && check_var_type_indices< INDEX + 1 > ();
+            }
+
+            template< >
+            constexpr bool check_var_type_indices< Var::Type::type_count > ()
+            {
+                return true;
+            }
+
+            static_assert(std::tuple_size< var::Types >::value == Var::Type::type_count, "basics::var::Types is incomplete.");
+            static_assert(check_var_type_indices (), "basics::var::Types doesn't match the type indices.");
+
+            // -------------------------------------------------------------------------------------
+            // Tipo de basics::var que guarda cada tipo de C++:
+
+            template< typename TYPE, typename = void >
+            struct Var_Type_Of;
+
+            template< typename TYPE >
+            struct Var_Type_Of< TYPE, typename std::enable_if< std::is_base_of< Var::Type, TYPE >::value >::type >
+            {
+                typedef TYPE Type;
+            };
+
+            template< typename TYPE, size_t SIZE, bool SIGNED > struct Var_Integer;
+
+            template< typename TYPE > struct Var_Integer< TYPE, 1, true  > { typedef var::Int8   Type; };
+            template< typename TYPE > struct Var_Integer< TYPE, 2, true  > { typedef var::Int16  Type; };
+            template< typename TYPE > struct Var_Integer< TYPE, 4, true  > { typedef var::Int32  Type; };
+            template< typename TYPE > struct Var_Integer< TYPE, 8, true  > { typedef var::Int64  Type; };
+            template< typename TYPE > struct Var_Integer< TYPE, 1, false > { typedef var::UInt8  Type; };
+            template< typename TYPE > struct Var_Integer< TYPE, 2, false > { typedef var::UInt16 Type; };
+            template< typename TYPE > struct Var_Integer< TYPE, 4, false > { typedef var::UInt32 Type; };
+            template< typename TYPE > struct Var_Integer< TYPE, 8, false > { typedef var::UInt64 Type; };
+
+            template< typename TYPE >
+            struct Var_Type_Of< TYPE, typename std::enable_if< std::is_integral< TYPE >::value >::type >
+            :
+                Var_Integer< TYPE, sizeof(TYPE), std::is_signed< TYPE >::value >
+            {
+            };
+
+            template< > struct Var_Type_Of< bool        > { typedef var::Bool   Type; };
+            template< > struct Var_Type_Of< char        > { typedef var::Char   Type; };
+            template< > struct Var_Type_Of< wchar_t     > { typedef var::WChar  Type; };
+            template< > struct Var_Type_Of< float       > { typedef var::Float  Type; };
+            template< > struct Var_Type_Of< double      > { typedef var::Double Type; };
+            template< > struct Var_Type_Of< char *      > { typedef var::String Type; };
+            template< > struct Var_Type_Of< const char *> { typedef var::String Type; };
+            template< > struct Var_Type_Of< std::string > { typedef var::String Type; };
+
+            template< size_t SIZE > struct Var_Type_Of< char[SIZE] > { typedef var::String Type; };
+
+            // -------------------------------------------------------------------------------------
+            // Conversiones entre valores:
+
+            template< typename FROM, typename TO >
+            inline typename std::enable_if< std::is_arithmetic< FROM >::value && std::is_arithmetic< TO >::value, bool >::type
+            convert_value (const FROM & from, TO & to)
+            {
+                return to = static_cast< TO >(from), true;
+            }
+
+            template< typename FROM >
+            inline typename std::enable_if< std::is_arithmetic< FROM >::value, bool >::type
+            convert_value (const FROM & from, bool & to)
+            {
+                return to = from != 0, true;
+            }
+
+            template< typename FROM >
+            inline typename std::enable_if< std::is_integral< FROM >::value, bool >::type
+            convert_value (const FROM & from, std::string & to)
+            {
+                return to = std::to_string (from), true;
+            }
+
+            inline bool convert_value (const float & from, std::string & to)
+            {
+                char chars[32];
+
+                return to.assign (chars, size_t(std::snprintf (chars, sizeof(chars), "%.9g", double(from)))), true;
+            }
+
+            inline bool convert_value (const double & from, std::string & to)
+            {
+                char chars[32];
+
+                return to.assign (chars, size_t(std::snprintf (chars, sizeof(chars), "%.17g", from))), true;
+            }
+
+            inline bool convert_value (const bool & from, std::string & to)
+            {
+                return to = from ? "true" : "false", true;
+            }
+
+            inline bool convert_value (const char & from, std::string & to)
+            {
+                return to.assign (1, from), true;
+            }
+
+            inline bool convert_value (const wchar_t & from, std::string & to)
+            {
+                // Se codifica en UTF-8:
+
+                uint32_t code = uint32_t(from);
+
+                to.clear ();
+
+                if (code < 0x80)    {                                                                 to += char(code); } else
+                if (code < 0x800)   { to += char(0xC0 | (code >>  6));                                to += char(0x80 | (code & 0x3F)); } else
+                if (code < 0x10000) { to += char(0xE0 | (code >> 12)); to += char(0x80 | ((code >> 6) & 0x3F)); to += char(0x80 | (code & 0x3F)); }
+                else
+                {
+                    if (code > 0x10FFFF) return false;
+
+                    to += char(0xF0 | (code >> 18));
+                    to += char(0x80 | ((code >> 12) & 0x3F));
+                    to += char(0x80 | ((code >>  6) & 0x3F));
+                    to += char(0x80 | ( code        & 0x3F));
+                }
+
+                return true;
+            }
+
+            inline bool convert_value (const var::String & from, std::string & to)
+            {
+                return to.assign (from.c_str (), from.size ()), true;
+            }
+
+            inline bool convert_value (const var::String & from, bool & to)
+            {
+                if (from == "true" || from == "1") return to = true,  true;
+                if (from == "false"|| from == "0") return to = false, true;
+
+                return false;
+            }
+
+            inline bool convert_value (const var::String & from, char & to)
+            {
+                return from.size () == 1 ? (to = from.c_str ()[0], true) : false;
+            }
+
+            template< typename TO >
+            inline typename std::enable_if< std::is_integral< TO >::value && std::is_signed< TO >::value, bool >::type
+            convert_value (const var::String & from, TO & to)
+            {
+                char      * end;
+                long long   value = std::strtoll (from.c_str (), &end, 10);
+
+                return from.size () > 0 && *end == 0 ? (to = TO(value), true) : false;
+            }
+
+            template< typename TO >
+            inline typename std::enable_if< std::is_integral< TO >::value && std::is_unsigned< TO >::value, bool >::type
+            convert_value (const var::String & from, TO & to)
+            {
+                char               * end;
+                unsigned long long   value = std::strtoull (from.c_str (), &end, 10);
+
+                return from.size () > 0 && *end == 0 ? (to = TO(value), true) : false;
+            }
+
+            template< typename TO >
+            inline typename std::enable_if< std::is_floating_point< TO >::value, bool >::type
+            convert_value (const var::String & from, TO & to)
+            {
+                char   * end;
+                double   value = std::strtod (from.c_str (), &end);
+
+                return from.size () > 0 && *end == 0 ? (to = TO(value), true) : false;
+            }
+
+            // -------------------------------------------------------------------------------------
+            // Entradas de la tabla de conversión a TO (una por cada tipo de basics::var):
+
+            template< typename FROM, typename TO >
+            struct Var_Converter
+            {
+                static bool convert (const Var::Type & from, TO & to)
+                {
+                    return convert_value (static_cast< const FROM & >(from).get (), to);
+                }
+            };
+
+            template< typename TO >
+            struct Var_Converter< var::Void, TO >
+            {
+                static bool convert (const Var::Type & , TO & )
+                {
+                    return false;
+                }
+            };
+
+            template< typename TO >
+            struct Var_Converter< var::String, TO >
+            {
+                static bool convert (const Var::Type & from, TO & to)
+                {
+                    return convert_value (static_cast< const var::String & >(from), to);
+                }
+            };
+
+            // std::index_sequence is C++14, but Android still builds with C++11:
+
+            template< size_t ... INDICES >
+            struct Index_Sequence
+            {
+            };
+
+            template< size_t COUNT, size_t ... INDICES >
+            struct Make_Index_Sequence : Make_Index_Sequence< COUNT - 1, COUNT - 1, INDICES... >
+            {
+            };
+
+            template< size_t ... INDICES >
+            struct Make_Index_Sequence< 0, INDICES... >
+            {
+                typedef Index_Sequence< INDICES... > type;
+            };
+
+            template< typename TO, typename INDICES = typename Make_Index_Sequence< Var::Type::type_count >::type >
+            struct Var_Conversion;
+
+            template< typename TO, size_t ... INDICES >
+            struct Var_Conversion< TO, Index_Sequence< INDICES... > >
+            {
+                typedef bool (* Function) (const Var::Type & , TO & );
+
+                static Var::Conversion< TO > run (const Var::Type & value)
+                {
+                    static constexpr Function table[] =
+                    {
+                        &Var_Converter< typename std::tuple_element< INDICES, var::Types >::type, TO >::convert...
+                    };
+
+                    Var::Conversion< TO > result{ TO(), false };
+
+                    result.ok = table[value.get_index ()] (value, result.value);
+
+                    return result;
+                }
+            };
+
         }
 
         // -----------------------------------------------------------------------------------------
 
-        template< > inline Var & Var::operator = < bool    > (const bool    & x) { return value = var::Bool (x), *this; }
-        template< > inline Var & Var::operator = < int32_t > (const int32_t & x) { return value = var::Int32(x), *this; }
-        template< > inline Var & Var::operator = < float   > (const float   & x) { return value = var::Float(x), *this; }
+        template< typename TYPE >
+        inline Var::Conversion< TYPE > Var::to () const
+        {
+            return internal::Var_Conversion< TYPE >::run (value);
+        }
+
+        template< typename TYPE >
+        inline Var & Var::operator = (const TYPE & new_value)
+        {
+            return value = typename internal::Var_Type_Of< TYPE >::Type(new_value), *this;
+        }
 
     }
 
@@ -18,6 +18,7 @@
     #include <basics/Size>
     #include <basics/Event_Queue>
     #include <basics/Graphics_Context>
+    #include <basics/Profiler>
 
     namespace basics
     {
@@ -138,7 +139,10 @@
             std::atomic< bool > available;
             std::atomic< bool > focused;
 
-            Event_Queue event_queue;
+            // Only drained while the kernel holds the window, so the oldest events are dropped
+            // rather than blocking the thread of the window system:
+
+            Event_Queue event_queue{ 64, Overflow_Policy::DROP_OLDEST };
 
             struct
             {
@@ -240,17 +244,25 @@
 
             void push (Event && event)
             {
-                event_queue.push (event);
+                event_queue.push (std::move (event));
             }
 
             bool poll (Event & event)
             {
-                return event_queue.poll (event);
+                return event_queue.pop (event);
+            }
+
+            template< typename CALLBACK >
+            size_t drain (CALLBACK && callback)
+            {
+                BASICS_PROFILE_ZONE ("window-events");
+
+                return event_queue.drain (callback);
             }
 
-            bool peek (Event & event)
+            const Event_Queue & get_event_queue () const
             {
-                return event_queue.peek (event);
+                return event_queue;
             }
 
         };
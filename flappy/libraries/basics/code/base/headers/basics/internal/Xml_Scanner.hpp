@@ -0,0 +1,185 @@
+/*
+ * XML SCANNER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802251500
+ */
+
+#ifndef BASICS_XML_SCANNER_HEADER
+#define BASICS_XML_SCANNER_HEADER
+
+    #include <climits>
+    #include <cstring>
+    #include <basics/fnv>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Parses a decimal integer (with an optional minus sign) in the manner of std::from_chars().
+         * @return Pointer to the first char that isn't part of the number, or first if there's no
+         *         number or it doesn't fit in an int (value isn't modified in that case).
+         */
+        inline const char * parse_integer (const char * first, const char * last, int & value)
+        {
+            const char * next     = first;
+            bool         negative = next < last && *next == '-';
+
+            if (negative) ++next;
+
+            const char * digits = next;
+            unsigned     limit  = negative ? unsigned(INT_MAX) + 1u : unsigned(INT_MAX);
+            unsigned     result = 0;
+
+            for ( ; next < last && unsigned(*next - '0') < 10; ++next)
+            {
+                unsigned digit = unsigned(*next - '0');
+
+                if (result > (limit - digit) / 10) return first;
+
+                result = result * 10 + digit;
+            }
+
+            if (next == digits) return first;
+
+            value = negative ? int(0u - result) : int(result);
+
+            return next;
+        }
+
+        /**
+         * Pull scanner that walks the tags of a XML document in place, without copying or modifying
+         * the text and without allocating memory, so it can work straight over a mapped asset.
+         * The text between tags, comments, processing instructions, CDATA sections and DOCTYPE
+         * declarations are skipped. The names and values are returned as they are in the text
+         * (the entities aren't expanded), which is enough for the data files generated by tools.
+         */
+        class Xml_Scanner
+        {
+        public:
+
+            enum Token
+            {
+                START_TAG,                                  ///< <name ...> or <name ... />
+                END_TAG,                                    ///< </name>
+                END_OF_DATA,
+                SYNTAX_ERROR,
+            };
+
+            /**
+             * A range of chars of the document (it isn't null-terminated).
+             */
+            struct Text
+            {
+                const char * begin;
+                const char * end;
+
+                size_t size () const
+                {
+                    return size_t(end - begin);
+                }
+
+                template< size_t LENGTH >
+                bool operator == (const char (& literal)[LENGTH]) const
+                {
+                    return size () == LENGTH - 1 && std::memcmp (begin, literal, LENGTH - 1) == 0;
+                }
+
+                template< size_t LENGTH >
+                bool operator != (const char (& literal)[LENGTH]) const
+                {
+                    return !(*this == literal);
+                }
+
+                /**
+                 * Parses the whole text as an integer.
+                 */
+                bool to_int (int & value) const
+                {
+                    return begin < end && parse_integer (begin, end, value) == end;
+                }
+
+                /**
+                 * Continues the given FNV-1a hash with the chars of the text.
+                 */
+                uint32_t hash (uint32_t hash = internal::fnv_basis_32) const
+                {
+                    return fnv32 (begin, size (), hash);
+                }
+            };
+
+        private:
+
+            const char * current;
+            const char * end;
+            Token        token;
+            Text         name;
+            const char * attributes;                        ///< Next attribute of the current start tag.
+            const char * attributes_end;
+            bool         empty_element;
+
+        public:
+
+            Xml_Scanner(const char * begin, const char * end)
+            :
+                current       (begin  ),
+                end           (end    ),
+                token         (END_OF_DATA),
+                name          { begin, begin },
+                attributes    (begin  ),
+                attributes_end(begin  ),
+                empty_element (false  )
+            {
+            }
+
+        public:
+
+            /**
+             * Advances to the next start or end tag.
+             */
+            Token next ();
+
+            /**
+             * Reads the next attribute of the current start tag.
+             * @return false when there are no more attributes (or they're malformed).
+             */
+            bool next_attribute (Text & name, Text & value);
+
+            /**
+             * Skips the content of the current start tag up to its end tag (included).
+             * @return false if the end of the data or a syntax error is found before.
+             */
+            bool skip_element ();
+
+            Token get_token () const
+            {
+                return token;
+            }
+
+            /**
+             * Name of the current tag.
+             */
+            const Text & get_name () const
+            {
+                return name;
+            }
+
+            /**
+             * true if the current start tag closes itself (<name ... />).
+             */
+            bool is_empty_element () const
+            {
+                return empty_element;
+            }
+
+        };
+
+    }
+
+#endif
@@ -125,6 +125,22 @@
             return hash;
         }
 
+        /**
+         * Continues a FNV-1a hash with more chars, so that the hash of a string can be built piece
+         * by piece without joining them: fnv32 (b, size_b, fnv32 (a, size_a)) == fnv32 (a + b).
+         * @param hash Hash of the preceding chars (the basis when there are none).
+         */
+        inline uint32_t fnv32 (const char * chars, size_t length, uint32_t hash = internal::fnv_basis_32)
+        {
+            for (const char * end = chars + length; chars < end; ++chars)
+            {
+                hash ^= *chars;
+                hash *= internal::fnv_prime_32;
+            }
+
+            return hash;
+        }
+
     }
 
     constexpr unsigned operator "" _fnv (const char * c)
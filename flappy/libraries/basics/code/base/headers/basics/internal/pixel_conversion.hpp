@@ -0,0 +1,74 @@
+/*
+ * PIXEL CONVERSION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231015
+ */
+
+#ifndef BASICS_PIXEL_CONVERSION_HEADER
+#define BASICS_PIXEL_CONVERSION_HEADER
+
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        // The pixels of a Color_Buffer< Rgba8888 > are R, G, B, A bytes. The 16 bit formats are
+        // packed in native uint16 values with the first component in the most significant bits,
+        // which is what GL_UNSIGNED_SHORT_5_6_5, _4_4_4_4 and _5_5_5_1 expect.
+        //
+        // The kernels use NEON, AVX2 or SSE2 when available (AVX2 is detected at run time) and
+        // produce exactly the same results as the scalar ones.
+
+        /**
+         * Converts the pixels to RGB565 (dropping the alpha). When dither is true a 4x4 ordered
+         * dither pattern is added to the color components before truncating them, which hides the
+         * banding of smooth gradients.
+         */
+        void convert_to_rgb565   (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgb565   > & target, bool dither = false);
+
+        /**
+         * Converts the pixels to RGBA4444 (the alpha is never dithered).
+         */
+        void convert_to_rgba4444 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba4444 > & target, bool dither = false);
+
+        /**
+         * Converts the pixels to RGBA5551 (the alpha is 1 from 128 upwards).
+         */
+        void convert_to_rgba5551 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba5551 > & target, bool dither = false);
+
+        /**
+         * Multiplies the color components by the alpha (rounding to the nearest value).
+         */
+        void premultiply_alpha (Color_Buffer< Rgba8888 > & color_buffer);
+
+        enum Channel_Order
+        {
+            BGRA,
+            ARGB,
+            ABGR,
+        };
+
+        /**
+         * Reorders in place the components of pixels stored as R, G, B, A bytes.
+         */
+        void swizzle (Color_Buffer< Rgba8888 > & color_buffer, Channel_Order order);
+
+        /**
+         * Name of the kernels in use: "neon", "avx2", "sse2" or "scalar".
+         */
+        const char * get_pixel_conversion_kernels ();
+
+        /**
+         * Forces the scalar kernels (or restores the fastest ones) in order to compare them.
+         */
+        void use_scalar_pixel_conversion (bool scalar);
+
+    }
+
+#endif
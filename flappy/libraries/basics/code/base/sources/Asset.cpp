@@ -0,0 +1,35 @@
+/*
+ * ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802131030
+ */
+
+#include <basics/Asset>
+
+namespace basics
+{
+
+    Asset::View Asset::map (const std::string & path)
+    {
+        std::shared_ptr< Asset > asset = Asset::open (path);
+
+        if (asset)
+        {
+            const byte * bytes = asset->map ();
+
+            if (bytes)
+            {
+                return View(asset, bytes, asset->size ());
+            }
+        }
+
+        return View();
+    }
+
+}
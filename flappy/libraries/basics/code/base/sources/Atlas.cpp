@@ -16,25 +16,117 @@
 #include <cstring>
 
 #include <basics/Log>
+#include <basics/Profiler>
 
 using namespace std;
-using namespace rapidxml;
 
 namespace basics
 {
 
-    Atlas::Atlas(const string & path, Graphics_Context::Accessor & context)
+    namespace
     {
-        shared_ptr< Asset > slices_file = Asset::open (path);
 
-        if (slices_file->good ())
+        const char magic    [] = { 'B', 'A', 'T', 'L' };
+        const char extension[] = ".batlas";
+
+        static_assert(sizeof(Atlas::Record) == 44, "The records are read straight from the binary atlas.");
+
+        uint32_t read_uint16 (const byte * bytes)
+        {
+            return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8;
+        }
+
+        uint32_t read_uint32 (const byte * bytes)
+        {
+            return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+        }
+
+        void write_uint16 (byte * bytes, uint32_t value)
+        {
+            bytes[0] = byte(value     );
+            bytes[1] = byte(value >> 8);
+        }
+
+        void write_uint32 (byte * bytes, uint32_t value)
+        {
+            bytes[0] = byte(value      );
+            bytes[1] = byte(value >>  8);
+            bytes[2] = byte(value >> 16);
+            bytes[3] = byte(value >> 24);
+        }
+
+        void write_float (byte * bytes, float value)
         {
-            Buffer slices_data;
+            uint32_t bits;
 
-            if (slices_file->read_all (slices_data))
+            std::memcpy (&bits, &value, sizeof(bits));
+
+            write_uint32 (bytes, bits);
+        }
+
+        // Carpeta (con la barra final) en la que se encuentra un archivo:
+
+        string get_folder (const string & path)
+        {
+            size_t slash     = path.find_last_of ('/' );
+            size_t backslash = path.find_last_of ('\\');
+
+            if (slash != string::npos && backslash != string::npos)
             {
-                parse (slices_data, path, context);
+                return path.substr (0, std::max (slash, backslash + 1));
             }
+            else
+            if (slash != string::npos)
+            {
+                return path.substr (0, slash + 1);
+            }
+            else
+            if (backslash != string::npos)
+            {
+                return path.substr (0, backslash + 1);
+            }
+
+            return string();
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    string Atlas::get_binary_path_for (const string & path)
+    {
+        size_t slash = path.find_last_of ('/');
+        size_t dot   = path.find_last_of ('.');
+
+        if (dot == string::npos || (slash != string::npos && dot < slash))
+        {
+            return path + extension;
+        }
+
+        return path.substr (0, dot) + extension;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas::Atlas(const string & path, Graphics_Context::Accessor & context)
+    :
+        records     (nullptr),
+        record_count(0)
+    {
+        BASICS_PROFILE_ZONE ("load-atlas");
+
+        Asset::View binary_atlas = Asset::map (get_binary_path_for (path));
+
+        if (binary_atlas && load (binary_atlas, path, context))
+        {
+            return;
+        }
+
+        Asset::View slices_data = Asset::map (path);
+
+        if (slices_data)
+        {
+            parse (reinterpret_cast< const char * >(slices_data.data ()), slices_data.size (), path, context);
         }
     }
 
@@ -42,26 +134,81 @@ namespace basics
 
     Atlas::Atlas(const Texture_Handle & texture)
     :
-        texture(texture)
+        texture     (texture),
+        records     (nullptr),
+        record_count(0)
+    {
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas::Atlas(const string & path, const Texture_Handle & texture)
+    :
+        texture     (texture),
+        records     (nullptr),
+        record_count(0)
     {
+        if (!texture) return;
+
+        BASICS_PROFILE_ZONE ("load-atlas");
+
+        Graphics_Context::Accessor no_context;
+
+        Asset::View binary_atlas = Asset::map (get_binary_path_for (path));
+
+        if (binary_atlas && load (binary_atlas, path, no_context))
+        {
+            return;
+        }
+
+        Asset::View slices_data = Asset::map (path);
+
+        if (slices_data)
+        {
+            parse (reinterpret_cast< const char * >(slices_data.data ()), slices_data.size (), path, no_context);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas::Atlas(const char * sprites_text, size_t size, const Texture_Handle & texture)
+    :
+        texture     (texture),
+        records     (nullptr),
+        record_count(0)
+    {
+        Graphics_Context::Accessor no_context;
+
+        parse (sprites_text, size, string(), no_context);
     }
 
     // ---------------------------------------------------------------------------------------------
 
     Atlas::Slice * Atlas::add_slice (Id id, const Point2f & position, const Size2f & size)
     {
-        if (slices.count (id) == 0)
+        if (get_slice (id) == nullptr)
         {
-            return &
+            // Las coordenadas normalizadas se calculan una sola vez en lugar de en cada dibujado:
+
+            float horizontal_ratio = texture && texture->get_width  () > 0 ? 1.f / texture->get_width  () : 0.f;
+            float   vertical_ratio = texture && texture->get_height () > 0 ? 1.f / texture->get_height () : 0.f;
+            float left             = position.coordinates.x ();
+            float bottom           = position.coordinates.y ();
+
+            return &slices.emplace
             (
-                slices[id] =
+                id,
+                Slice
                 {
                     this,
-                    position.coordinates.x (), position.coordinates.x () + size.width,
-                    position.coordinates.y (), position.coordinates.y () + size.height,
-                    size.width,                size.height
+                    left,                    left   + size.width,
+                    bottom,                  bottom + size.height,
+                    size.width,              size.height,
+                    left * horizontal_ratio, (left   + size.width ) * horizontal_ratio,
+                    bottom * vertical_ratio, (bottom + size.height) *   vertical_ratio
                 }
-            );
+            )
+            .first->second;
         };
 
         return nullptr;
@@ -69,89 +216,260 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse (Buffer & slices_data, const std::string & path, Graphics_Context::Accessor & context)
+    bool Atlas::load (const Asset::View & binary_data, const std::string & path, Graphics_Context::Accessor & context)
+    {
+        const byte * bytes = binary_data.data ();
+        size_t       size  = binary_data.size ();
+
+        if (size < header_size || std::memcmp (bytes, magic, sizeof(magic)) != 0) return false;
+        if (read_uint16 (bytes + 4) != version) return false;
+
+        size_t   count          = read_uint32 (bytes +  8);
+        unsigned texture_width  = read_uint32 (bytes + 12);
+        unsigned texture_height = read_uint32 (bytes + 16);
+        size_t   name_offset    = read_uint32 (bytes + 20);
+        size_t   name_length    = read_uint32 (bytes + 24);
+
+        if (count == 0 || count > (size - header_size) / sizeof(Record)) return false;
+        if (name_offset > size || name_length > size - name_offset) return false;
+
+        // Los registros se usan directamente desde la vista del asset. Solo si no está alineada
+        // (algo que no debería ocurrir) se copian una vez:
+
+        const Record * records = reinterpret_cast< const Record * >(bytes + header_size);
+
+        if (reinterpret_cast< uintptr_t >(records) % alignof(Record) != 0)
+        {
+            own_records.resize (count);
+
+            std::memcpy (own_records.data (), bytes + header_size, count * sizeof(Record));
+
+            records = own_records.data ();
+        }
+
+        // La búsqueda binaria necesita que los ids estén ordenados y no se repitan:
+
+        for (size_t index = 1; index < count; ++index)
+        {
+            if (records[index - 1].id >= records[index].id)
+            {
+                own_records.clear ();
+                return false;
+            }
+        }
+
+        // Se intenta cargar la textura, salvo que se haya proporcionado una ya cargada:
+
+        if (!texture)
+        {
+            string texture_name(reinterpret_cast< const char * >(bytes + name_offset), name_length);
+
+            texture = Texture_2D::create (0, context, get_folder (path) + texture_name);
+
+            assert(texture);
+
+            if (texture) context->add (texture);
+        }
+
+        // Las coordenadas normalizadas del archivo corresponden al tamaño que tenía la textura, de
+        // modo que no sirven para una textura de otro tamaño (se usará el atlas de texto):
+
+        if (texture && (texture->get_width () != float(texture_width) || texture->get_height () != float(texture_height)))
+        {
+            own_records.clear ();
+            return false;
+        }
+
+        this->binary_data = binary_data;
+
+        index (records, count);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas::index (const Record * records, size_t count)
     {
-        // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
-        // final de los datos:
+        this->records      = records;
+        this->record_count = count;
 
-        slices_data.push_back (0);
+        // Los slices solo añaden el puntero al atlas a cada registro:
 
-        // Se parsea el xml de datos de slices:
+        record_slices.resize (count);
 
-        xml_document<> xml;
+        for (size_t index = 0; index < count; ++index)
+        {
+            const Record & record = records[index];
+
+            record_slices[index] =
+            {
+                this,
+                record.left,      record.right,
+                record.bottom,    record.top,
+                record.width,     record.height,
+                record.uv_left,   record.uv_right,
+                record.uv_bottom, record.uv_top
+            };
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas::encode (const char * sprites_text, size_t size, std::vector< byte > & binary_atlas)
+    {
+        // Se buscan los atributos del tag raíz "img":
 
-        xml.parse< 0 > (reinterpret_cast< char * >(slices_data.data ()));
+        Xml_Scanner xml(sprites_text, sprites_text + size);
 
-        // Se comprueba si se ha podido parsear el xml y, si se ha podido, se empieza a analizar el tag raíz:
+        if (xml.next () != Xml_Scanner::START_TAG || xml.get_name () != "img") return false;
 
-        xml_node<> * img_tag = xml.first_node ("img");
+        Xml_Scanner::Text attribute, value, name{ nullptr, nullptr };
+        int               texture_width  = 0;
+        int               texture_height = 0;
 
-        if (img_tag)
+        while (xml.next_attribute (attribute, value))
         {
-            parse_img (img_tag, path, context);
+            if (attribute == "name") name = value;                  else
+            if (attribute == "w"   ) value.to_int (texture_width ); else
+            if (attribute == "h"   ) value.to_int (texture_height);
         }
+
+        if (name.size () == 0 || texture_width <= 0 || texture_height <= 0) return false;
+
+        // Se leen los slices sin textura:
+
+        Atlas atlas(sprites_text, size);
+
+        if (atlas.record_count == 0) return false;
+
+        // Se escribe la cabecera, los registros (ya ordenados por id) y el nombre:
+
+        size_t count       = atlas.record_count;
+        size_t name_offset = header_size + count * sizeof(Record);
+
+        binary_atlas.assign (name_offset + name.size (), 0);
+
+        byte * bytes = binary_atlas.data ();
+
+        std::memcpy  (bytes, magic, sizeof(magic));
+        write_uint16 (bytes +  4, version);
+        write_uint32 (bytes +  8, uint32_t(count));
+        write_uint32 (bytes + 12, uint32_t(texture_width ));
+        write_uint32 (bytes + 16, uint32_t(texture_height));
+        write_uint32 (bytes + 20, uint32_t(name_offset));
+        write_uint32 (bytes + 24, uint32_t(name.size ()));
+
+        byte * record = bytes + header_size;
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            const Record & slice = atlas.records[index];
+
+            write_uint32 (record +  0, slice.id);
+            write_float  (record +  4, slice.left  );
+            write_float  (record +  8, slice.right );
+            write_float  (record + 12, slice.bottom);
+            write_float  (record + 16, slice.top   );
+            write_float  (record + 20, slice.width );
+            write_float  (record + 24, slice.height);
+            write_float  (record + 28, slice.left   / texture_width );
+            write_float  (record + 32, slice.right  / texture_width );
+            write_float  (record + 36, slice.bottom / texture_height);
+            write_float  (record + 40, slice.top    / texture_height);
+
+            record += sizeof(Record);
+        }
+
+        std::memcpy (bytes + name_offset, name.begin, name.size ());
+
+        return true;
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context)
+    void Atlas::parse (const char * text, size_t size, const std::string & path, Graphics_Context::Accessor & context)
     {
-        // Se busca el atributo "name" del tag "img", el cual indica el nombre del archivo de la textura:
+        // El texto se recorre directamente desde la vista del asset, sin copiarlo:
 
-        xml_attribute<> * name_attribute = img_tag->first_attribute ("name");
+        Xml_Scanner xml(text, text + size);
 
-        if (name_attribute)
+        // El tag raíz debe ser "img":
+
+        if (xml.next () == Xml_Scanner::START_TAG && xml.get_name () == "img")
         {
-            // Se determina la ruta de la textura:
+            parse_img (xml, path, context);
+        }
 
-            size_t slash     = path.find_last_of ('/' );
-            size_t backslash = path.find_last_of ('\\');
-            string texture_path;
+        // Los slices leídos se guardan como los de un atlas binario: ordenados por id para
+        // buscarlos con una búsqueda binaria, sin reservar memoria para cada uno:
 
-            if (slash != string::npos && backslash != string::npos)
-            {
-                texture_path = path.substr (0, std::max (slash, backslash + 1));
-            }
-            else
-            if (slash != string::npos)
-            {
-                texture_path = path.substr (0, slash + 1);
-            }
-            else
-            if (backslash != string::npos)
-            {
-                texture_path = path.substr (0, backslash + 1);
-            }
+        std::stable_sort
+        (
+            own_records.begin (), own_records.end (),
+            [] (const Record & a, const Record & b) { return a.id < b.id; }
+        );
 
-            // Se intenta cargar la textura:
+        auto duplicates = std::unique
+        (
+            own_records.begin (), own_records.end (),
+            [] (const Record & a, const Record & b) { return a.id == b.id; }
+        );
 
-            texture = Texture_2D::create (0, context, texture_path + name_attribute->value ());
+        assert(duplicates == own_records.end ());
 
-            assert(texture);
+        own_records.erase (duplicates, own_records.end ());
 
-            if (texture)
-            {
-                context->add (texture);
+        if (!own_records.empty ())
+        {
+            index (own_records.data (), own_records.size ());
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
 
-                // Se comprueba que las dimensiones de la textura coinciden con lo que indica el XML:
+    void Atlas::parse_img (Xml_Scanner & xml, const std::string & path, Graphics_Context::Accessor & context)
+    {
+        // Se busca el atributo "name" del tag "img", el cual indica el nombre del archivo de la textura:
 
-                //xml_attribute<> * w_attribute = img_tag->first_attribute ("w");
-                //xml_attribute<> * h_attribute = img_tag->first_attribute ("h");
+        Xml_Scanner::Text attribute, value, name{ nullptr, nullptr };
 
-                //assert(!w_attribute || texture->get_width  () == std::atoi (w_attribute->value ()));
-                //assert(!h_attribute || texture->get_height () == std::atoi (h_attribute->value ()));
+        while (xml.next_attribute (attribute, value))
+        {
+            if (attribute == "name") name = value;
+        }
 
-                // Se busca el tag "definitions" (anidado en el tag "img"):
+        if (name.size () > 0 && !xml.is_empty_element ())
+        {
+            // Se intenta cargar la textura, salvo que se haya proporcionado una ya cargada:
+
+            if (!texture && context)
+            {
+                texture = Texture_2D::create (0, context, get_folder (path) + string(name.begin, name.end));
 
-                xml_node<> * definitions_tag = img_tag->first_node ();
+                assert(texture);
 
-                if (definitions_tag && definitions_tag->name () == string("definitions"))
+                if (texture) context->add (texture);
+            }
+
+            // Sin contexto ni textura solo se leen los slices (ver encode()):
+
+            if (texture || !context)
+            {
+                // Se busca el tag "definitions" (el primero anidado en el tag "img"):
+
+                if (xml.next () == Xml_Scanner::START_TAG && xml.get_name () == "definitions" && !xml.is_empty_element ())
                 {
-                    // Se buscan y parsean todos los tags "dir" anidados dentro de "definitions":
+                    // Se parsean todos los tags "dir" anidados dentro de "definitions". El nombre
+                    // de estos no forma parte de los ids:
 
-                    for (xml_node<> * dir_tag = definitions_tag->first_node ("dir"); dir_tag; dir_tag = dir_tag->next_sibling ("dir"))
+                    while (xml.next () == Xml_Scanner::START_TAG)
                     {
-                        parse_dir (dir_tag);
+                        bool parsed = xml.get_name () == "dir"
+                                    ? parse_dir (xml, internal::fnv_basis_32, false)
+                                    : xml.skip_element ();
+
+                        if (!parsed) break;
                     }
                 }
             }
@@ -160,66 +478,100 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse_dir (rapidxml::xml_node<> * dir_tag, const string & prefix)
+    bool Atlas::parse_dir (Xml_Scanner & xml, uint32_t prefix, bool has_prefix)
     {
-        for (xml_node<> * child = dir_tag->first_node (); child; child = child->next_sibling ())
+        if (xml.is_empty_element ()) return true;
+
+        while (xml.next () == Xml_Scanner::START_TAG)
         {
-            if (child->type () == node_element)
-            {
-                // Se espera que un tag anidado en "dir" sea otro "dir" o un "spr" y debe tener
-                // atributo "name" para ser tenido en cuenta:
+            // Se espera que un tag anidado en "dir" sea otro "dir" o un "spr":
 
-                xml_attribute<> * name_attribute = child->first_attribute ("name");
+            bool parsed;
 
-                if (name_attribute)
-                {
-                    // Se determina el id del nodo añadiendo al prefijo el nombre propio:
+            if (xml.get_name () == "dir")
+            {
+                // Debe tener atributo "name" para ser tenido en cuenta:
 
-                    string id = prefix + name_attribute->value ();
+                Xml_Scanner::Text attribute, value, name{ nullptr, nullptr };
 
-                    // Se interpreta el "dir" o "spr":
+                while (xml.next_attribute (attribute, value))
+                {
+                    if (attribute == "name") name = value;
+                }
 
-                    if (child->name () == string("dir"))
-                    {
-                        // Si se trata de un "dir" raíz con un nombre por defecto, se descarta su id.
-                        // En otro caso, se le añade un punto como separador:
+                if (name.size () == 0)
+                {
+                    parsed = xml.skip_element ();
+                }
+                else
+                if (!has_prefix && name == "/")
+                {
+                    // Si se trata de un "dir" raíz con un nombre por defecto, se descarta su nombre:
 
-                        if (id == "/") id.clear (); else id += ".";
+                    parsed = parse_dir (xml, prefix, false);
+                }
+                else
+                {
+                    // En otro caso, el hash del id continúa con el nombre propio y un punto como
+                    // separador, sin formar la cadena:
 
-                        parse_dir (child, id);
-                    }
-                    else
-                    if (child->name () == string("spr"))
-                    {
-                        parse_spr (child, id);
-                    }
+                    parsed = parse_dir (xml, fnv32 (".", 1, name.hash (prefix)), true);
                 }
             }
+            else
+            if (xml.get_name () == "spr")
+            {
+                parsed = parse_spr (xml, prefix);
+            }
+            else
+                parsed = xml.skip_element ();
+
+            if (!parsed) return false;
         }
+
+        return xml.get_token () == Xml_Scanner::END_TAG;
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse_spr (rapidxml::xml_node<> * spr_tag, const std::string & id)
+    bool Atlas::parse_spr (Xml_Scanner & xml, uint32_t prefix)
     {
         // Se extraen todos los atributos básicos:
 
-        xml_attribute<> * x_attribute = spr_tag->first_attribute ("x");
-        xml_attribute<> * y_attribute = spr_tag->first_attribute ("y");
-        xml_attribute<> * w_attribute = spr_tag->first_attribute ("w");
-        xml_attribute<> * h_attribute = spr_tag->first_attribute ("h");
+        Xml_Scanner::Text attribute, value, name{ nullptr, nullptr };
+        int               x = 0, y = 0, w = 0, h = 0;
+        unsigned          found = 0;
 
-        if (x_attribute && y_attribute && w_attribute && h_attribute)
+        while (xml.next_attribute (attribute, value))
         {
-            float x = std::atoi (x_attribute->value ());
-            float y = std::atoi (y_attribute->value ());
-            float w = std::atoi (w_attribute->value ());
-            float h = std::atoi (h_attribute->value ());
-
-            Slice * slice = add_slice (fnv32 (id), { x, y }, { w, h });
+            if (attribute == "name") { name   = value;                       } else
+            if (attribute == "x"   ) { found |= value.to_int (x) ? 0x01 : 0; } else
+            if (attribute == "y"   ) { found |= value.to_int (y) ? 0x02 : 0; } else
+            if (attribute == "w"   ) { found |= value.to_int (w) ? 0x04 : 0; } else
+            if (attribute == "h"   ) { found |= value.to_int (h) ? 0x08 : 0; }
+        }
 
-            assert (slice && w && h);
+        if (found == 0x0F && name.size () > 0)
+        {
+            assert(w && h);
+
+            // Las coordenadas normalizadas se calculan una sola vez en lugar de en cada dibujado:
+
+            float horizontal_ratio = texture && texture->get_width  () > 0 ? 1.f / texture->get_width  () : 0.f;
+            float   vertical_ratio = texture && texture->get_height () > 0 ? 1.f / texture->get_height () : 0.f;
+
+            own_records.push_back
+            ({
+                name.hash (prefix),
+                float(x),                    float(x + w),
+                float(y),                    float(y + h),
+                float(w),                    float(h),
+                float(x) * horizontal_ratio, float(x + w) * horizontal_ratio,
+                float(y) *   vertical_ratio, float(y + h) *   vertical_ratio
+            });
         }
+
+        return xml.skip_element ();
     }
 
 }
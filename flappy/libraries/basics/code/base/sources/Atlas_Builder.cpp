@@ -0,0 +1,461 @@
+/*
+ * ATLAS BUILDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802241030
+ */
+
+#include <algorithm>
+#include <basics/Atlas_Builder>
+#include <basics/Texture_2D>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Bottom-left skyline packer: the free space of a page is described by the top edge of the
+        // images already placed (y grows downwards, like the rows of the pages), and each new image
+        // goes where its bottom edge ends up highest:
+
+        class Skyline
+        {
+
+            struct Segment
+            {
+                unsigned x;
+                unsigned y;
+                unsigned width;
+            };
+
+            unsigned               width;
+            unsigned               height;
+            std::vector< Segment > segments;
+
+        public:
+
+            Skyline(unsigned width, unsigned height)
+            :
+                width   (width ),
+                height  (height),
+                segments(1, Segment{ 0, 0, width })
+            {
+            }
+
+            bool insert (unsigned item_width, unsigned item_height, unsigned & x, unsigned & y)
+            {
+                size_t   best_index  = segments.size ();
+                unsigned best_bottom = ~0u;
+                unsigned best_width  = ~0u;
+
+                for (size_t index = 0; index < segments.size (); ++index)
+                {
+                    unsigned top;
+
+                    if (fits (index, item_width, item_height, top))
+                    {
+                        unsigned bottom = top + item_height;
+
+                        if (bottom < best_bottom || (bottom == best_bottom && segments[index].width < best_width))
+                        {
+                            best_index  = index;
+                            best_bottom = bottom;
+                            best_width  = segments[index].width;
+                        }
+                    }
+                }
+
+                if (best_index == segments.size ()) return false;
+
+                x = segments[best_index].x;
+                y = best_bottom - item_height;
+
+                add (best_index, x, best_bottom, item_width);
+
+                return true;
+            }
+
+        private:
+
+            // The image rests on the highest segment of the ones that it spans:
+
+            bool fits (size_t index, unsigned item_width, unsigned item_height, unsigned & top) const
+            {
+                if (segments[index].x + item_width > width) return false;
+
+                unsigned remaining = item_width;
+
+                top = 0;
+
+                for ( ; remaining > 0; ++index)
+                {
+                    top = std::max (top, segments[index].y);
+
+                    if (top + item_height > height) return false;
+
+                    remaining -= std::min (remaining, segments[index].width);
+                }
+
+                return true;
+            }
+
+            void add (size_t index, unsigned x, unsigned y, unsigned item_width)
+            {
+                segments.insert (segments.begin () + index, Segment{ x, y, item_width });
+
+                // The segments covered by the new one are cut or removed:
+
+                for (size_t next = index + 1; next < segments.size (); )
+                {
+                    unsigned previous_end = segments[next - 1].x + segments[next - 1].width;
+                    Segment & segment     = segments[next];
+
+                    if (segment.x >= previous_end) break;
+
+                    unsigned overlap = previous_end - segment.x;
+
+                    if (segment.width <= overlap)
+                    {
+                        segments.erase (segments.begin () + next);
+                        continue;
+                    }
+
+                    segment.x     += overlap;
+                    segment.width -= overlap;
+                    break;
+                }
+
+                // Neighbours at the same height are merged to keep the list short:
+
+                for (size_t current = 0; current + 1 < segments.size (); )
+                {
+                    if (segments[current].y == segments[current + 1].y)
+                    {
+                        segments[current].width += segments[current + 1].width;
+                        segments.erase (segments.begin () + current + 1);
+                    }
+                    else
+                        ++current;
+                }
+            }
+
+        };
+
+        struct Cell
+        {
+            unsigned width;
+            unsigned height;
+            unsigned page;
+            unsigned x;
+            unsigned y;
+        };
+
+        struct Extent
+        {
+            unsigned width;
+            unsigned height;
+        };
+
+        // Places the cells (in the given order) on as many pages as needed and returns the extents
+        // of the pages once they're cropped to the space used:
+
+        std::vector< Extent > layout (std::vector< Cell > & cells, unsigned page_width, unsigned page_height)
+        {
+            std::vector< Skyline > skylines;
+            std::vector< Extent  > extents;
+
+            for (auto & cell : cells)
+            {
+                unsigned page = 0;
+
+                for ( ; page < skylines.size (); ++page)
+                {
+                    if (skylines[page].insert (cell.width, cell.height, cell.x, cell.y)) break;
+                }
+
+                if (page == skylines.size ())
+                {
+                    // A cell bigger than a page gets a page of its own:
+
+                    skylines.emplace_back (std::max (page_width, cell.width), std::max (page_height, cell.height));
+                    skylines.back ().insert (cell.width, cell.height, cell.x, cell.y);
+                    extents .push_back ({ 0, 0 });
+                }
+
+                cell.page = page;
+
+                extents[page].width  = std::max (extents[page].width,  cell.x + cell.width );
+                extents[page].height = std::max (extents[page].height, cell.y + cell.height);
+            }
+
+            return extents;
+        }
+
+        // Copies an image into the page repeating its edge pixels around it:
+
+        void blit_extruded (const Color_Buffer< Rgba8888 > & image, Color_Buffer< Rgba8888 > & page, unsigned x, unsigned y, unsigned extrusion)
+        {
+            int image_width  = int(image.get_width  ());
+            int image_height = int(image.get_height ());
+            int border       = int(extrusion);
+
+            for (int row = -border; row < image_height + border; ++row)
+            {
+                int        source_row = std::min (std::max (row, 0), image_height - 1);
+                Rgba8888 * target     = page.buffer.data () + size_t(y + border + row) * page.get_width () + x;
+
+                for (int column = -border; column < image_width + border; ++column)
+                {
+                    int source_column = std::min (std::max (column, 0), image_width - 1);
+
+                    *target++ = image.buffer[size_t(source_row) * image_width + source_column];
+                }
+            }
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    constexpr Atlas_Builder::Settings Atlas_Builder::default_settings;
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas_Builder::Atlas_Builder(const Settings & settings)
+    :
+        shared  (std::make_shared< Shared_State > ()),
+        started (false),
+        uploaded(false)
+    {
+        shared->settings  = settings;
+        shared->good      = false;
+        shared->packed    = false;
+        shared->cancelled = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas_Builder::~Atlas_Builder()
+    {
+        shared->cancelled = true;
+
+        thread_pool.reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Builder::add (Id id, const std::string & asset_path)
+    {
+        if (!started) shared->images.push_back (Image{ id, asset_path, {}, 0, 0, 0, 0, 0 });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Builder::add (Id id, const Color_Buffer< Rgba8888 > & pixels)
+    {
+        if (!started) shared->images.push_back (Image{ id, std::string(), pixels, 0, 0, 0, 0, 0 });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Builder::start ()
+    {
+        if (started) return;
+
+        std::shared_ptr< Shared_State > shared = this->shared;
+
+        started     = true;
+        thread_pool.reset (new Thread_Pool(1));
+
+        thread_pool->submit
+        (
+            [shared] ()
+            {
+                if (!shared->cancelled) pack (*shared);
+
+                shared->packed = true;
+            }
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Builder::pack (Shared_State & shared)
+    {
+        const Settings & settings = shared.settings;
+
+        for (auto & image : shared.images)
+        {
+            if (!image.asset_path.empty ())
+            {
+                Texture_2D::Options options{};
+
+                if (!Texture_2D::decode (image.asset_path, image.pixels, options) || shared.cancelled) return;
+            }
+
+            if (image.pixels.size () == 0) return;
+
+            image.width  = image.pixels.get_width  ();
+            image.height = image.pixels.get_height ();
+        }
+
+        // The tallest images go first, which leaves fewer gaps under the skyline:
+
+        std::vector< Image * > order;
+
+        for (auto & image : shared.images) order.push_back (&image);
+
+        std::stable_sort
+        (
+            order.begin (), order.end (),
+            [] (const Image * a, const Image * b)
+            {
+                return a->height != b->height ? a->height > b->height : a->width > b->width;
+            }
+        );
+
+        unsigned             border = settings.extrusion * 2 + settings.padding;
+        std::vector< Cell >  cells;
+        unsigned             widest = 0;
+
+        for (Image * image : order)
+        {
+            cells.push_back ({ image->width + border, image->height + border, 0, 0, 0 });
+
+            widest = std::max (widest, image->width + border);
+        }
+
+        // The skyline fills the pages from left to right, so a narrower page can end up smaller
+        // once it's cropped. Several widths are tried and the one that needs fewer pages and less
+        // area is kept:
+
+        std::vector< Cell   > best_cells;
+        std::vector< Extent > best_extents;
+        size_t                best_area = 0;
+
+        for (unsigned width = std::min (widest, settings.page_width); ; width = std::min (width + 32, settings.page_width))
+        {
+            std::vector< Extent > extents = layout (cells, width, settings.page_height);
+            size_t                area    = 0;
+
+            for (auto & extent : extents) area += size_t(extent.width) * extent.height;
+
+            if (best_extents.empty () || extents.size () < best_extents.size () || (extents.size () == best_extents.size () && area < best_area))
+            {
+                best_cells   = cells;
+                best_extents = extents;
+                best_area    = area;
+            }
+
+            if (width >= settings.page_width) break;
+        }
+
+        for (size_t index = 0; index < order.size (); ++index)
+        {
+            order[index]->page = best_cells[index].page;
+            order[index]->x    = best_cells[index].x;
+            order[index]->y    = best_cells[index].y;
+        }
+
+        // The images are copied into the pages, which are cropped to the space used:
+
+        shared.pages.resize (best_extents.size ());
+
+        for (size_t index = 0; index < best_extents.size (); ++index)
+        {
+            shared.pages[index].occupancy = { best_extents[index].width, best_extents[index].height, 0 };
+        }
+
+        for (auto & image : shared.images)
+        {
+            shared.pages[image.page].occupancy.used_pixels += size_t(image.width) * image.height;
+        }
+
+        for (auto & page : shared.pages)
+        {
+            page.pixels = Color_Buffer< Rgba8888 >(page.occupancy.width, page.occupancy.height);
+        }
+
+        for (auto & image : shared.images)
+        {
+            blit_extruded (image.pixels, shared.pages[image.page].pixels, image.x, image.y, settings.extrusion);
+
+            image.pixels = Color_Buffer< Rgba8888 >();
+        }
+
+        shared.good = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas_Builder::upload (Graphics_Context::Accessor & context)
+    {
+        if (uploaded) return true;
+
+        if (!started || !shared->packed || !context) return false;
+
+        thread_pool.reset ();
+
+        uploaded = true;
+
+        if (!shared->good) return true;
+
+        std::vector< Atlas_Handle > page_atlases;
+
+        for (auto & page : shared->pages)
+        {
+            // The pages don't come from an asset, so the textures keep their pixels in order to
+            // rebuild themselves if the context is lost:
+
+            Texture_2D::Options options{};
+
+            options.width  = page.pixels.get_width  ();
+            options.height = page.pixels.get_height ();
+
+            std::shared_ptr< Texture_2D > texture = Texture_2D::create (0, context, page.pixels, options);
+
+            if (!texture)
+            {
+                occupancy.clear ();
+                return true;
+            }
+
+            context->add (texture);
+
+            page_atlases.emplace_back (new Atlas(texture));
+            occupancy   .push_back    (page.occupancy);
+
+            page.pixels = Color_Buffer< Rgba8888 >();
+        }
+
+        unsigned extrusion = shared->settings.extrusion;
+
+        for (auto & image : shared->images)
+        {
+            page_atlases[image.page]->add_slice
+            (
+                image.id,
+                { float(image.x + extrusion), float(image.y + extrusion) },
+                { float(image.width), float(image.height) }
+            );
+        }
+
+        // Adding a slice may move the previous ones, so they're looked up once all are added:
+
+        for (auto & image : shared->images)
+        {
+            if (const Atlas::Slice * slice = page_atlases[image.page]->get_slice (image.id)) slices[image.id] = slice;
+        }
+
+        atlases.swap (page_atlases);
+
+        return true;
+    }
+
+}
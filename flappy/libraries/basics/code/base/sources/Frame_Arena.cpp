@@ -0,0 +1,184 @@
+/*
+ * FRAME ARENA
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803031030
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <basics/Frame_Arena>
+#include <basics/Log>
+#include <basics/macros>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // The header of the blocks takes a multiple of the maximum alignment, so that the data of
+        // every block starts aligned as the memory returned by operator new:
+
+        const size_t block_header_size = (16 + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+        size_t round_up_to_power_of_2 (size_t value)
+        {
+            size_t result = 1;
+
+            while (result < value) result <<= 1;
+
+            return result;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Arena::Frame_Arena(size_t capacity)
+    {
+        block            = create_block (std::max< size_t > (capacity, 256));
+        extra_blocks     = nullptr;
+        top              = data (block);
+        end              = top + block->capacity;
+        frame_bytes      = 0;
+        last_frame_bytes = 0;
+        high_water_mark  = 0;
+        frame_count      = 0;
+        heap_allocations = 0;
+
+        #if defined(BASICS_OPTIMIZED_BUILD)
+            debug_mode   = false;
+        #else
+            debug_mode   = true;
+        #endif
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Arena::~Frame_Arena()
+    {
+        while (extra_blocks)
+        {
+            Block * next = extra_blocks->next;
+
+            destroy_block (extra_blocks);
+
+            extra_blocks = next;
+        }
+
+        destroy_block (block);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Arena::reset ()
+    {
+        bool new_high_water_mark = frame_bytes > high_water_mark;
+
+        if (new_high_water_mark) high_water_mark = frame_bytes;
+
+        if (extra_blocks)
+        {
+            // The frame didn't fit in the main block, so it's replaced by one where the largest
+            // frame fits:
+
+            while (extra_blocks)
+            {
+                Block * next = extra_blocks->next;
+
+                destroy_block (extra_blocks);
+
+                extra_blocks = next;
+            }
+
+            destroy_block (block);
+
+            block = create_block (round_up_to_power_of_2 (high_water_mark));
+        }
+        else
+        if (debug_mode)
+        {
+            poison (data (block), size_t(top - data (block)), freed_byte);
+        }
+
+        if (debug_mode && new_high_water_mark)
+        {
+            log.d
+            (
+                "frame arena: frame " + std::to_string (frame_count) + " used " + std::to_string (frame_bytes) +
+                " bytes (capacity " + std::to_string (block->capacity) + ")"
+            );
+        }
+
+        top              = data (block);
+        end              = top + block->capacity;
+        last_frame_bytes = frame_bytes;
+        frame_bytes      = 0;
+
+        frame_count++;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void * Frame_Arena::allocate_in_extra_block (size_t size, size_t alignment)
+    {
+        // The bytes left at the end of the current block are counted as used, because the next
+        // frame will need them to fit in a single block:
+
+        frame_bytes += size_t(end - top);
+
+        Block * extra_block = create_block (std::max (block->capacity, size + alignment));
+
+        extra_block->next = extra_blocks;
+        extra_blocks      = extra_block;
+        top               = data (extra_block);
+        end               = top + extra_block->capacity;
+
+        heap_allocations++;
+
+        return allocate (size, alignment);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    char * Frame_Arena::data (Block * block)
+    {
+        return reinterpret_cast< char * >(block) + block_header_size;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Arena::Block * Frame_Arena::create_block (size_t capacity)
+    {
+        static_assert (sizeof(Block) <= 16, "the header of the blocks doesn't fit");
+
+        Block * block = static_cast< Block * >(::operator new (block_header_size + capacity));
+
+        block->next     = nullptr;
+        block->capacity = capacity;
+
+        return block;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Arena::destroy_block (Block * block)
+    {
+        ::operator delete (block);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Arena::poison (void * address, size_t size, unsigned char byte)
+    {
+        std::memset (address, byte, size);
+    }
+
+}
@@ -0,0 +1,280 @@
+/*
+ * PROFILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803041030
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <basics/Log>
+#include <basics/Profiler>
+
+namespace basics
+{
+
+    Profiler & profiler = Profiler::get_instance ();
+
+    namespace
+    {
+
+        thread_local const char * thread_name = nullptr;
+
+        void write_json_string (std::ostream & output, const char * text)
+        {
+            output << '"';
+
+            for ( ; *text; ++text)
+            {
+                char character = *text;
+
+                if (character == '"' || character == '\\')
+                {
+                    output << '\\' << character;
+                }
+                else
+                if (static_cast< unsigned char >(character) < 0x20)
+                {
+                    char escaped[8];
+
+                    std::snprintf (escaped, sizeof(escaped), "\\u%04x", unsigned(character));
+
+                    output << escaped;
+                }
+                else
+                    output << character;
+            }
+
+            output << '"';
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void write_microseconds (std::ostream & output, int64_t nanoseconds)
+        {
+            char text[32];
+
+            std::snprintf (text, sizeof(text), "%lld.%03lld", (long long)(nanoseconds / 1000), (long long)(nanoseconds % 1000));
+
+            output << text;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Profiler::Profiler()
+    {
+        capturing        = false;
+        requested_frames = 0;
+        captured_frames  = 0;
+        frames_left      = 0;
+        capture_start    = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::capture (unsigned frames, const std::string & path)
+    {
+        #if !BASICS_PROFILER
+            log.w ("the profiler zones were removed at compile time (BASICS_PROFILER=0).");
+        #endif
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        requested_path   = path;
+        requested_frames = frames;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::set_thread_name (const char * name)
+    {
+        thread_name = name;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::record (const char * name, int64_t start, int64_t end)
+    {
+        Thread_Ring * ring  = get_thread_ring ();
+        uint64_t      index = ring->written.load (std::memory_order_relaxed);
+        Slot        & slot  = ring->slots[index % ring_capacity];
+
+        // A reader that sees any of these stores will also see that written reached index, so it
+        // can tell that the slot doesn't hold the record of the previous lap anymore:
+
+        std::atomic_thread_fence (std::memory_order_release);
+
+        slot.name .store (name,  std::memory_order_relaxed);
+        slot.start.store (start, std::memory_order_relaxed);
+        slot.end  .store (end,   std::memory_order_relaxed);
+
+        ring->written.store (index + 1, std::memory_order_release);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Profiler::Thread_Ring * Profiler::get_thread_ring ()
+    {
+        thread_local Thread_Ring * thread_ring = nullptr;
+
+        if (!thread_ring)
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            thread_ring = new Thread_Ring;
+
+            thread_ring->thread_id     = uint32_t(rings.size () + 1);
+            thread_ring->thread_name   = thread_name ? thread_name : "thread " + std::to_string (rings.size () + 1);
+            thread_ring->written       = 0;
+            thread_ring->capture_begin = 0;
+
+            rings.emplace_back (thread_ring);
+        }
+
+        return thread_ring;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::begin_frame ()
+    {
+        if (requested_frames.load (std::memory_order_relaxed) == 0) return;
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        unsigned frames = requested_frames.exchange (0);
+
+        if (frames == 0 || capturing) return;
+
+        path            = requested_path;
+        captured_frames = 0;
+        frames_left     = frames;
+        capture_start   = now ();
+
+        for (auto & ring : rings)
+        {
+            ring->capture_begin = ring->written.load (std::memory_order_acquire);
+        }
+
+        capturing = true;
+
+        log.d ("profiler: capturing " + std::to_string (frames) + " frames");
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Profiler::end_frame (int64_t frame_start)
+    {
+        if (!capturing) return false;
+
+        record ("frame", frame_start, now ());
+
+        captured_frames++;
+
+        if (--frames_left > 0) return false;
+
+        capturing = false;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Profiler::write_capture ()
+    {
+        std::ofstream output(path, std::ios::binary);
+
+        if (output)
+        {
+            write_chrome_trace (output);
+        }
+
+        if (!output)
+        {
+            log.e ("profiler: failed to write the capture to " + path);
+            return false;
+        }
+
+        log.d ("profiler: " + std::to_string (captured_frames) + " frames written to " + path);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::write_chrome_trace (std::ostream & output)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+
+        for (auto & ring : rings)
+        {
+            uint64_t end   = ring->written.load (std::memory_order_acquire);
+            uint64_t begin = ring->capture_begin;
+
+            if (end - begin > ring_capacity)
+            {
+                begin = end - ring_capacity;
+            }
+
+            output << (first ? "\n" : ",\n")
+                   << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->thread_id
+                   << ",\"args\":{\"name\":";
+
+            write_json_string (output, ring->thread_name.c_str ());
+
+            output << "}}";
+
+            first = false;
+
+            for (uint64_t index = begin; index < end; ++index)
+            {
+                // The owner thread may be overwriting the slot with a zone that ended after the
+                // capture. The copy is only good if written didn't reach the next lap meanwhile:
+
+                const Slot & slot   = ring->slots[index % ring_capacity];
+                Record       record = Record
+                {
+                    slot.name .load (std::memory_order_relaxed),
+                    slot.start.load (std::memory_order_relaxed),
+                    slot.end  .load (std::memory_order_relaxed)
+                };
+
+                std::atomic_thread_fence (std::memory_order_acquire);
+
+                if (ring->written.load (std::memory_order_relaxed) - index >= ring_capacity) continue;
+
+                // The zones that started before the capture are incomplete:
+
+                if (record.start < capture_start) continue;
+
+                output << ",\n{\"name\":";
+
+                write_json_string (output, record.name);
+
+                output << ",\"cat\":\"basics\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->thread_id << ",\"ts\":";
+
+                write_microseconds (output, record.start - capture_start);
+
+                output << ",\"dur\":";
+
+                write_microseconds (output, record.end - record.start);
+
+                output << '}';
+            }
+        }
+
+        output << "\n]}\n";
+    }
+
+}
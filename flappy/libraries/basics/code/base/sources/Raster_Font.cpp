@@ -10,28 +10,20 @@
  * C1802030114
  */
 
-#include <cstring>
-#include <rapidxml.hpp>
 #include <basics/Raster_Font>
 
 using namespace std;
-using namespace rapidxml;
 
 namespace basics
 {
 
     Raster_Font::Raster_Font(const string & path, Graphics_Context::Accessor & context)
     {
-        shared_ptr< Asset > font_file = Asset::open (path);
+        Asset::View font_data = Asset::map (path);
 
-        if (font_file->good ())
+        if (font_data)
         {
-            Buffer font_data;
-
-            if (font_file->read_all (font_data))
-            {
-                ready = parse (font_data, path, context);
-            }
+            ready = parse (font_data, path, context);
         }
     }
 
@@ -39,29 +31,22 @@ namespace basics
 
     bool Raster_Font::parse
     (
-        Buffer                     & font_data,
+        const Asset::View          & font_data,
         const std::string          & path,
         Graphics_Context::Accessor & context
     )
     {
-        // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
-        // final de los datos:
-
-        font_data.push_back (0);
+        // El texto se recorre directamente desde la vista de solo lectura del asset, sin copiarlo:
 
-        // Se parsea el xml de datos de la fuente:
+        const char * text = reinterpret_cast< const char * >(font_data.data ());
 
-        xml_document<> xml;
+        Xml_Scanner xml(text, text + font_data.size ());
 
-        xml.parse< 0 > (reinterpret_cast< char * >(font_data.data ()));
+        // El tag raíz debe ser "font":
 
-        // Se comprueba si se ha podido parsear el xml y, si se ha podido, se empieza a analizar el tag raíz:
-
-        xml_node<> * font_tag = xml.first_node ("font");
-
-        if (font_tag)
+        if (xml.next () == Xml_Scanner::START_TAG && xml.get_name () == "font" && !xml.is_empty_element ())
         {
-            return parse_font (font_tag, path, context);
+            return parse_font (xml, path, context);
         }
 
         return false;
@@ -71,44 +56,72 @@ namespace basics
 
     bool Raster_Font::parse_font
     (
-        rapidxml::xml_node<>       * font_tag,
+        Xml_Scanner                & xml,
         const std::string          & path,
         Graphics_Context::Accessor & context
     )
     {
-        xml_node<> *   info_tag = font_tag->first_node ("info"  );
-        xml_node<> * common_tag = font_tag->first_node ("common");
-        xml_node<> *  chars_tag = font_tag->first_node ("chars" );
-        xml_node<> *  pages_tag = font_tag->first_node ("pages" );
+        // Los tags se interpretan en el orden en el que aparecen, por lo que "pages" (que carga la
+        // textura) debe preceder a "chars", como ocurre en los archivos generados por BMFont:
+
+        bool   info_parsed = false;
+        bool common_parsed = false;
+        bool  pages_parsed = false;
+        bool  chars_parsed = false;
+
+        while (xml.next () == Xml_Scanner::START_TAG)
+        {
+            const Xml_Scanner::Text & name = xml.get_name ();
+
+            bool parsed;
+
+            if (name == "info"   &&   !info_parsed) parsed =   info_parsed = parse_info   (xml);                else
+            if (name == "common" && !common_parsed) parsed = common_parsed = parse_common (xml);                else
+            if (name == "pages"  &&  !pages_parsed) parsed =  pages_parsed = parse_pages  (xml, path, context); else
+            if (name == "chars"  &&  !chars_parsed) parsed =  chars_parsed = pages_parsed && parse_chars (xml); else
+                parsed = xml.skip_element ();
+
+            if (!parsed) return false;
+        }
 
         return
-              info_tag &&
-            common_tag &&
-             pages_tag &&
-             chars_tag &&
-             parse_pages  ( pages_tag, path, context) &&
-             parse_info   (  info_tag) &&
-             parse_common (common_tag) &&
-             parse_chars  ( chars_tag);
+             info_parsed &&
+           common_parsed &&
+            pages_parsed &&
+            chars_parsed &&
+            xml.get_token () == Xml_Scanner::END_TAG;
     }
 
     // ---------------------------------------------------------------------------------------------
 
     bool Raster_Font::parse_pages
     (
-        rapidxml::xml_node<>       * pages_tag,
+        Xml_Scanner                & xml,
         const std::string          & path,
         Graphics_Context::Accessor & context
     )
     {
-        xml_node<> * page = pages_tag->first_node ("page");
+        if (xml.is_empty_element ()) return false;
 
-        if (page)
+        bool first_page = true;
+
+        while (xml.next () == Xml_Scanner::START_TAG)
         {
-            xml_attribute<> * file_attritube = page->first_attribute ("file");
+            // Solo se admite una página, la primera:
 
-            if (file_attritube)
+            if (xml.get_name () == "page" && first_page)
             {
+                first_page = false;
+
+                Xml_Scanner::Text attribute, value, file{ nullptr, nullptr };
+
+                while (xml.next_attribute (attribute, value))
+                {
+                    if (attribute == "file") file = value;
+                }
+
+                if (file.size () == 0) return false;
+
                 // Se determina la ruta de la textura:
 
                 size_t slash     = path.find_last_of ('/' );
@@ -132,87 +145,102 @@ namespace basics
 
                 // Se intenta cargar la textura:
 
-                auto texture = Texture_2D::create (0, context, texture_path + file_attritube->value ());
+                auto texture = Texture_2D::create (0, context, texture_path.append (file.begin, file.end));
 
                 assert(texture);
 
-                if (texture)
-                {
-                    context->add (texture);
+                if (!texture) return false;
 
-                    atlas.reset (new Atlas(texture));
+                context->add (texture);
 
-                    return true;
-                }
+                atlas.reset (new Atlas(texture));
             }
+
+            if (!xml.skip_element ()) return false;
         }
 
-        return false;
+        return atlas && xml.get_token () == Xml_Scanner::END_TAG;
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    bool Raster_Font::parse_info (rapidxml::xml_node<> * info_tag)
+    bool Raster_Font::parse_info (Xml_Scanner & xml)
     {
-        xml_attribute<> * face_attribute = info_tag->first_attribute ("face");
+        Xml_Scanner::Text attribute, value;
+        bool              found = false;
 
-        if (face_attribute)
+        while (xml.next_attribute (attribute, value))
         {
-            name = face_attribute->value ();
-
-            return true;
+            if (attribute == "face")
+            {
+                name.assign (value.begin, value.end);
+                found = true;
+            }
         }
 
-        return false;
+        return found && xml.skip_element ();
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    bool Raster_Font::parse_common (rapidxml::xml_node<> * common_tag)
+    bool Raster_Font::parse_common (Xml_Scanner & xml)
     {
-        xml_attribute<> *  pages_attribute = common_tag->first_attribute ("pages");
-        xml_attribute<> * height_attribute = common_tag->first_attribute ("lineHeight");
-        xml_attribute<> *   base_attribute = common_tag->first_attribute ("base");
+        Xml_Scanner::Text attribute, value;
+        int               pages = 1, line_height = 0, base = 0;
+        bool              has_line_height = false;
+        bool              has_base        = false;
 
-        if (pages_attribute)
+        while (xml.next_attribute (attribute, value))
         {
-            if (std::atoi (pages_attribute->value ()) != 1) return false;
+            if (attribute == "pages"     ) value.to_int (pages);                          else
+            if (attribute == "lineHeight") has_line_height = value.to_int (line_height); else
+            if (attribute == "base"      ) has_base        = value.to_int (base);
         }
 
-        if (height_attribute)
-        {
-            metrics.line_height = std::atoi (height_attribute->value ());
+        if (pages != 1 || !has_line_height || !has_base) return false;
 
-            if (base_attribute)
-            {
-                metrics.base_height = metrics.line_height - std::atoi (base_attribute->value ());
-
-                return metrics.line_height > 0 && metrics.base_height < metrics.line_height;
-            }
-        }
+        metrics.line_height = line_height;
+        metrics.base_height = line_height - base;
 
-        return false;
+        return metrics.line_height > 0 && metrics.base_height < metrics.line_height && xml.skip_element ();
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    bool Raster_Font::parse_chars (rapidxml::xml_node<> * chars_tag)
+    bool Raster_Font::parse_chars (Xml_Scanner & xml)
     {
-        xml_attribute<> * count_attribute = chars_tag->first_attribute ("count");
+        Xml_Scanner::Text attribute, value;
+        int               count = 0;
+        int               total = 0;
 
-        int count = count_attribute ? std::atoi (count_attribute->value ()) : 0;
-        int total = 0;
+        while (xml.next_attribute (attribute, value))
+        {
+            if (attribute == "count") value.to_int (count);
+        }
 
-        for
-        (
-            xml_node<> * char_tag = chars_tag->first_node ("char");
-            char_tag;
-            char_tag = char_tag->next_sibling ("char")
-        )
+        if (!xml.is_empty_element ())
         {
-            if (!parse_char (char_tag)) return false;
+            while (xml.next () == Xml_Scanner::START_TAG)
+            {
+                if (xml.get_name () == "char")
+                {
+                    if (!parse_char (xml)) return false;
 
-            total++;
+                    total++;
+                }
+                else
+                if (!xml.skip_element ()) return false;
+            }
+
+            if (xml.get_token () != Xml_Scanner::END_TAG) return false;
+        }
+
+        // Los punteros a los slices se obtienen al final, ya que añadir un slice puede mover los
+        // anteriores:
+
+        for (auto & item : character_map)
+        {
+            item.second.slice = atlas->get_slice (item.first);
         }
 
         return total > 0 && (total == count || count == 0);
@@ -220,48 +248,33 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    bool Raster_Font::parse_char (rapidxml::xml_node<> * char_tag)
+    bool Raster_Font::parse_char (Xml_Scanner & xml)
     {
-        xml_attribute<> *       id_attribute = char_tag->first_attribute ("id"      );
-        xml_attribute<> *        x_attribute = char_tag->first_attribute ("x"       );
-        xml_attribute<> *        y_attribute = char_tag->first_attribute ("y"       );
-        xml_attribute<> *    width_attribute = char_tag->first_attribute ("width"   );
-        xml_attribute<> *   height_attribute = char_tag->first_attribute ("height"  );
-        xml_attribute<> * x_offset_attribute = char_tag->first_attribute ("xoffset" );
-        xml_attribute<> * y_offset_attribute = char_tag->first_attribute ("yoffset" );
-        xml_attribute<> *  advance_attribute = char_tag->first_attribute ("xadvance");
-
-        if
-        (
-                   id_attribute &&
-                    x_attribute &&
-                    y_attribute &&
-                width_attribute &&
-               height_attribute &&
-             x_offset_attribute &&
-             y_offset_attribute &&
-              advance_attribute
-        )
+        Xml_Scanner::Text attribute, value;
+        int               id = 0, x = 0, y = 0, width = 0, height = 0, x_offset = 0, y_offset = 0, advance = 0;
+        unsigned          found = 0;
+
+        while (xml.next_attribute (attribute, value))
         {
-            int id       = std::atoi (      id_attribute->value ());
-            int x        = std::atoi (       x_attribute->value ());
-            int y        = std::atoi (       y_attribute->value ());
-            int width    = std::atoi (   width_attribute->value ());
-            int height   = std::atoi (  height_attribute->value ());
-            int x_offset = std::atoi (x_offset_attribute->value ());
-            int y_offset = std::atoi (y_offset_attribute->value ());
-            int advance  = std::atoi ( advance_attribute->value ());
-
-            if (width > 0 && height > 0 && character_map.count (uint32_t(id)) == 0)
-            {
-                Character & character = character_map[uint32_t(id)];
+            if (attribute == "id"      ) found |= value.to_int (id      ) ? 0x01 : 0; else
+            if (attribute == "x"       ) found |= value.to_int (x       ) ? 0x02 : 0; else
+            if (attribute == "y"       ) found |= value.to_int (y       ) ? 0x04 : 0; else
+            if (attribute == "width"   ) found |= value.to_int (width   ) ? 0x08 : 0; else
+            if (attribute == "height"  ) found |= value.to_int (height  ) ? 0x10 : 0; else
+            if (attribute == "xoffset" ) found |= value.to_int (x_offset) ? 0x20 : 0; else
+            if (attribute == "yoffset" ) found |= value.to_int (y_offset) ? 0x40 : 0; else
+            if (attribute == "xadvance") found |= value.to_int (advance ) ? 0x80 : 0;
+        }
+
+        if (found == 0xFF && width > 0 && height > 0 && character_map.count (uint32_t(id)) == 0)
+        {
+            Character & character = character_map[uint32_t(id)];
 
-                character.slice   = atlas->add_slice (Id(id), { float(x), float(y) }, { float(width), float(height) });
-                character.offset  = Vector2f{ float(x_offset), float(y_offset) };
-                character.advance = float(advance);
+            character.slice   = atlas->add_slice (Id(id), { float(x), float(y) }, { float(width), float(height) });
+            character.offset  = Vector2f{ float(x_offset), float(y_offset) };
+            character.advance = float(advance);
 
-                return true;
-            };
+            return xml.skip_element ();
         }
 
         return false;
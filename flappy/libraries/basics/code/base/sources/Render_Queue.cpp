@@ -0,0 +1,471 @@
+/*
+ * RENDER QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803021030
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <basics/Render_Queue>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Layout of the sort keys (the lowest bits are left at zero, so the radix sort skips them):
+        //
+        //     63..56  layer
+        //         55  translucent (the rest of the key is zero when it's set)
+        //     54..53  blending
+        //         52  textured
+        //     51..20  hash of the texture
+
+        inline uint64_t make_key (unsigned layer, bool translucent, unsigned blending, bool textured, const void * texture)
+        {
+            uint64_t key = uint64_t(std::min (layer, 255u)) << 56;
+
+            if (translucent) return key | uint64_t(1) << 55;
+
+            // The texture pointers are mixed so that neighbour allocations don't only differ in
+            // the low bits:
+
+            uint32_t texture_hash = uint32_t((uint64_t(uintptr_t(texture)) * 0x9E3779B97F4A7C15u) >> 32);
+
+            return key | uint64_t(blending & 3) << 53 | uint64_t(textured) << 52 | uint64_t(texture_hash) << 20;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Render_Queue::Render_Queue()
+    {
+        current.transform = 0;
+        current.color[0]  = 1.f;
+        current.color[1]  = 1.f;
+        current.color[2]  = 1.f;
+        current.opacity   = 1.f;
+        current.blending  = TRANSPARENCY;
+        state_changed     = true;
+        transform_changed = true;
+        layer             = 0;
+        sorted            = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::discard ()
+    {
+        commands  .clear ();
+        states    .clear ();
+        transforms.clear ();
+        entries   .clear ();
+
+        state_changed     = true;
+        transform_changed = true;
+        sorted            = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::copy_state (const Render_Queue & other)
+    {
+        current           = other.current;
+        current_transform = other.current_transform;
+        layer             = other.layer;
+        state_changed     = true;
+        transform_changed = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // The commands between two barriers are sorted separately, so that nothing crosses a barrier:
+
+    void Render_Queue::sort ()
+    {
+        if (sorted) return;
+
+        Entry * begin = entries.data ();
+        Entry * end   = begin + entries.size ();
+
+        while (begin < end)
+        {
+            Entry * range_end = begin;
+
+            while (range_end < end && commands[range_end->index].type > CLEAR) ++range_end;
+
+            if (range_end - begin > 1) sort_range (begin, range_end);
+
+            begin = range_end + 1;
+        }
+
+        sorted = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // Stable LSD radix sort with 8 bit digits. All the histograms are built in a single pass and the
+    // digits that are the same for every key (most of them, usually) are skipped:
+
+    void Render_Queue::sort_range (Entry * begin, Entry * end)
+    {
+        size_t count = size_t(end - begin);
+
+        if (sorting_buffer.size () < count) sorting_buffer.resize (count);
+
+        uint32_t histograms[8][256];
+
+        std::memset (histograms, 0, sizeof(histograms));
+
+        for (Entry * entry = begin; entry < end; ++entry)
+        {
+            for (unsigned digit = 0; digit < 8; ++digit)
+            {
+                histograms[digit][(entry->key >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        Entry * source = begin;
+        Entry * target = sorting_buffer.data ();
+
+        for (unsigned digit = 0; digit < 8; ++digit)
+        {
+            uint32_t * histogram = histograms[digit];
+
+            if (histogram[(begin->key >> (digit * 8)) & 0xFF] == count) continue;
+
+            uint32_t offset = 0;
+
+            for (unsigned bucket = 0; bucket < 256; ++bucket)
+            {
+                uint32_t bucket_size = histogram[bucket];
+                histogram[bucket]    = offset;
+                offset              += bucket_size;
+            }
+
+            for (Entry * entry = source, * source_end = source + count; entry < source_end; ++entry)
+            {
+                target[histogram[(entry->key >> (digit * 8)) & 0xFF]++] = *entry;
+            }
+
+            std::swap (source, target);
+        }
+
+        if (source != begin) std::copy (source, source + count, begin);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::replay (Canvas & canvas)
+    {
+        sort ();
+
+        // The state of the canvas isn't known until the first drawing sets it:
+
+        const State * applied = nullptr;
+
+        for (const Entry & entry : entries)
+        {
+            const Command & command = commands[entry.index];
+            const Point2f * points  = command.points;
+
+            if (command.type > CLEAR)
+            {
+                const State & state = states[command.state];
+
+                if (&state != applied)
+                {
+                    if (!applied || state.transform != applied->transform)
+                    {
+                        canvas.set_transform (transforms[state.transform]);
+                    }
+
+                    if (!applied || !std::equal (state.color, state.color + 3, applied->color))
+                    {
+                        canvas.set_color (state.color[0], state.color[1], state.color[2]);
+                    }
+
+                    if (!applied || state.opacity  != applied->opacity ) canvas.set_opacity  (state.opacity );
+                    if (!applied || state.blending != applied->blending) canvas.set_blending (state.blending);
+
+                    applied = &state;
+                }
+            }
+
+            switch (command.type)
+            {
+                case RESET_STATE:             canvas.reset_state     (); applied = nullptr; break;
+                case SET_SIZE:                canvas.set_size        ({ unsigned(command.size.width), unsigned(command.size.height) }); break;
+                case SET_CLEAR_COLOR:         canvas.set_clear_color (states[command.state].color[0], states[command.state].color[1], states[command.state].color[2]); break;
+                case CLEAR:                   canvas.clear           (); break;
+                case DRAW_POINT:              canvas.draw_point      (points[0]); break;
+                case DRAW_SEGMENT:            canvas.draw_segment    (points[0], points[1]); break;
+                case DRAW_TRIANGLE:           canvas.draw_triangle   (points[0], points[1], points[2]); break;
+                case FILL_TRIANGLE:           canvas.fill_triangle   (points[0], points[1], points[2]); break;
+                case DRAW_RECTANGLE:          canvas.draw_rectangle  (points[0], command.size); break;
+                case FILL_RECTANGLE:          canvas.fill_rectangle  (points[0], command.size); break;
+                case FILL_TEXTURED_RECTANGLE: canvas.fill_rectangle  (points[0], command.size, static_cast< const Texture_2D   * >(command.image), command.handling); break;
+                case FILL_SLICED_RECTANGLE:   canvas.fill_rectangle  (points[0], command.size, static_cast< const Atlas::Slice * >(command.image), command.handling); break;
+            }
+        }
+
+        // The canvas is left in the state that it would have if the drawing had been immediate:
+
+        canvas.set_transform (current_transform);
+        canvas.set_color     (current.color[0], current.color[1], current.color[2]);
+        canvas.set_opacity   (current.opacity );
+        canvas.set_blending  (current.blending);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::reset_state ()
+    {
+        add_barrier (RESET_STATE);
+
+        current.color[0]  = 1.f;
+        current.color[1]  = 1.f;
+        current.color[2]  = 1.f;
+        current.opacity   = 1.f;
+        current.blending  = TRANSPARENCY;
+        current_transform = Transformation2f();
+        state_changed     = true;
+        transform_changed = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::set_size (const Size2u & size)
+    {
+        add_barrier (SET_SIZE).size = { float(size.width), float(size.height) };
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::set_layer (unsigned new_layer)
+    {
+        layer = new_layer;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::set_clear_color (float r, float g, float b)
+    {
+        State clear_state = current;
+
+        clear_state.color[0] = r;
+        clear_state.color[1] = g;
+        clear_state.color[2] = b;
+
+        add_barrier (SET_CLEAR_COLOR).state = unsigned(states.size ());
+
+        states.push_back (clear_state);
+
+        state_changed = true;                   // The last state isn't the current one anymore
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::set_color (float r, float g, float b)
+    {
+        if (r != current.color[0] || g != current.color[1] || b != current.color[2])
+        {
+            current.color[0] = r;
+            current.color[1] = g;
+            current.color[2] = b;
+            state_changed    = true;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::set_opacity (float opacity)
+    {
+        if (opacity != current.opacity)
+        {
+            current.opacity = opacity;
+            state_changed   = true;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::set_blending (Blending blending)
+    {
+        if (blending != current.blending)
+        {
+            current.blending = blending;
+            state_changed    = true;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::set_transform (const Transformation2f & transform)
+    {
+        if (transform.matrix != current_transform.matrix)
+        {
+            current_transform = transform;
+            transform_changed = true;
+            state_changed     = true;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::apply_transform (const Transformation2f & transform)
+    {
+        set_transform (transform * current_transform);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::clear ()
+    {
+        add_barrier (CLEAR);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::draw_point (const Point2f & position)
+    {
+        add_drawing (DRAW_POINT, false, nullptr).points[0] = position;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        Command & command = add_drawing (DRAW_SEGMENT, false, nullptr);
+
+        command.points[0] = a;
+        command.points[1] = b;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        Command & command = add_drawing (DRAW_TRIANGLE, false, nullptr);
+
+        command.points[0] = a;
+        command.points[1] = b;
+        command.points[2] = c;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        Command & command = add_drawing (FILL_TRIANGLE, false, nullptr);
+
+        command.points[0] = a;
+        command.points[1] = b;
+        command.points[2] = c;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Command & command = add_drawing (DRAW_RECTANGLE, false, nullptr);
+
+        command.points[0] = bottom_left;
+        command.size      = size;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Command & command = add_drawing (FILL_RECTANGLE, false, nullptr);
+
+        command.points[0] = bottom_left;
+        command.size      = size;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::fill_rectangle (const Point2f & where, const Size2f & size, const Texture_2D * texture, int handling)
+    {
+        Command & command = add_drawing (FILL_TEXTURED_RECTANGLE, true, texture);
+
+        command.points[0] = where;
+        command.size      = size;
+        command.image     = texture;
+        command.handling  = handling;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // The slices of the same atlas share the texture, so they get the same key:
+
+    void Render_Queue::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        Command & command = add_drawing (FILL_SLICED_RECTANGLE, true, slice ? slice->atlas->get_texture ().get () : nullptr);
+
+        command.points[0] = where;
+        command.size      = size;
+        command.image     = slice;
+        command.handling  = handling;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Render_Queue::Command & Render_Queue::add_barrier (Type type)
+    {
+        entries .push_back ({ 0, uint32_t(commands.size ()) });
+        commands.emplace_back ();
+
+        Command & command = commands.back ();
+
+        command.type  = type;
+        command.state = 0;
+        command.image = nullptr;
+
+        return command;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // A drawing only adds a new state (and transform) when something has changed since the last one:
+
+    Render_Queue::Command & Render_Queue::add_drawing (Type type, bool textured, const void * texture)
+    {
+        if (state_changed)
+        {
+            if (transform_changed)
+            {
+                current.transform = unsigned(transforms.size ());
+
+                transforms.push_back (current_transform);
+
+                transform_changed = false;
+            }
+
+            states.push_back (current);
+
+            state_changed = false;
+        }
+
+        uint64_t key = make_key (layer, current.blending != NONE, current.blending, textured, texture);
+
+        entries .push_back ({ key, uint32_t(commands.size ()) });
+        commands.emplace_back ();
+
+        Command & command = commands.back ();
+
+        command.type  = type;
+        command.state = unsigned(states.size () - 1);
+        command.image = nullptr;
+
+        sorted = false;
+
+        return command;
+    }
+
+}
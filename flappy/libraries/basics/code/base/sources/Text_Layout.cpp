@@ -10,6 +10,7 @@
  * C1802030140
  */
 
+#include <cwchar>
 #include <basics/Text_Layout>
 
 namespace basics
@@ -19,17 +20,37 @@ namespace basics
     :
         width (0.f),
         height(0.f)
+    {
+        layout (font, text.c_str (), text.length ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Text_Layout::Text_Layout(const Raster_Font & font, const wchar_t * text, Frame_Arena & arena)
+    :
+        glyphs(Frame_Allocator< Glyph >(arena)),
+        width (0.f),
+        height(0.f)
+    {
+        layout (font, text, std::wcslen (text));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Text_Layout::layout (const Raster_Font & font, const wchar_t * text, size_t length)
     {
         Raster_Font::Metrics metrics = font.get_metrics ();
 
-        glyphs.reserve (text.length ());
+        glyphs.reserve (length);
 
         float current_x  = 0;
         float current_y  = -metrics.line_height;
         float line_width = 0;
 
-        for (auto & c : text)
+        for (const wchar_t * end = text + length; text < end; ++text)
         {
+            wchar_t c = *text;
+
             if (c == L'\n')
             {
                 if (current_x > width) width = current_x;
@@ -11,6 +11,7 @@
  */
 
 #include <basics/png_decode>
+#include <basics/Profiler>
 #include <basics/Texture_2D>
 
 namespace basics
@@ -18,7 +19,10 @@ namespace basics
 
     Id                  Texture_2D::texture_2d_specialization_ids      [10];
     Texture_2D::Factory Texture_2D::texture_2d_specialization_factories[10];
+    Texture_2D::Container_Factory
+                        Texture_2D::texture_2d_container_factories     [10];
     size_t              Texture_2D::texture_2d_specialization_count;
+    std::atomic<size_t> Texture_2D::total_resident_bytes(0);
 
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
@@ -35,27 +39,107 @@ namespace basics
         return std::shared_ptr< Texture_2D >();
     }
 
-    std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
+    std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const Texture_Container & container, const Options & options)
     {
-        std::shared_ptr< Asset > asset = Asset::open (asset_path);
+        Id context_id = context->get_id ();
 
-        if (asset)
+        for (unsigned index = 0; index < texture_2d_specialization_count; ++index)
         {
-            std::vector< byte >  data;
-
-            if (asset->read_all (data))
+            if (texture_2d_specialization_ids[index] == context_id)
             {
+                Texture_2D::Options texture_options = options;
+
+                texture_options.width  = container.get_width  ();
+                texture_options.height = container.get_height ();
+
+                if (texture_2d_container_factories[index])
+                {
+                    return texture_2d_container_factories[index] (id, container, texture_options);
+                }
+
+                // Los contextos que no admiten contenedores reciben los píxeles expandidos a RGBA8888:
+
                 Color_Buffer< Rgba8888 > color_buffer;
-                Texture_2D::Options      options;
 
-                if (png_decode (data, color_buffer, options.width, options.height))
+                if (container.expand (color_buffer))
                 {
-                    return Texture_2D::create (id, context, color_buffer, options);
+                    return texture_2d_specialization_factories[index] (id, color_buffer, texture_options);
                 }
+
+                break;
             }
         }
 
         return std::shared_ptr< Texture_2D >();
     }
 
+    std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
+    {
+        BASICS_PROFILE_ZONE ("load-texture");
+
+        Texture_Container container = find_container (asset_path);
+
+        if (container.good ())
+        {
+            Texture_2D::Options texture_options = options;
+
+            texture_options.asset_path = Texture_Container::is_container_path (asset_path) ? asset_path : Texture_Container::get_path_for (asset_path);
+
+            return Texture_2D::create (id, context, container, texture_options);
+        }
+
+        Color_Buffer< Rgba8888 > color_buffer;
+        Texture_2D::Options      texture_options = options;
+
+        if (decode (asset_path, color_buffer, texture_options))
+        {
+            return Texture_2D::create (id, context, color_buffer, texture_options);
+        }
+
+        return std::shared_ptr< Texture_2D >();
+    }
+
+    bool Texture_2D::decode (const std::string & asset_path, Color_Buffer< Rgba8888 > & color_buffer, Options & options)
+    {
+        BASICS_PROFILE_ZONE ("decode-texture");
+
+        // Se decodifica directamente desde el asset mapeado en memoria, sin copiarlo antes:
+
+        Asset::View data = Asset::map (asset_path);
+
+        if (decode (data, color_buffer, options))
+        {
+            options.asset_path = asset_path;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool Texture_2D::decode (const Asset::View & asset_data, Color_Buffer< Rgba8888 > & color_buffer, Options & options)
+    {
+        Texture_Container container(asset_data);
+
+        if (container.good ())
+        {
+            options.width  = container.get_width  ();
+            options.height = container.get_height ();
+
+            return container.expand (color_buffer);
+        }
+
+        return asset_data && png_decode (asset_data.data (), asset_data.size (), color_buffer, options.width, options.height);
+    }
+
+    Texture_Container Texture_2D::find_container (const std::string & asset_path)
+    {
+        if (Texture_Container::is_container_path (asset_path))
+        {
+            return Texture_Container(Asset::map (asset_path));
+        }
+
+        return Texture_Container(Asset::map (Texture_Container::get_path_for (asset_path)));
+    }
+
 }
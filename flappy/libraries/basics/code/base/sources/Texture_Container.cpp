@@ -0,0 +1,319 @@
+/*
+ * TEXTURE CONTAINER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802201045
+ */
+
+#include <cstring>
+#include <basics/Texture_Container>
+#include <basics/pixel_conversion>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const char   magic    [] = { 'B', 'T', 'E', 'X' };
+        const char   extension[] = ".btex";
+
+        uint32_t read_uint16 (const byte * bytes)
+        {
+            return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8;
+        }
+
+        uint32_t read_uint32 (const byte * bytes)
+        {
+            return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+        }
+
+        void write_uint16 (byte * bytes, uint32_t value)
+        {
+            bytes[0] = byte(value     );
+            bytes[1] = byte(value >> 8);
+        }
+
+        void write_uint32 (byte * bytes, uint32_t value)
+        {
+            bytes[0] = byte(value      );
+            bytes[1] = byte(value >>  8);
+            bytes[2] = byte(value >> 16);
+            bytes[3] = byte(value >> 24);
+        }
+
+        // The 16 bit formats are converted by the kernels of pixel_conversion and then written
+        // in little endian order:
+
+        void convert (const Color_Buffer< Rgba8888 > & color_buffer, Texture_Container::Format format, bool dither, byte * output)
+        {
+            if (format == Texture_Container::RGBA8888)
+            {
+                std::memcpy (output, color_buffer.buffer.data (), color_buffer.size () * sizeof(Rgba8888));
+                return;
+            }
+
+            Color_Buffer< uint16_t > converted;
+
+            switch (format)
+            {
+                case Texture_Container::RGB565:   convert_to_rgb565   (color_buffer, converted, dither); break;
+                case Texture_Container::RGBA4444: convert_to_rgba4444 (color_buffer, converted, dither); break;
+                case Texture_Container::RGBA5551: convert_to_rgba5551 (color_buffer, converted, dither); break;
+                default: return;
+            }
+
+            for (uint16_t texel : converted.buffer)
+            {
+                write_uint16 (output, texel);
+                output += 2;
+            }
+        }
+
+        // Each texel of the next level averages a 2x2 block (or 2x1 / 1x2 when a side is 1):
+
+        Color_Buffer< Rgba8888 > reduce (const Color_Buffer< Rgba8888 > & source)
+        {
+            unsigned width  = source.get_width  () > 1 ? source.get_width  () / 2 : 1;
+            unsigned height = source.get_height () > 1 ? source.get_height () / 2 : 1;
+
+            Color_Buffer< Rgba8888 > target(width, height);
+
+            const byte * source_bytes = reinterpret_cast< const byte * >(source.buffer.data ());
+                  byte * target_bytes = target;
+
+            unsigned x_step = source.get_width  () > 1 ? 1 : 0;
+            unsigned y_step = source.get_height () > 1 ? 1 : 0;
+
+            for (unsigned y = 0; y < height; ++y)
+            {
+                for (unsigned x = 0; x < width; ++x)
+                {
+                    const byte * top    = source_bytes + ((y * 2         ) * source.get_width () + x * 2) * 4;
+                    const byte * bottom = source_bytes + ((y * 2 + y_step) * source.get_width () + x * 2) * 4;
+
+                    for (unsigned component = 0; component < 4; ++component)
+                    {
+                        unsigned sum = top   [component] + top   [component + x_step * 4]
+                                     + bottom[component] + bottom[component + x_step * 4];
+
+                        *target_bytes++ = byte((sum + 2) / 4);
+                    }
+                }
+            }
+
+            return target;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::string Texture_Container::get_path_for (const std::string & asset_path)
+    {
+        size_t slash = asset_path.find_last_of ('/');
+        size_t dot   = asset_path.find_last_of ('.');
+
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        {
+            return asset_path + extension;
+        }
+
+        return asset_path.substr (0, dot) + extension;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Texture_Container::is_container_path (const std::string & asset_path)
+    {
+        size_t length = sizeof(extension) - 1;
+
+        return asset_path.size () > length && asset_path.compare (asset_path.size () - length, length, extension) == 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Texture_Container::Texture_Container(const Asset::View & data)
+    :
+        data  (data   ),
+        format(UNKNOWN),
+        width (0      ),
+        height(0      )
+    {
+        const byte * bytes = data.data ();
+        size_t       size  = data.size ();
+
+        if (!data || size < header_size || std::memcmp (bytes, magic, sizeof(magic)) != 0) return;
+        if (read_uint16 (bytes + 4) != version) return;
+
+        Format   format      = Format(read_uint16 (bytes + 6));
+        unsigned width       = read_uint32 (bytes +  8);
+        unsigned height      = read_uint32 (bytes + 12);
+        unsigned level_count = read_uint32 (bytes + 16);
+        size_t   pixel_size  = get_bytes_per_pixel (format);
+
+        if (pixel_size == 0 || width == 0 || height == 0) return;
+        if (level_count == 0 || level_count > max_levels || header_size + level_count * 8 > size) return;
+
+        std::vector< Level > levels(level_count);
+
+        unsigned level_width  = width;
+        unsigned level_height = height;
+
+        for (unsigned index = 0; index < level_count; ++index)
+        {
+            size_t offset = read_uint32 (bytes + header_size + index * 8    );
+            size_t length = read_uint32 (bytes + header_size + index * 8 + 4);
+
+            if (length != size_t(level_width) * level_height * pixel_size || offset > size || length > size - offset)
+            {
+                return;
+            }
+
+            levels[index] = { level_width, level_height, bytes + offset, length };
+
+            if (level_width  > 1) level_width  /= 2;
+            if (level_height > 1) level_height /= 2;
+        }
+
+        this->format = format;
+        this->width  = width;
+        this->height = height;
+        this->levels.swap (levels);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Texture_Container::expand (Color_Buffer< Rgba8888 > & color_buffer) const
+    {
+        if (!good ()) return false;
+
+        const Level & level  = levels[0];
+        const byte  * source = level.pixels;
+
+        color_buffer.resize (level.width, level.height);
+
+        byte * target = color_buffer;
+
+        for (size_t index = 0, count = size_t(level.width) * level.height; index < count; ++index, target += 4)
+        {
+            switch (format)
+            {
+                case RGBA8888:
+                {
+                    std::memcpy (target, source, 4);
+                    source += 4;
+                    break;
+                }
+
+                case RGB565:
+                {
+                    uint32_t texel = read_uint16 (source);
+
+                    target[0] = byte(((texel >> 11       ) * 255 + 15) / 31);
+                    target[1] = byte(((texel >>  5 & 0x3F) * 255 + 31) / 63);
+                    target[2] = byte(((texel       & 0x1F) * 255 + 15) / 31);
+                    target[3] = 255;
+                    source   += 2;
+                    break;
+                }
+
+                case RGBA4444:
+                {
+                    uint32_t texel = read_uint16 (source);
+
+                    target[0] = byte((texel >> 12      ) * 17);
+                    target[1] = byte((texel >>  8 & 0xF) * 17);
+                    target[2] = byte((texel >>  4 & 0xF) * 17);
+                    target[3] = byte((texel       & 0xF) * 17);
+                    source   += 2;
+                    break;
+                }
+
+                case RGBA5551:
+                {
+                    uint32_t texel = read_uint16 (source);
+
+                    target[0] = byte(((texel >> 11       ) * 255 + 15) / 31);
+                    target[1] = byte(((texel >>  6 & 0x1F) * 255 + 15) / 31);
+                    target[2] = byte(((texel >>  1 & 0x1F) * 255 + 15) / 31);
+                    target[3] = byte( (texel       & 0x01) * 255);
+                    source   += 2;
+                    break;
+                }
+
+                default: return false;
+            }
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Texture_Container::encode
+    (
+        const Color_Buffer< Rgba8888 > & color_buffer,
+        Format                           format,
+        bool                             mipmaps,
+        bool                             dither,
+        std::vector< byte >            & container
+    )
+    {
+        size_t pixel_size = get_bytes_per_pixel (format);
+
+        if (pixel_size == 0 || color_buffer.size () == 0) return false;
+
+        // The levels are generated first to know the size of the level table:
+
+        std::vector< Color_Buffer< Rgba8888 > > reduced_levels;
+
+        if (mipmaps)
+        {
+            const Color_Buffer< Rgba8888 > * previous = &color_buffer;
+
+            while ((previous->get_width () > 1 || previous->get_height () > 1) && reduced_levels.size () + 1 < max_levels)
+            {
+                reduced_levels.push_back (reduce (*previous));
+
+                previous = &reduced_levels.back ();
+            }
+        }
+
+        unsigned level_count = unsigned(reduced_levels.size ()) + 1;
+        size_t   offset      = header_size + level_count * 8;
+
+        container.assign (offset, 0);
+
+        std::memcpy  (container.data (), magic, sizeof(magic));
+        write_uint16 (container.data () +  4, version);
+        write_uint16 (container.data () +  6, format);
+        write_uint32 (container.data () +  8, color_buffer.get_width  ());
+        write_uint32 (container.data () + 12, color_buffer.get_height ());
+        write_uint32 (container.data () + 16, level_count);
+
+        for (unsigned index = 0; index < level_count; ++index)
+        {
+            const Color_Buffer< Rgba8888 > & level = index == 0 ? color_buffer : reduced_levels[index - 1];
+
+            size_t level_size = size_t(level.size ()) * pixel_size;
+
+            offset = (container.size () + 3) & ~size_t(3);
+
+            write_uint32 (container.data () + header_size + index * 8,     uint32_t(offset    ));
+            write_uint32 (container.data () + header_size + index * 8 + 4, uint32_t(level_size));
+
+            container.resize (offset + level_size);
+
+            convert (level, format, dither, container.data () + offset);
+        }
+
+        return true;
+    }
+
+}
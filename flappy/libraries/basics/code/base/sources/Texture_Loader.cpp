@@ -0,0 +1,142 @@
+/*
+ * TEXTURE LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802141130
+ */
+
+#include <basics/Profiler>
+#include <basics/Texture_Loader>
+#include <basics/Timer>
+
+namespace basics
+{
+
+    Texture_Loader::Texture_Loader(unsigned worker_count)
+    :
+        shared     (std::make_shared< Shared_State > ()),
+        requested  (0),
+        uploaded   (0),
+        failed     (0),
+        budget     ({ 0.004f, 4u << 20 }),
+        thread_pool(new Thread_Pool(worker_count))
+    {
+        shared->decoded_count = 0;
+        shared->cancelled     = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Texture_Loader::~Texture_Loader()
+    {
+        // The queued tasks will still run when the pool is destroyed, but they'll skip the decoding:
+
+        shared->cancelled = true;
+
+        thread_pool.reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Texture_Loader::load (Id id, const std::string & asset_path, const Texture_2D::Options & options, const Callback & callback)
+    {
+        std::shared_ptr< Shared_State > shared = this->shared;
+
+        requested++;
+
+        thread_pool->submit
+        (
+            [shared, id, asset_path, options, callback] ()
+            {
+                if (shared->cancelled) return;
+
+                Decoded_Texture texture{ id, false, {}, {}, options, callback };
+
+                texture.container = Texture_2D::find_container (asset_path);
+
+                if (texture.container.good ())
+                {
+                    texture.good               = true;
+                    texture.options.asset_path = Texture_Container::get_path_for (asset_path);
+                }
+                else
+                    texture.good = Texture_2D::decode (asset_path, texture.color_buffer, texture.options);
+
+                std::lock_guard< std::mutex > lock(shared->mutex);
+
+                shared->decoded.push_back (std::move (texture));
+                shared->decoded_count++;
+            }
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Texture_Loader::upload (Graphics_Context::Accessor & context)
+    {
+        BASICS_PROFILE_ZONE ("upload-textures");
+
+        Timer    timer;
+        size_t   bytes_sent = 0;
+        unsigned processed  = 0;
+
+        while (context)
+        {
+            Decoded_Texture decoded;
+
+            {
+                std::lock_guard< std::mutex > lock(shared->mutex);
+
+                if (shared->decoded.empty ()) break;
+
+                // Once something has been sent, a texture that would exceed the budget waits for
+                // the next frame:
+
+                const Decoded_Texture & next = shared->decoded.front ();
+
+                size_t texture_bytes = next.color_buffer.size () * sizeof(Rgba8888) + next.container.get_size ();
+
+                if (processed > 0 && bytes_sent + texture_bytes > budget.bytes) break;
+
+                decoded = std::move (shared->decoded.front ());
+
+                shared->decoded.pop_front ();
+
+                bytes_sent += texture_bytes;
+            }
+
+            Texture_Handle texture;
+
+            if (decoded.good)
+            {
+                texture = decoded.container.good ()
+                    ? Texture_2D::create (decoded.id, context, decoded.container,    decoded.options)
+                    : Texture_2D::create (decoded.id, context, decoded.color_buffer, decoded.options);
+            }
+
+            if (texture)
+            {
+                context->add (texture);
+
+                textures[decoded.id] = texture;
+            }
+            else
+                failed++;
+
+            uploaded++;
+            processed++;
+
+            if (decoded.callback) decoded.callback (decoded.id, texture);
+
+            if (timer.get_elapsed_seconds () >= budget.seconds) break;
+        }
+
+        return processed;
+    }
+
+}
@@ -0,0 +1,173 @@
+/*
+ * THREAD POOL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101132
+ */
+
+#include <algorithm>
+#include <memory>
+#include <basics/Profiler>
+#include <basics/Thread_Pool>
+
+namespace basics
+{
+
+    Thread_Pool::Thread_Pool(unsigned worker_count)
+    :
+        pending (0),
+        stopping(false)
+    {
+        if (worker_count == 0)
+        {
+            unsigned hardware_threads = std::thread::hardware_concurrency ();
+
+            worker_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+        }
+
+        workers.reserve (worker_count);
+
+        for (unsigned index = 0; index < worker_count; ++index)
+        {
+            workers.emplace_back (&Thread_Pool::run_worker, this);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Thread_Pool::~Thread_Pool()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            stopping = true;
+        }
+
+        task_available.notify_all ();
+
+        for (auto & worker : workers)
+        {
+            worker.join ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Thread_Pool::submit (const Task & task)
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            tasks.push_back (task);
+
+            pending++;
+        }
+
+        task_available.notify_one ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Thread_Pool::wait ()
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+
+        all_done.wait (lock, [this] { return pending == 0; });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Thread_Pool::parallel_for (unsigned count, const std::function< void (unsigned) > & function)
+    {
+        if (count == 0) return;
+
+        // The indices are handed out through a shared counter, so that fast threads take more of
+        // them. The state is shared with the helper tasks because some of them may only start once
+        // every index has been processed and this call has returned:
+
+        struct Shared_State
+        {
+            std::function< void (unsigned) > function;
+            unsigned                         count;
+            std::atomic< unsigned >          next;
+            std::atomic< unsigned >          finished;
+            std::mutex                       mutex;
+            std::condition_variable          condition;
+        };
+
+        auto state = std::make_shared< Shared_State > ();
+
+        state->function = function;
+        state->count    = count;
+        state->next     = 0;
+        state->finished = 0;
+
+        auto drain = [state] ()
+        {
+            unsigned index;
+
+            while ((index = state->next++) < state->count)
+            {
+                state->function (index);
+
+                if (++state->finished == state->count)
+                {
+                    std::lock_guard< std::mutex > lock(state->mutex);
+
+                    state->condition.notify_all ();
+                }
+            }
+        };
+
+        unsigned helpers = std::min (count - 1, get_worker_count ());
+
+        for (unsigned index = 0; index < helpers; ++index)
+        {
+            submit (drain);
+        }
+
+        drain ();
+
+        std::unique_lock< std::mutex > lock(state->mutex);
+
+        state->condition.wait (lock, [&] { return state->finished == count; });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Thread_Pool::run_worker ()
+    {
+        Profiler::set_thread_name ("worker");
+
+        for (;;)
+        {
+            Task task;
+
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                task_available.wait (lock, [this] { return stopping || !tasks.empty (); });
+
+                if (tasks.empty ()) return;
+
+                task = std::move (tasks.front ());
+
+                tasks.pop_front ();
+            }
+
+            task ();
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                if (--pending == 0) all_done.notify_all ();
+            }
+        }
+    }
+
+}
@@ -15,14 +15,23 @@
 namespace basics
 {
 
-    namespace var
+    const Var::Type::Info Var::Type::infos[type_count] =
     {
-
-        const Var::Type::Info  Void::info{  Void::id,  "Void", nullptr };
-        const Var::Type::Info  Bool::info{  Bool::id,  "Bool", nullptr };
-        const Var::Type::Info Int32::info{ Int32::id, "Int32", nullptr };
-        const Var::Type::Info Float::info{ Float::id, "Float", nullptr };
-
-    }
+        { var::Void  ::id, "Void"   },
+        { var::Bool  ::id, "Bool"   },
+        { var::Char  ::id, "Char"   },
+        { var::WChar ::id, "WChar"  },
+        { var::Int8  ::id, "Int8"   },
+        { var::Int16 ::id, "Int16"  },
+        { var::Int32 ::id, "Int32"  },
+        { var::Int64 ::id, "Int64"  },
+        { var::UInt8 ::id, "UInt8"  },
+        { var::UInt16::id, "UInt16" },
+        { var::UInt32::id, "UInt32" },
+        { var::UInt64::id, "UInt64" },
+        { var::Float ::id, "Float"  },
+        { var::Double::id, "Double" },
+        { var::String::id, "String" },
+    };
 
 }
@@ -0,0 +1,212 @@
+/*
+ * XML SCANNER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802251530
+ */
+
+#include <basics/Xml_Scanner>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        inline bool is_space (char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        inline const char * skip_spaces (const char * current, const char * end)
+        {
+            while (current < end && is_space (*current)) ++current;
+
+            return current;
+        }
+
+        // Returns the position that follows the given terminator, or nullptr if it isn't found:
+
+        template< size_t LENGTH >
+        const char * skip_past (const char * current, const char * end, const char (& terminator)[LENGTH])
+        {
+            const size_t length = LENGTH - 1;
+
+            for ( ; size_t(end - current) >= length; ++current)
+            {
+                if (std::memcmp (current, terminator, length) == 0) return current + length;
+            }
+
+            return nullptr;
+        }
+
+        template< size_t LENGTH >
+        bool starts_with (const char * current, const char * end, const char (& prefix)[LENGTH])
+        {
+            return size_t(end - current) >= LENGTH - 1 && std::memcmp (current, prefix, LENGTH - 1) == 0;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Xml_Scanner::Token Xml_Scanner::next ()
+    {
+        if (token == SYNTAX_ERROR) return token;
+
+        empty_element  = false;
+        attributes     = current;
+        attributes_end = current;
+
+        for (;;)
+        {
+            // The text up to the next tag is skipped:
+
+            current = static_cast< const char * >(std::memchr (current, '<', size_t(end - current)));
+
+            if (!current)
+            {
+                current = end;
+                return token = END_OF_DATA;
+            }
+
+            const char * skipped = nullptr;
+
+            if (starts_with (current, end, "<?"        )) skipped = skip_past (current, end, "?>" ); else
+            if (starts_with (current, end, "<!--"      )) skipped = skip_past (current, end, "-->"); else
+            if (starts_with (current, end, "<![CDATA[" )) skipped = skip_past (current, end, "]]>"); else
+            if (starts_with (current, end, "<!"        )) skipped = skip_past (current, end, ">"  ); else
+                break;
+
+            if (!skipped) return token = SYNTAX_ERROR;
+
+            current = skipped;
+        }
+
+        bool closing = ++current < end && *current == '/';
+
+        if (closing) ++current;
+
+        // The name ends at the first space, slash or closing bracket:
+
+        name.begin = current;
+
+        while (current < end && !is_space (*current) && *current != '/' && *current != '>') ++current;
+
+        name.end = current;
+
+        if (name.size () == 0 || current == end) return token = SYNTAX_ERROR;
+
+        // The attributes aren't read now, but the quoted values may contain '>' and must be skipped:
+
+        attributes = current;
+
+        for (char quote = 0; current < end; ++current)
+        {
+            if (quote)
+            {
+                if (*current == quote) quote = 0;
+            }
+            else
+            if (*current == '"' || *current == '\'')
+            {
+                quote = *current;
+            }
+            else
+            if (*current == '>')
+            {
+                break;
+            }
+        }
+
+        if (current == end) return token = SYNTAX_ERROR;
+
+        attributes_end = current++;
+
+        if (closing)
+        {
+            attributes = attributes_end;
+            return token = END_TAG;
+        }
+
+        if (attributes_end > attributes && attributes_end[-1] == '/')
+        {
+            empty_element = true;
+            attributes_end--;
+        }
+
+        return token = START_TAG;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Xml_Scanner::next_attribute (Text & name, Text & value)
+    {
+        const char * current = skip_spaces (attributes, attributes_end);
+
+        name.begin = current;
+
+        while (current < attributes_end && !is_space (*current) && *current != '=') ++current;
+
+        name.end = current;
+        current  = skip_spaces (current, attributes_end);
+
+        if (name.size () == 0 || current == attributes_end || *current != '=')
+        {
+            attributes = attributes_end;
+            return false;
+        }
+
+        current = skip_spaces (current + 1, attributes_end);
+
+        if (current == attributes_end || (*current != '"' && *current != '\''))
+        {
+            attributes = attributes_end;
+            return false;
+        }
+
+        char quote = *current++;
+
+        value.begin = current;
+
+        while (current < attributes_end && *current != quote) ++current;
+
+        if (current == attributes_end)
+        {
+            attributes = attributes_end;
+            return false;
+        }
+
+        value.end  = current;
+        attributes = current + 1;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Xml_Scanner::skip_element ()
+    {
+        if (token != START_TAG) return false;
+
+        if (empty_element) return true;
+
+        for (unsigned depth = 1; depth > 0; )
+        {
+            switch (next ())
+            {
+                case START_TAG: if (!empty_element) depth++; break;
+                case END_TAG:   depth--;                     break;
+                default:        return false;
+            }
+        }
+
+        return true;
+    }
+
+}
@@ -0,0 +1,773 @@
+/*
+ * PIXEL CONVERSION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231030
+ */
+
+#include <atomic>
+#include <cstring>
+#include <basics/pixel_conversion>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define BASICS_PIXEL_CONVERSION_NEON
+    #include <arm_neon.h>
+#elif defined(__SSE2__)
+    #define BASICS_PIXEL_CONVERSION_SSE2
+    #include <emmintrin.h>
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define BASICS_PIXEL_CONVERSION_AVX2
+        #define BASICS_AVX2 __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+#endif
+
+namespace basics
+{
+
+    namespace
+    {
+
+        enum Packing
+        {
+            PACK_565,
+            PACK_4444,
+            PACK_5551,
+        };
+
+        // Every kernel works on a run of pixels. The dither pattern of a row has 4 pixels (R, G, B
+        // and A offsets for each one) and the runs always start at a multiple of 4:
+
+        typedef void (* Pack_Kernel   ) (const byte * rgba, uint16_t * target, size_t count, const byte * dither);
+        typedef void (* Pixel_Kernel  ) (byte * rgba, size_t count);
+
+        struct Kernels
+        {
+            const char   * name;
+            Pack_Kernel    pack[3];
+            Pixel_Kernel   premultiply;
+            Pixel_Kernel   swizzle[3];
+        };
+
+        const unsigned bayer_matrix[4][4] =
+        {
+            {  0,  8,  2, 10 },
+            { 12,  4, 14,  6 },
+            {  3, 11,  1,  9 },
+            { 15,  7, 13,  5 },
+        };
+
+        // Bits of the R, G, B and A components of each packing:
+
+        const unsigned packing_bits[3][4] =
+        {
+            { 5, 6, 5, 0 },
+            { 4, 4, 4, 4 },
+            { 5, 5, 5, 1 },
+        };
+
+        // -----------------------------------------------------------------------------------------
+        // Scalar kernels
+        // -----------------------------------------------------------------------------------------
+
+        inline unsigned saturated_add (unsigned value, unsigned offset)
+        {
+            value += offset;
+            return value > 255 ? 255 : value;
+        }
+
+        template< Packing PACKING >
+        inline uint16_t pack (unsigned r, unsigned g, unsigned b, unsigned a)
+        {
+            switch (PACKING)
+            {
+                case PACK_565:  return uint16_t((r >> 3) << 11 | (g >> 2) << 5 | (b >> 3)                    );
+                case PACK_4444: return uint16_t((r >> 4) << 12 | (g >> 4) << 8 | (b >> 4) << 4 | (a >> 4)   );
+                case PACK_5551: return uint16_t((r >> 3) << 11 | (g >> 3) << 6 | (b >> 3) << 1 | (a >> 7)   );
+            }
+
+            return 0;
+        }
+
+        template< Packing PACKING >
+        void pack_scalar (const byte * rgba, uint16_t * target, size_t count, const byte * dither)
+        {
+            for (size_t index = 0; index < count; ++index, rgba += 4)
+            {
+                const byte * offsets = dither + (index & 3) * 4;
+
+                target[index] = pack< PACKING >
+                (
+                    saturated_add (rgba[0], offsets[0]),
+                    saturated_add (rgba[1], offsets[1]),
+                    saturated_add (rgba[2], offsets[2]),
+                    saturated_add (rgba[3], offsets[3])
+                );
+            }
+        }
+
+        void premultiply_scalar (byte * rgba, size_t count)
+        {
+            for (size_t index = 0; index < count; ++index, rgba += 4)
+            {
+                unsigned alpha = rgba[3];
+
+                for (unsigned component = 0; component < 3; ++component)
+                {
+                    unsigned product = rgba[component] * alpha + 128;
+
+                    rgba[component] = byte((product + (product >> 8)) >> 8);
+                }
+            }
+        }
+
+        template< Channel_Order ORDER >
+        void swizzle_scalar (byte * rgba, size_t count)
+        {
+            for (size_t index = 0; index < count; ++index, rgba += 4)
+            {
+                byte r = rgba[0], g = rgba[1], b = rgba[2], a = rgba[3];
+
+                switch (ORDER)
+                {
+                    case BGRA: rgba[0] = b; rgba[1] = g; rgba[2] = r; rgba[3] = a; break;
+                    case ARGB: rgba[0] = a; rgba[1] = r; rgba[2] = g; rgba[3] = b; break;
+                    case ABGR: rgba[0] = a; rgba[1] = b; rgba[2] = g; rgba[3] = r; break;
+                }
+            }
+        }
+
+        const Kernels scalar_kernels =
+        {
+            "scalar",
+            { pack_scalar< PACK_565 >, pack_scalar< PACK_4444 >, pack_scalar< PACK_5551 > },
+            premultiply_scalar,
+            { swizzle_scalar< BGRA >, swizzle_scalar< ARGB >, swizzle_scalar< ABGR > },
+        };
+
+        // -----------------------------------------------------------------------------------------
+        // SSE2 kernels (4 pixels per register, little endian)
+        // -----------------------------------------------------------------------------------------
+
+        #if defined(BASICS_PIXEL_CONVERSION_SSE2)
+
+        // Each 32 bit lane holds a pixel as R | G << 8 | B << 16 | A << 24:
+
+        template< Packing PACKING >
+        inline __m128i pack_lanes_sse2 (__m128i pixels)
+        {
+            switch (PACKING)
+            {
+                case PACK_565: return _mm_or_si128
+                (
+                    _mm_or_si128
+                    (
+                        _mm_slli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0x0000F8)),  8),
+                        _mm_srli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0x00FC00)),  5)
+                    ),
+                        _mm_srli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0xF80000)), 19)
+                );
+
+                case PACK_4444: return _mm_or_si128
+                (
+                    _mm_or_si128
+                    (
+                        _mm_slli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0x0000F0)),  8),
+                        _mm_srli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0x00F000)),  4)
+                    ),
+                    _mm_or_si128
+                    (
+                        _mm_srli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0xF00000)), 16),
+                        _mm_srli_epi32 (pixels, 28)
+                    )
+                );
+
+                case PACK_5551: return _mm_or_si128
+                (
+                    _mm_or_si128
+                    (
+                        _mm_slli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0x0000F8)),  8),
+                        _mm_srli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0x00F800)),  5)
+                    ),
+                    _mm_or_si128
+                    (
+                        _mm_srli_epi32 (_mm_and_si128 (pixels, _mm_set1_epi32 (0xF80000)), 18),
+                        _mm_srli_epi32 (pixels, 31)
+                    )
+                );
+            }
+
+            return pixels;
+        }
+
+        // SSE2 only has a signed 32 to 16 bit pack, so the values are biased to fit in its range:
+
+        inline __m128i narrow_sse2 (__m128i low, __m128i high)
+        {
+            const __m128i bias = _mm_set1_epi32 (0x8000);
+
+            __m128i packed = _mm_packs_epi32 (_mm_sub_epi32 (low, bias), _mm_sub_epi32 (high, bias));
+
+            return _mm_xor_si128 (packed, _mm_set1_epi16 (short(0x8000)));
+        }
+
+        template< Packing PACKING >
+        void pack_sse2 (const byte * rgba, uint16_t * target, size_t count, const byte * dither)
+        {
+            const __m128i offsets = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(dither));
+
+            size_t index = 0;
+
+            for ( ; index + 8 <= count; index += 8, rgba += 32)
+            {
+                __m128i low  = _mm_adds_epu8 (_mm_loadu_si128 (reinterpret_cast< const __m128i * >(rgba     )), offsets);
+                __m128i high = _mm_adds_epu8 (_mm_loadu_si128 (reinterpret_cast< const __m128i * >(rgba + 16)), offsets);
+
+                _mm_storeu_si128
+                (
+                    reinterpret_cast< __m128i * >(target + index),
+                    narrow_sse2 (pack_lanes_sse2< PACKING > (low), pack_lanes_sse2< PACKING > (high))
+                );
+            }
+
+            pack_scalar< PACKING > (rgba, target + index, count - index, dither);
+        }
+
+        // Each 16 bit lane holds a component. Multiplying the alpha by 255 leaves it unchanged:
+
+        inline __m128i premultiply_components_sse2 (__m128i components)
+        {
+            const __m128i color_mask = _mm_set_epi16 (0, -1, -1, -1, 0, -1, -1, -1);
+            const __m128i alpha_one  = _mm_set_epi16 (255, 0, 0, 0, 255, 0, 0, 0);
+
+            __m128i alpha   = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (components, 0xFF), 0xFF);
+            __m128i factor  = _mm_or_si128 (_mm_and_si128 (alpha, color_mask), alpha_one);
+            __m128i product = _mm_add_epi16 (_mm_mullo_epi16 (components, factor), _mm_set1_epi16 (128));
+
+            return _mm_srli_epi16 (_mm_add_epi16 (product, _mm_srli_epi16 (product, 8)), 8);
+        }
+
+        void premultiply_sse2 (byte * rgba, size_t count)
+        {
+            const __m128i zero = _mm_setzero_si128 ();
+
+            size_t index = 0;
+
+            for ( ; index + 4 <= count; index += 4, rgba += 16)
+            {
+                __m128i pixels = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(rgba));
+
+                __m128i low  = premultiply_components_sse2 (_mm_unpacklo_epi8 (pixels, zero));
+                __m128i high = premultiply_components_sse2 (_mm_unpackhi_epi8 (pixels, zero));
+
+                _mm_storeu_si128 (reinterpret_cast< __m128i * >(rgba), _mm_packus_epi16 (low, high));
+            }
+
+            premultiply_scalar (rgba, count - index);
+        }
+
+        template< Channel_Order ORDER >
+        inline __m128i swizzle_lanes_sse2 (__m128i pixels)
+        {
+            const __m128i byte_0 = _mm_set1_epi32 (0x000000FF);
+            const __m128i byte_1 = _mm_set1_epi32 (0x0000FF00);
+
+            switch (ORDER)
+            {
+                case BGRA: return _mm_or_si128
+                (
+                    _mm_and_si128 (pixels, _mm_set1_epi32 (int(0xFF00FF00))),
+                    _mm_or_si128
+                    (
+                        _mm_and_si128  (_mm_srli_epi32 (pixels, 16), byte_0),
+                        _mm_slli_epi32 (_mm_and_si128  (pixels, byte_0), 16)
+                    )
+                );
+
+                case ARGB: return _mm_or_si128 (_mm_slli_epi32 (pixels, 8), _mm_srli_epi32 (pixels, 24));
+
+                case ABGR: return _mm_or_si128
+                (
+                    _mm_or_si128
+                    (
+                        _mm_slli_epi32 (pixels, 24),
+                        _mm_slli_epi32 (_mm_and_si128 (pixels, byte_1), 8)
+                    ),
+                    _mm_or_si128
+                    (
+                        _mm_and_si128  (_mm_srli_epi32 (pixels, 8), byte_1),
+                        _mm_srli_epi32 (pixels, 24)
+                    )
+                );
+            }
+
+            return pixels;
+        }
+
+        template< Channel_Order ORDER >
+        void swizzle_sse2 (byte * rgba, size_t count)
+        {
+            size_t index = 0;
+
+            for ( ; index + 4 <= count; index += 4, rgba += 16)
+            {
+                __m128i pixels = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(rgba));
+
+                _mm_storeu_si128 (reinterpret_cast< __m128i * >(rgba), swizzle_lanes_sse2< ORDER > (pixels));
+            }
+
+            swizzle_scalar< ORDER > (rgba, count - index);
+        }
+
+        const Kernels sse2_kernels =
+        {
+            "sse2",
+            { pack_sse2< PACK_565 >, pack_sse2< PACK_4444 >, pack_sse2< PACK_5551 > },
+            premultiply_sse2,
+            { swizzle_sse2< BGRA >, swizzle_sse2< ARGB >, swizzle_sse2< ABGR > },
+        };
+
+        #endif
+
+        // -----------------------------------------------------------------------------------------
+        // AVX2 kernels (the same operations as the SSE2 ones with twice as many pixels)
+        // -----------------------------------------------------------------------------------------
+
+        #if defined(BASICS_PIXEL_CONVERSION_AVX2)
+
+        BASICS_AVX2 inline __m256i pack_lanes_avx2 (__m256i pixels, Packing packing)
+        {
+            switch (packing)
+            {
+                case PACK_565: return _mm256_or_si256
+                (
+                    _mm256_or_si256
+                    (
+                        _mm256_slli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0x0000F8)),  8),
+                        _mm256_srli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0x00FC00)),  5)
+                    ),
+                        _mm256_srli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0xF80000)), 19)
+                );
+
+                case PACK_4444: return _mm256_or_si256
+                (
+                    _mm256_or_si256
+                    (
+                        _mm256_slli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0x0000F0)),  8),
+                        _mm256_srli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0x00F000)),  4)
+                    ),
+                    _mm256_or_si256
+                    (
+                        _mm256_srli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0xF00000)), 16),
+                        _mm256_srli_epi32 (pixels, 28)
+                    )
+                );
+
+                case PACK_5551: return _mm256_or_si256
+                (
+                    _mm256_or_si256
+                    (
+                        _mm256_slli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0x0000F8)),  8),
+                        _mm256_srli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0x00F800)),  5)
+                    ),
+                    _mm256_or_si256
+                    (
+                        _mm256_srli_epi32 (_mm256_and_si256 (pixels, _mm256_set1_epi32 (0xF80000)), 18),
+                        _mm256_srli_epi32 (pixels, 31)
+                    )
+                );
+            }
+
+            return pixels;
+        }
+
+        // AVX2 has an unsigned pack, but it works within each 128 bit half, so the result has to
+        // be put back in order:
+
+        BASICS_AVX2 void pack_avx2 (const byte * rgba, uint16_t * target, size_t count, const byte * dither, Packing packing)
+        {
+            const __m128i offsets_128 = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(dither));
+            const __m256i offsets     = _mm256_inserti128_si256 (_mm256_castsi128_si256 (offsets_128), offsets_128, 1);
+
+            size_t index = 0;
+
+            for ( ; index + 16 <= count; index += 16, rgba += 64)
+            {
+                __m256i low  = _mm256_adds_epu8 (_mm256_loadu_si256 (reinterpret_cast< const __m256i * >(rgba     )), offsets);
+                __m256i high = _mm256_adds_epu8 (_mm256_loadu_si256 (reinterpret_cast< const __m256i * >(rgba + 32)), offsets);
+
+                __m256i packed = _mm256_packus_epi32 (pack_lanes_avx2 (low, packing), pack_lanes_avx2 (high, packing));
+
+                _mm256_storeu_si256 (reinterpret_cast< __m256i * >(target + index), _mm256_permute4x64_epi64 (packed, 0xD8));
+            }
+
+            sse2_kernels.pack[packing] (rgba, target + index, count - index, dither);
+        }
+
+        template< Packing PACKING >
+        void pack_avx2 (const byte * rgba, uint16_t * target, size_t count, const byte * dither)
+        {
+            pack_avx2 (rgba, target, count, dither, PACKING);
+        }
+
+        BASICS_AVX2 inline __m256i premultiply_components_avx2 (__m256i components)
+        {
+            const __m256i color_mask = _mm256_set_epi16 (0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+            const __m256i alpha_one  = _mm256_set_epi16 (255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+
+            __m256i alpha   = _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (components, 0xFF), 0xFF);
+            __m256i factor  = _mm256_or_si256 (_mm256_and_si256 (alpha, color_mask), alpha_one);
+            __m256i product = _mm256_add_epi16 (_mm256_mullo_epi16 (components, factor), _mm256_set1_epi16 (128));
+
+            return _mm256_srli_epi16 (_mm256_add_epi16 (product, _mm256_srli_epi16 (product, 8)), 8);
+        }
+
+        BASICS_AVX2 void premultiply_avx2 (byte * rgba, size_t count)
+        {
+            const __m256i zero = _mm256_setzero_si256 ();
+
+            size_t index = 0;
+
+            for ( ; index + 8 <= count; index += 8, rgba += 32)
+            {
+                __m256i pixels = _mm256_loadu_si256 (reinterpret_cast< const __m256i * >(rgba));
+
+                __m256i low  = premultiply_components_avx2 (_mm256_unpacklo_epi8 (pixels, zero));
+                __m256i high = premultiply_components_avx2 (_mm256_unpackhi_epi8 (pixels, zero));
+
+                _mm256_storeu_si256 (reinterpret_cast< __m256i * >(rgba), _mm256_packus_epi16 (low, high));
+            }
+
+            premultiply_sse2 (rgba, count - index);
+        }
+
+        BASICS_AVX2 void swizzle_avx2 (byte * rgba, size_t count, Channel_Order order)
+        {
+            const __m256i byte_0 = _mm256_set1_epi32 (0x000000FF);
+            const __m256i byte_1 = _mm256_set1_epi32 (0x0000FF00);
+
+            size_t index = 0;
+
+            for ( ; index + 8 <= count; index += 8, rgba += 32)
+            {
+                __m256i pixels = _mm256_loadu_si256 (reinterpret_cast< const __m256i * >(rgba));
+
+                switch (order)
+                {
+                    case BGRA: pixels = _mm256_or_si256
+                    (
+                        _mm256_and_si256 (pixels, _mm256_set1_epi32 (int(0xFF00FF00))),
+                        _mm256_or_si256
+                        (
+                            _mm256_and_si256  (_mm256_srli_epi32 (pixels, 16), byte_0),
+                            _mm256_slli_epi32 (_mm256_and_si256  (pixels, byte_0), 16)
+                        )
+                    );
+                    break;
+
+                    case ARGB: pixels = _mm256_or_si256 (_mm256_slli_epi32 (pixels, 8), _mm256_srli_epi32 (pixels, 24));
+                    break;
+
+                    case ABGR: pixels = _mm256_or_si256
+                    (
+                        _mm256_or_si256
+                        (
+                            _mm256_slli_epi32 (pixels, 24),
+                            _mm256_slli_epi32 (_mm256_and_si256 (pixels, byte_1), 8)
+                        ),
+                        _mm256_or_si256
+                        (
+                            _mm256_and_si256  (_mm256_srli_epi32 (pixels, 8), byte_1),
+                            _mm256_srli_epi32 (pixels, 24)
+                        )
+                    );
+                    break;
+                }
+
+                _mm256_storeu_si256 (reinterpret_cast< __m256i * >(rgba), pixels);
+            }
+
+            sse2_kernels.swizzle[order] (rgba, count - index);
+        }
+
+        template< Channel_Order ORDER >
+        void swizzle_avx2 (byte * rgba, size_t count)
+        {
+            swizzle_avx2 (rgba, count, ORDER);
+        }
+
+        const Kernels avx2_kernels =
+        {
+            "avx2",
+            { pack_avx2< PACK_565 >, pack_avx2< PACK_4444 >, pack_avx2< PACK_5551 > },
+            premultiply_avx2,
+            { swizzle_avx2< BGRA >, swizzle_avx2< ARGB >, swizzle_avx2< ABGR > },
+        };
+
+        #endif
+
+        // -----------------------------------------------------------------------------------------
+        // NEON kernels (16 pixels deinterleaved in one component per register)
+        // -----------------------------------------------------------------------------------------
+
+        #if defined(BASICS_PIXEL_CONVERSION_NEON)
+
+        // The shift right and insert keeps the top bits of the first operand, so each component is
+        // placed below the previous ones:
+
+        template< Packing PACKING >
+        inline uint16x8_t pack_components_neon (uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+        {
+            uint16x8_t packed = vshll_n_u8 (r, 8);
+
+            switch (PACKING)
+            {
+                case PACK_565:
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (g, 8),  5);
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (b, 8), 11);
+                    break;
+
+                case PACK_4444:
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (g, 8),  4);
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (b, 8),  8);
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (a, 8), 12);
+                    break;
+
+                case PACK_5551:
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (g, 8),  5);
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (b, 8), 10);
+                    packed = vsriq_n_u16 (packed, vshll_n_u8 (a, 8), 15);
+                    break;
+            }
+
+            return packed;
+        }
+
+        template< Packing PACKING >
+        void pack_neon (const byte * rgba, uint16_t * target, size_t count, const byte * dither)
+        {
+            // Loading the pattern repeated 4 times leaves the offsets of each component in a register:
+
+            byte repeated_dither[64];
+
+            for (unsigned copy = 0; copy < 4; ++copy) std::memcpy (repeated_dither + copy * 16, dither, 16);
+
+            const uint8x16x4_t offsets = vld4q_u8 (repeated_dither);
+
+            size_t index = 0;
+
+            for ( ; index + 16 <= count; index += 16, rgba += 64)
+            {
+                uint8x16x4_t pixels = vld4q_u8 (rgba);
+
+                uint8x16_t r = vqaddq_u8 (pixels.val[0], offsets.val[0]);
+                uint8x16_t g = vqaddq_u8 (pixels.val[1], offsets.val[1]);
+                uint8x16_t b = vqaddq_u8 (pixels.val[2], offsets.val[2]);
+                uint8x16_t a = vqaddq_u8 (pixels.val[3], offsets.val[3]);
+
+                vst1q_u16 (target + index,     pack_components_neon< PACKING > (vget_low_u8  (r), vget_low_u8  (g), vget_low_u8  (b), vget_low_u8  (a)));
+                vst1q_u16 (target + index + 8, pack_components_neon< PACKING > (vget_high_u8 (r), vget_high_u8 (g), vget_high_u8 (b), vget_high_u8 (a)));
+            }
+
+            pack_scalar< PACKING > (rgba, target + index, count - index, dither);
+        }
+
+        // (x * a + 128 + ((x * a + 128) >> 8)) >> 8, the same rounding as the scalar kernel:
+
+        inline uint8x8_t multiply_neon (uint8x8_t component, uint8x8_t alpha)
+        {
+            uint16x8_t product = vmull_u8 (component, alpha);
+
+            return vraddhn_u16 (product, vrshrq_n_u16 (product, 8));
+        }
+
+        inline uint8x16_t multiply_neon (uint8x16_t component, uint8x16_t alpha)
+        {
+            return vcombine_u8
+            (
+                multiply_neon (vget_low_u8  (component), vget_low_u8  (alpha)),
+                multiply_neon (vget_high_u8 (component), vget_high_u8 (alpha))
+            );
+        }
+
+        void premultiply_neon (byte * rgba, size_t count)
+        {
+            size_t index = 0;
+
+            for ( ; index + 16 <= count; index += 16, rgba += 64)
+            {
+                uint8x16x4_t pixels = vld4q_u8 (rgba);
+
+                pixels.val[0] = multiply_neon (pixels.val[0], pixels.val[3]);
+                pixels.val[1] = multiply_neon (pixels.val[1], pixels.val[3]);
+                pixels.val[2] = multiply_neon (pixels.val[2], pixels.val[3]);
+
+                vst4q_u8 (rgba, pixels);
+            }
+
+            premultiply_scalar (rgba, count - index);
+        }
+
+        template< Channel_Order ORDER >
+        void swizzle_neon (byte * rgba, size_t count)
+        {
+            size_t index = 0;
+
+            for ( ; index + 16 <= count; index += 16, rgba += 64)
+            {
+                uint8x16x4_t source = vld4q_u8 (rgba);
+                uint8x16x4_t target;
+
+                switch (ORDER)
+                {
+                    case BGRA: target.val[0] = source.val[2]; target.val[1] = source.val[1]; target.val[2] = source.val[0]; target.val[3] = source.val[3]; break;
+                    case ARGB: target.val[0] = source.val[3]; target.val[1] = source.val[0]; target.val[2] = source.val[1]; target.val[3] = source.val[2]; break;
+                    case ABGR: target.val[0] = source.val[3]; target.val[1] = source.val[2]; target.val[2] = source.val[1]; target.val[3] = source.val[0]; break;
+                }
+
+                vst4q_u8 (rgba, target);
+            }
+
+            swizzle_scalar< ORDER > (rgba, count - index);
+        }
+
+        const Kernels neon_kernels =
+        {
+            "neon",
+            { pack_neon< PACK_565 >, pack_neon< PACK_4444 >, pack_neon< PACK_5551 > },
+            premultiply_neon,
+            { swizzle_neon< BGRA >, swizzle_neon< ARGB >, swizzle_neon< ABGR > },
+        };
+
+        #endif
+
+        // -----------------------------------------------------------------------------------------
+        // Dispatch
+        // -----------------------------------------------------------------------------------------
+
+        const Kernels & get_fastest_kernels ()
+        {
+            static const Kernels & fastest = [] () -> const Kernels &
+            {
+                #if defined(BASICS_PIXEL_CONVERSION_NEON)
+                    return neon_kernels;
+                #elif defined(BASICS_PIXEL_CONVERSION_SSE2)
+                    #if defined(BASICS_PIXEL_CONVERSION_AVX2)
+                        __builtin_cpu_init ();
+                        if (__builtin_cpu_supports ("avx2")) return avx2_kernels;
+                    #endif
+                    return sse2_kernels;
+                #else
+                    return scalar_kernels;
+                #endif
+            }
+            ();
+
+            return fastest;
+        }
+
+        std::atomic< bool > scalar_forced(false);
+
+        const Kernels & get_kernels ()
+        {
+            return scalar_forced ? scalar_kernels : get_fastest_kernels ();
+        }
+
+        void convert (const Color_Buffer< Rgba8888 > & source, Color_Buffer< uint16_t > & target, bool dither, Packing packing)
+        {
+            unsigned width  = source.get_width  ();
+            unsigned height = source.get_height ();
+
+            target.resize (width, height);
+
+            if (source.size () == 0) return;
+
+            const byte * rgba   = reinterpret_cast< const byte * >(source.buffer.data ());
+            Pack_Kernel  kernel = get_kernels ().pack[packing];
+            byte         offsets[16] = { };
+
+            // Without dithering the whole image can go in a single run:
+
+            if (!dither)
+            {
+                kernel (rgba, target.buffer.data (), source.size (), offsets);
+                return;
+            }
+
+            for (unsigned y = 0; y < height; ++y)
+            {
+                for (unsigned x = 0; x < 4; ++x)
+                {
+                    for (unsigned component = 0; component < 4; ++component)
+                    {
+                        unsigned bits = packing_bits[packing][component];
+
+                        // The alpha isn't dithered, since it would make the edges of the sprites noisy:
+
+                        offsets[x * 4 + component] = component < 3 && bits > 0
+                            ? byte((bayer_matrix[y & 3][x] << (8 - bits)) >> 4)
+                            : 0;
+                    }
+                }
+
+                kernel (rgba + size_t(y) * width * 4, target.buffer.data () + size_t(y) * width, width, offsets);
+            }
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void convert_to_rgb565 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgb565 > & target, bool dither)
+    {
+        convert (source, target, dither, PACK_565);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void convert_to_rgba4444 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba4444 > & target, bool dither)
+    {
+        convert (source, target, dither, PACK_4444);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void convert_to_rgba5551 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba5551 > & target, bool dither)
+    {
+        convert (source, target, dither, PACK_5551);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void premultiply_alpha (Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        get_kernels ().premultiply (color_buffer, color_buffer.size ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void swizzle (Color_Buffer< Rgba8888 > & color_buffer, Channel_Order order)
+    {
+        get_kernels ().swizzle[order] (color_buffer, color_buffer.size ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const char * get_pixel_conversion_kernels ()
+    {
+        return get_kernels ().name;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void use_scalar_pixel_conversion (bool scalar)
+    {
+        scalar_forced = scalar;
+    }
+
+}
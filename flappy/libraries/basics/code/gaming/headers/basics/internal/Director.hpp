@@ -13,11 +13,18 @@
 #ifndef BASICS_DIRECTOR_HEADER
 #define BASICS_DIRECTOR_HEADER
 
+    #include <atomic>
     #include <memory>
+    #include <string>
     #include <basics/declarations>
     #include <basics/Event_Queue>
+    #include <basics/Frame_Arena>
+    #include <basics/Frame_Statistics>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
+    #include <basics/Performance_Overlay>
+    #include <basics/Render_Thread>
+    #include <basics/Touch_Batch>
     #include <basics/Window>
 
     namespace basics
@@ -62,7 +69,24 @@
             std::shared_ptr< Scene > current_scene;
             std::shared_ptr< Scene >  target_scene;
 
-            Event_Queue event_queue;
+            // The touches that arrive while the scene isn't active are stale by the time it
+            // resumes, so the oldest ones are dropped instead of blocking the input thread:
+
+            Input_Event_Queue event_queue{ 256, Overflow_Policy::DROP_OLDEST };
+
+            // The input thread coalesces the touches into a batch and the kernel takes it every
+            // frame. They trade the batches through the middle one with atomic exchanges, so no
+            // side ever waits and the samples are never dropped but by Touch_Batch::add():
+
+            struct
+            {
+                Touch_Batch                  batches[3];
+                Touch_Batch                * back;          ///< Empty. Only used by the input thread.
+                std::atomic< Touch_Batch * > middle;
+                Touch_Batch                * frame;         ///< Only used by the kernel.
+                std::atomic< bool >          keep_history;
+            }
+            touches;
 
             float surface_width;
             float surface_height;
@@ -70,10 +94,39 @@
             Graphics_Context_Factory graphics_context_factory;
             Graphics_Resource_Cache  graphics_resource_cache;
 
+            // The pipelined scenes are presented by the render thread while the kernel updates the
+            // next frame:
+
+            Render_Thread            render_thread;
+            std::atomic< bool >      pipelining;
+
+            // Memory for what only lives during a frame. It's reset at the beginning of every frame
+            // of the kernel:
+
+            Frame_Arena              frame_arena;
+
+            // Times of the latest frames and the panel that can show them over the scene:
+
+            Frame_Statistics         frame_statistics;
+            Canvas::Frame_Stats      canvas_frame_stats;             ///< Of the last frame presented.
+
+            struct
+            {
+                Performance_Overlay  panel;
+                bool                 visible;
+            }
+            overlay;
+
+            bool                     report_frame_statistics;
+
         private:
 
             Director();
 
+        public:
+
+           ~Director();
+
         public:
 
             void set_graphics_context_factory (Graphics_Context_Factory factory)
@@ -83,6 +136,89 @@
 
             Graphics_Context::Accessor lock_graphics_context ();
 
+            /**
+             * Saves the last frame presented (see Graphics_Context::save_frame()) once the render
+             * thread has finished presenting it. It must be called from the kernel thread.
+             */
+            bool save_frame (const std::string & path);
+
+            /**
+             * Allows or forbids drawing the pipelined scenes (see Scene::set_pipelined()) in a
+             * render thread. By default it's allowed when there's more than one hardware thread.
+             */
+            void set_pipelining (bool enabled)
+            {
+                pipelining = enabled;
+            }
+
+            bool is_pipelining () const
+            {
+                return pipelining;
+            }
+
+            /**
+             * Arena from which the scenes and the engine can take the memory that they only need
+             * during the current frame (see Frame_Allocator). It must only be used from the kernel
+             * thread (in the methods of the scenes, for instance), not from the render thread.
+             */
+            Frame_Arena & get_frame_arena ()
+            {
+                return frame_arena;
+            }
+
+            /**
+             * Times of the latest frames, for automated runs or for the scene to show them. The
+             * durations are measured only while a scene is active.
+             */
+            const Frame_Statistics & get_frame_statistics () const
+            {
+                return frame_statistics;
+            }
+
+            Frame_Statistics & get_frame_statistics ()
+            {
+                return frame_statistics;
+            }
+
+            /**
+             * What the canvas did to draw the last frame that was presented. The Director copies
+             * the statistics of the canvas and resets them at the end of every frame (the render
+             * thread does it when the scene is pipelined).
+             */
+            const Canvas::Frame_Stats & get_canvas_frame_stats () const
+            {
+                return canvas_frame_stats;
+            }
+
+            /**
+             * Shows or hides the performance overlay, which is drawn over the current scene.
+             */
+            void show_performance_overlay (bool visible)
+            {
+                overlay.visible = visible;
+            }
+
+            bool is_showing_performance_overlay () const
+            {
+                return overlay.visible;
+            }
+
+            /**
+             * Sets the path of the Raster_Font with which the overlay writes the statistics.
+             * Without font only the graph of the frame times is drawn.
+             */
+            void set_performance_overlay_font (const std::string & font_path);
+
+            /**
+             * Makes the kernel log the summary of the frame statistics when it stops.
+             */
+            void report_frame_statistics_on_exit (bool report)
+            {
+                report_frame_statistics = report;
+            }
+
+            void log_frame_statistics () const;
+
         public:
 
             void run_scene (const std::shared_ptr< Scene > & new_scene);
@@ -92,11 +228,66 @@
                 kernel.exit = kernel.running;
             }
 
+            /**
+             * Queues an event for the current scene. It must always be called from the same
+             * thread (the input one).
+             */
             void handle (const Event & event)
             {
                 event_queue.push (event);
             }
 
+            void handle (Event && event)
+            {
+                event_queue.push (std::move (event));
+            }
+
+            const Input_Event_Queue & get_event_queue () const
+            {
+                return event_queue;
+            }
+
+            /**
+             * Adds touch samples (in the order in which they happened) to the batch that the
+             * current scene will receive in its next frame through Scene::handle_touches(). It
+             * must always be called from the same thread.
+             */
+            void handle (const Touch_Sample * samples, size_t count)
+            {
+                // The middle batch holds the samples that the kernel hasn't taken yet (if any), so
+                // the new ones are added after them. Meanwhile the kernel can only get an empty one:
+
+                Touch_Batch * batch        = touches.middle.exchange (touches.back, std::memory_order_acq_rel);
+                bool          keep_history = touches.keep_history;
+
+                for (size_t index = 0; index < count; ++index)
+                {
+                    batch->add (samples[index], keep_history);
+                }
+
+                touches.back = touches.middle.exchange (batch, std::memory_order_acq_rel);
+            }
+
+            void handle (const Touch_Sample & sample)
+            {
+                handle (&sample, 1);
+            }
+
+            /**
+             * Tells whether the intermediate positions of the moves within a frame are kept in
+             * the touch batches (as historical samples) or only the newest one. By default only
+             * the newest one is kept.
+             */
+            void keep_touch_history (bool keep)
+            {
+                touches.keep_history = keep;
+            }
+
+            bool is_keeping_touch_history () const
+            {
+                return touches.keep_history;
+            }
+
         private:
 
             void run_kernel ();
@@ -0,0 +1,156 @@
+/*
+ *  FRAME STATISTICS
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1803051000
+ */
+
+#ifndef BASICS_FRAME_STATISTICS_HEADER
+#define BASICS_FRAME_STATISTICS_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+
+    namespace basics
+    {
+
+        /**
+         * Times of the latest frames (in milliseconds) from which the Director computes the
+         * percentiles that tell how smooth the frame rate is:
+         *
+         *  - FRAME:   whole iteration of the kernel.
+         *  - UPDATE:  all the updates of the scene in the frame.
+         *  - RENDER:  Scene::render(), or Scene::record() when the scene is pipelined.
+         *  - SWAP:    flush_and_display(), or the submission to the render thread when the scene is
+         *             pipelined (which waits for the previous frame to be presented).
+         *  - LATENCY: from the oldest touch of a frame to the moment that frame was presented.
+         *
+         * A frame misses as many vsync deadlines as periods of the display it takes beyond the
+         * first one (rounding), since the display repeats the previous image meanwhile.
+         *
+         * It must only be used from the kernel thread (in the methods of the scenes, for example).
+         */
+        class Frame_Statistics
+        {
+        public:
+
+            static constexpr size_t window_size = 240;          ///< Frames (4 seconds at 60 fps).
+
+            enum Metric
+            {
+                FRAME,
+                UPDATE,
+                RENDER,
+                SWAP,
+                LATENCY,
+                METRIC_COUNT
+            };
+
+            struct Summary
+            {
+                size_t count;                                   ///< Samples in the window.
+                float  mean;
+                float  p50;
+                float  p95;
+                float  p99;
+                float  max;
+            };
+
+        private:
+
+            struct Ring
+            {
+                float  samples[window_size];
+                size_t count;
+                size_t next;
+            };
+
+            Ring     rings[METRIC_COUNT];
+            uint8_t  missed_vsyncs[window_size];                ///< In parallel with the FRAME ring.
+            float    vsync_period;                              ///< Milliseconds.
+            uint64_t total_frames;
+            uint64_t total_missed_vsyncs;
+
+        public:
+
+            Frame_Statistics();
+
+        public:
+
+            /**
+             * Adds the times of a frame that has ended.
+             */
+            void add_frame (float frame, float update, float render, float swap);
+
+            void add_latency (float latency);
+
+            /**
+             * Forgets all the samples and the totals.
+             */
+            void reset ();
+
+            /**
+             * Sets the refresh period of the display (1/60 s by default).
+             */
+            void set_vsync_period (float seconds)
+            {
+                if (seconds > 0.f) vsync_period = seconds * 1000.f;
+            }
+
+            float get_vsync_period () const
+            {
+                return vsync_period / 1000.f;
+            }
+
+        public:
+
+            /**
+             * Computes the mean, the percentiles (by nearest rank) and the maximum of a metric in
+             * the window. Everything is 0 when there are no samples.
+             */
+            Summary get_summary (Metric metric) const;
+
+            size_t get_count (Metric metric) const
+            {
+                return rings[metric].count;
+            }
+
+            /**
+             * Returns a sample of the window, where 0 is the newest one.
+             */
+            float get_sample (Metric metric, size_t age) const
+            {
+                const Ring & ring = rings[metric];
+
+                return ring.samples[(ring.next + window_size - 1 - age) % window_size];
+            }
+
+            /**
+             * Vsync deadlines missed by the frames of the window.
+             */
+            unsigned get_missed_vsyncs () const;
+
+            uint64_t get_total_missed_vsyncs () const
+            {
+                return total_missed_vsyncs;
+            }
+
+            uint64_t get_total_frames () const
+            {
+                return total_frames;
+            }
+
+        private:
+
+            static void add (Ring & ring, float sample);
+
+        };
+
+    }
+
+#endif
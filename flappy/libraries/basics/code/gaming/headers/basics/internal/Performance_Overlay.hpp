@@ -0,0 +1,90 @@
+/*
+ *  PERFORMANCE OVERLAY
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1803051100
+ */
+
+#ifndef BASICS_PERFORMANCE_OVERLAY_HEADER
+#define BASICS_PERFORMANCE_OVERLAY_HEADER
+
+    #include <memory>
+    #include <string>
+    #include <basics/Canvas>
+    #include <basics/Frame_Arena>
+    #include <basics/Frame_Statistics>
+    #include <basics/Graphics_Context>
+    #include <basics/Raster_Font>
+    #include <basics/Size>
+    #include <basics/Text_Layout>
+
+    namespace basics
+    {
+
+        /**
+         * Panel that the Director draws over the scene with the frame times of the latest frames
+         * as a graph of bars (green within the vsync period, yellow within two periods and red
+         * beyond) and, when it has a font, with the percentiles of each metric.
+         */
+        class Performance_Overlay
+        {
+        public:
+
+            static constexpr size_t graph_frames = 120;
+
+        private:
+
+            std::unique_ptr< Raster_Font > font;
+            std::string                    font_path;
+            bool                           font_failed;
+
+        public:
+
+            Performance_Overlay() : font_failed(false)
+            {
+            }
+
+        public:
+
+            /**
+             * Sets the Raster_Font with which the text is drawn. It's loaded by load_font(). With
+             * an empty path only the graph is drawn.
+             */
+            void set_font_path (const std::string & path)
+            {
+                if (path != font_path)
+                {
+                    font_path   = path;
+                    font_failed = false;
+
+                    font.reset ();
+                }
+            }
+
+            bool needs_font () const
+            {
+                return !font && !font_failed && !font_path.empty ();
+            }
+
+            void load_font (Graphics_Context::Accessor & context);
+
+            /**
+             * Draws the overlay at the top left corner of a canvas of the given size. It leaves
+             * the canvas with the identity transform, white color and full opacity.
+             */
+            void draw (Canvas & canvas, const Size2u & canvas_size, const Frame_Statistics & statistics, Frame_Arena & arena);
+
+        private:
+
+            void draw_panel (Canvas & canvas, const Size2u & canvas_size, const Frame_Statistics & statistics, const Text_Layout * text);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ *  RENDER THREAD
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1803011100
+ */
+
+#ifndef BASICS_RENDER_THREAD_HEADER
+#define BASICS_RENDER_THREAD_HEADER
+
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+    #include <basics/Non_Copyable>
+    #include <basics/Render_Queue>
+    #include <basics/Size>
+    #include <basics/Window>
+
+    namespace basics
+    {
+
+        /**
+         * Thread that replays on the canvas of the window the frames recorded by another thread
+         * and presents them, so that the next frame can be simulated and recorded meanwhile. There
+         * are two render queues: one is recorded while the other is being replayed.
+         *
+         * The graphics context can only be current in one thread at a time, so it's handed over
+         * explicitly: submit() gives it to the render thread (if it didn't have it yet) and
+         * synchronize() gives it back to the calling thread. While the render thread owns it, the
+         * other threads must not use the context.
+         */
+        class Render_Thread : Non_Copyable
+        {
+
+            Render_Queue            queues[2];
+            unsigned                recording;          ///< Index of the queue that can be recorded.
+
+            std::thread             thread;
+            std::mutex              mutex;
+            std::condition_variable condition;
+
+            Window::Handle          window;
+            Size2u                  canvas_size;
+            bool                    reset_canvas;
+            int64_t                 input_time;         ///< Of the oldest touch of the submitted frame.
+            int64_t                 input_latency;      ///< Of the last frame presented with touches.
+            Canvas::Frame_Stats     canvas_stats;       ///< Of the last frame replayed.
+            bool                    canvas_stats_ready;
+
+            bool                    busy;               ///< There's a frame submitted and not presented yet.
+            bool                    owns_context;       ///< The context is current in the render thread.
+            bool                    release;            ///< The render thread must release the context.
+            bool                    exit;
+
+            unsigned                presented_frames;
+            unsigned                failed_frames;
+
+        public:
+
+            Render_Thread();
+
+           ~Render_Thread()
+            {
+                stop ();
+            }
+
+        public:
+
+            /**
+             * The queue that must receive the drawing of the next frame. It's emptied when the
+             * previous one is submitted.
+             */
+            Render_Queue & get_render_queue ()
+            {
+                return queues[recording];
+            }
+
+            /**
+             * Waits until the previous frame has been presented (so that at most one frame is in
+             * flight) and hands the recorded queue over to the render thread, which is started the
+             * first time. The context is taken from the calling thread if it still had it.
+             * @param canvas_size  Size with which the canvas is created if it doesn't exist yet.
+             * @param reset_canvas Whether the state of the canvas must be reset before the replay.
+             * @param input_time   Time (nanoseconds of std::chrono::steady_clock) of the oldest
+             *                     touch that the frame reflects, or 0 if there's none.
+             */
+            void submit (const Window::Handle & window, const Size2u & canvas_size, bool reset_canvas, int64_t input_time = 0);
+
+            /**
+             * Waits until the frame in flight (if any) has been presented and makes the context
+             * current again in the calling thread. It does nothing when the render thread doesn't
+             * own the context.
+             */
+            void synchronize ();
+
+            /**
+             * Synchronizes and ends the render thread. It's started again by the next submit().
+             */
+            void stop ();
+
+        public:
+
+            bool owns_graphics_context ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                return owns_context;
+            }
+
+            unsigned get_presented_frames ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                return presented_frames;
+            }
+
+            /**
+             * Returns the nanoseconds between the oldest touch of the last frame with touches that
+             * was presented and its presentation, or -1 if no such frame has been presented since
+             * the previous call.
+             */
+            int64_t take_input_latency ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                int64_t latency = input_latency;
+
+                input_latency = -1;
+
+                return latency;
+            }
+
+            /**
+             * Copies the statistics of the canvas for the last frame that was replayed and returns
+             * true, or returns false if no frame has been replayed since the previous call.
+             */
+            bool take_canvas_frame_stats (Canvas::Frame_Stats & stats)
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                if (!canvas_stats_ready) return false;
+
+                stats              = canvas_stats;
+                canvas_stats_ready = false;
+
+                return true;
+            }
+
+            /**
+             * Number of frames that couldn't be replayed because the context wasn't available.
+             */
+            unsigned get_failed_frames ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                return failed_frames;
+            }
+
+        private:
+
+            void run ();
+            void present (Render_Queue & queue);
+
+        };
+
+    }
+
+#endif
@@ -13,9 +13,11 @@
 #ifndef BASICS_SCENE_HEADER
 #define BASICS_SCENE_HEADER
 
+    #include <basics/Canvas>
     #include <basics/Event>
     #include <basics/Graphics_Context>
     #include <basics/Size>
+    #include <basics/Touch_Batch>
 
     namespace basics
     {
@@ -25,12 +27,16 @@
         private:
 
             float frame_duration;
+            int   max_catch_up_steps;
+            bool  pipelined;
 
         public:
 
             Scene()
             {
-                frame_duration = -1.f;
+                frame_duration     = -1.f;
+                max_catch_up_steps =  5;
+                pipelined          = false;
             }
 
             virtual ~Scene() = default;
@@ -46,10 +52,56 @@
             virtual void update     (float time) { }
             virtual void render     (Graphics_Context::Accessor & context) { }
 
+            /**
+             * Called instead of render(context) by the Director. When the scene runs with a fixed
+             * step (see set_frame_rate()) alpha is the fraction of a step that has elapsed since the
+             * last update(), so that the scene can draw its state interpolated between the last two
+             * steps. Otherwise it's always 1.
+             */
+            virtual void render (Graphics_Context::Accessor & context, float alpha)
+            {
+                render (context);
+            }
+
+            /**
+             * Called instead of render() when the scene is pipelined (see set_pipelined()). The
+             * canvas only records the drawing, which is replayed by the render thread while the
+             * next frame is being simulated.
+             */
+            virtual void record (Canvas & canvas, float alpha) { }
+
+            /**
+             * Receives the touches of a frame (already in scene coordinates) at once. By default
+             * each sample that isn't historical is passed to handle() as a touch-started,
+             * touch-moved or touch-ended event with the properties id, x and y.
+             */
+            virtual void handle_touches (const Touch_Batch & touches)
+            {
+                static const Id ids[] = { ID(touch-started), ID(touch-moved), ID(touch-ended) };
+
+                for (const Touch_Sample & touch : touches)
+                {
+                    if (touch.historical) continue;
+
+                    Event event(ids[touch.phase]);
+
+                    event[ID(id)] = touch.pointer_id;
+                    event[ID(x) ] = touch.x;
+                    event[ID(y) ] = touch.y;
+
+                    handle (event);
+                }
+            }
+
             virtual Size2u get_view_size () = 0;
 
         public:
 
+            /**
+             * Makes the Director call update() with a fixed step of 1/fps seconds, as many times per
+             * frame as needed to keep up with the real time (possibly none). Until it's called, the
+             * scene is updated once per frame with the duration of the previous frame.
+             */
             bool set_frame_rate (int fps)
             {
                 return fps > 0 ? frame_duration = 1.f / float(fps), true : false;
@@ -60,6 +112,38 @@
                 return frame_duration;
             }
 
+            /**
+             * Limits the fixed steps run in a single frame. When a frame takes longer than that
+             * the simulation falls behind the real time instead of spending ever more time trying
+             * to catch up.
+             */
+            bool set_max_catch_up_steps (int steps)
+            {
+                return steps > 0 ? max_catch_up_steps = steps, true : false;
+            }
+
+            int get_max_catch_up_steps () const
+            {
+                return max_catch_up_steps;
+            }
+
+            /**
+             * Lets the Director draw the frames of the scene in a render thread: record() is called
+             * instead of render() and the frame is presented while the next one is updated. While
+             * the scene is pipelined, its handle() and update() must not use the graphics context
+             * and the textures it draws must live until the next frame is recorded. It can be
+             * changed at any time and takes effect in the next frame.
+             */
+            void set_pipelined (bool enabled)
+            {
+                pipelined = enabled;
+            }
+
+            bool is_pipelined () const
+            {
+                return pipelined;
+            }
+
         };
 
     }
@@ -10,9 +10,14 @@
  * C1801072305
  */
 
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
 #include <basics/Application>
 #include <basics/Director>
 #include <basics/Log>
+#include <basics/Profiler>
 #include <basics/Scene>
 #include <basics/Timer>
 #include <basics/Window>
@@ -29,11 +34,31 @@ namespace basics
     Director::Director()
     {
         kernel.running           = false;
+        overlay.visible          = false;
+        report_frame_statistics  = false;
+        canvas_frame_stats       = Canvas::Frame_Stats();
+        touches.back             = &touches.batches[0];
+        touches.middle           = &touches.batches[1];
+        touches.frame            = &touches.batches[2];
+        touches.keep_history     = false;
+        pipelining               = std::thread::hardware_concurrency () > 1;
         graphics_context_factory = opengles::Context::create;
     }
 
     // ---------------------------------------------------------------------------------------------
 
+    Director::~Director()
+    {
+        // El contexto gráfico guarda un puntero a graphics_resource_cache, por lo que se destruye
+        // antes que el director:
+
+        Window::Accessor window = Window::get_window (default_window_id).lock ();
+
+        if (window) window->reset_graphics_context ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     Graphics_Context::Accessor Director::lock_graphics_context ()
     {
         Window::Accessor window = Window::get_window (default_window_id).lock ();
@@ -48,6 +73,69 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    bool Director::save_frame (const std::string & path)
+    {
+        render_thread.synchronize ();
+
+        Graphics_Context::Accessor context = lock_graphics_context ();
+
+        return context && context->save_frame (path);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::set_performance_overlay_font (const std::string & font_path)
+    {
+        // The render thread may be replaying glyphs of the current font:
+
+        render_thread.synchronize ();
+
+        overlay.panel.set_font_path (font_path);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::log_frame_statistics () const
+    {
+        static const char * names[] = { "frame", "update", "render", "swap", "latency" };
+
+        for (int metric = 0; metric < Frame_Statistics::METRIC_COUNT; ++metric)
+        {
+            Frame_Statistics::Summary summary = frame_statistics.get_summary (Frame_Statistics::Metric(metric));
+
+            char line[160];
+
+            std::snprintf
+            (
+                line, sizeof(line), "%-8s n %3zu  mean %6.2f  p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f ms",
+                names[metric], summary.count, summary.mean, summary.p50, summary.p95, summary.p99, summary.max
+            );
+
+            log.i (line);
+        }
+
+        log.i
+        (
+            "missed vsyncs " + std::to_string (frame_statistics.get_missed_vsyncs ()) + " in the window, " +
+            std::to_string (frame_statistics.get_total_missed_vsyncs ()) + " in " +
+            std::to_string (frame_statistics.get_total_frames ()) + " frames"
+        );
+
+        char line[192];
+
+        std::snprintf
+        (
+            line, sizeof(line), "last frame: %u draw calls, %u vertices, %u quads, %u programs, %u textures, %u uniforms, %zu bytes streamed",
+            canvas_frame_stats.draw_calls,       canvas_frame_stats.vertices,      canvas_frame_stats.quads,
+            canvas_frame_stats.program_switches, canvas_frame_stats.texture_binds, canvas_frame_stats.uniform_uploads,
+            canvas_frame_stats.bytes_streamed
+        );
+
+        log.i (line);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::run_scene (const std::shared_ptr< Scene > & new_scene)
     {
         if (new_scene)
@@ -79,19 +167,40 @@ namespace basics
             Window::create_window (default_window_id);
         }
 
-        float time = 1.f / 60.f;
-        Event event;
+        float time        = 1.f / 60.f;
+        float accumulated = 0.f;                    // Time not simulated yet with fixed steps
+
+        Profiler::set_thread_name ("kernel");
 
         do
         {
-            Timer timer;
-            bool  reset_canvas = false;
+            profiler.begin_frame ();
+
+            Timer   timer;
+            bool    reset_canvas = false;
+            int64_t frame_start  = Profiler::now ();
+
+            // Times of the stages of the frame for frame_statistics:
+
+            Timer   stage_timer;
+            bool    rendered     = false;
+            float   update_time  = 0.f;
+            float   render_time  = 0.f;
+            float   swap_time    = 0.f;
+            int64_t input_time   = 0;               // Of the oldest touch that the scene handles
+
+            // What was allocated in the frame arena during the previous frame is released:
+
+            frame_arena.reset ();
 
             // Check if the current scene must be replaced:
 
             if (target_scene)
             {
-                // If the current scene must be replaced, then it is first finalized:
+                // If the current scene must be replaced, then it is first finalized (once its last
+                // frame has been presented, if it was pipelined):
+
+                render_thread.synchronize ();
 
                 if (current_scene) current_scene->finalize ();
 
@@ -121,76 +230,102 @@ namespace basics
 
                     if (time <= 0.f) time = 1.f / 60.f;
 
+                    accumulated  = 0.f;
                     reset_canvas = true;
                 }
             }
 
             bool previously_active = state;
 
-            while (application.poll (event))
-            {
-                switch (event.id)
+            // Each queue is drained in a single pass. The application one goes first because its
+            // events may create the window:
+
+            bool failed = false;
+
+            application.drain
+            (
+                [&] (Event & event)
                 {
-                    case Application::Event_Id::RESUME:
-                    {
-                        state.active = true;
-                        break;
-                    }
+                    if (failed) return;
 
-                    case Application::Event_Id::SUSPEND:
-                    {
-                        state.active = false;
-                        break;
-                    }
+                    // These events may create, destroy or resize the surface, so the kernel must
+                    // own the graphics context to handle them:
+
+                    render_thread.synchronize ();
 
-                    case Application::Event_Id::WINDOW_CREATED:
+                    switch (event.id)
                     {
-                        window_handle = Window::get_window (default_window_id);
+                        case Application::Event_Id::RESUME:
+                        {
+                            state.active = true;
+                            break;
+                        }
 
-                        Window::Accessor window = window_handle.lock ();
+                        case Application::Event_Id::SUSPEND:
+                        {
+                            state.active = false;
+                            break;
+                        }
 
-                        if (graphics_context_factory)
+                        case Application::Event_Id::WINDOW_CREATED:
                         {
-                            if (!window->has_graphics_context ())
+                            window_handle = Window::get_window (default_window_id);
+
+                            Window::Accessor window = window_handle.lock ();
+
+                            if (graphics_context_factory)
                             {
-                                if (!graphics_context_factory (window, &graphics_resource_cache))
+                                if (!window->has_graphics_context ())
                                 {
-                                    log.e ("ERROR: failed to initialize the OpenGL ES context!");
+                                    if (!graphics_context_factory (window, &graphics_resource_cache))
+                                    {
+                                        log.e ("ERROR: failed to initialize the OpenGL ES context!");
+
+                                        failed = true;
 
-                                    return;
+                                        return;
+                                    }
                                 }
-                            }
 
-                            reset_viewport (window);
+                                reset_viewport (window);
 
-                            state.graphics = true;
-                        }
+                                state.graphics = true;
+                            }
 
-                        break;
-                    }
+                            break;
+                        }
 
-                    case Application::Event_Id::WINDOW_DESTROYED:
-                    {
-                        state.graphics = false;
-                        break;
-                    }
+                        case Application::Event_Id::WINDOW_DESTROYED:
+                        {
+                            state.graphics = false;
+                            break;
+                        }
 
-                    case Application::Event_Id::CONFIGURATION_CHANGED:
-                    {
-                        Window::Accessor window = window_handle.lock ();
+                        case Application::Event_Id::CONFIGURATION_CHANGED:
+                        {
+                            Window::Accessor window = window_handle.lock ();
 
-                        reset_viewport  (window);
+                            reset_viewport  (window);
 
-                        break;
-                    }
+                            break;
+                        }
 
-                    case Application::Event_Id::QUIT:
-                    {
-                        kernel.exit = true;
-                        break;
+                        case Application::Event_Id::QUIT:
+                        {
+                            kernel.exit = true;
+                            break;
+                        }
                     }
                 }
-            }
+            );
+
+            if (failed) return;
+
+            // The touches are taken every frame, even when the scene won't get them, so that the
+            // stale ones don't pile up:
+
+            touches.frame->clear ();
+            touches.frame = touches.middle.exchange (touches.frame, std::memory_order_acq_rel);
 
             if (!kernel.exit)
             {
@@ -198,21 +333,35 @@ namespace basics
 
                 if (window)
                 {
-                    while (window->poll (event))
-                    {
-                        switch (event.id)
+                    window->drain
+                    (
+                        [&] (Event & event)
                         {
-                            case Window::GOT_FOCUS:             state.focused = true;    break;
-                            case Window::LOST_FOCUS:            state.focused = false;   break;
-                            case Window::LOST_GRAPHICS_CONTEXT:                          break;
-                            case Window::RESIZED:
-                            case Window::VIEWPORT_RESIZED:      reset_viewport (window); break;
+                            switch (event.id)
+                            {
+                                case Window::GOT_FOCUS:             state.focused = true;    break;
+                                case Window::LOST_FOCUS:            state.focused = false;   break;
+                                case Window::LOST_GRAPHICS_CONTEXT:                          break;
+                                case Window::RESIZED:
+                                case Window::VIEWPORT_RESIZED:
+                                {
+                                    render_thread.synchronize ();
+                                    reset_viewport (window);
+                                    break;
+                                }
+                            }
                         }
-                    }
+                    );
 
                     if (current_scene)
                     {
                         bool  currently_active = state;
+                        bool  pipelined        = currently_active && pipelining && current_scene->is_pipelined ();
+
+                        // The scenes that aren't pipelined may use the graphics context anywhere, so
+                        // the render thread must give it back:
+
+                        if (!pipelined) render_thread.synchronize ();
 
                         if (!previously_active &&  currently_active) current_scene->resume  (); else
                         if ( previously_active && !currently_active) current_scene->suspend ();
@@ -224,43 +373,178 @@ namespace basics
                             float  h_ratio = float(scene_view_size.width ) / surface_width;
                             float  v_ratio = float(scene_view_size.height) / surface_height;
 
-                            while (event_queue.poll (event))
-                            {
-                                switch (event.id)
+                            event_queue.drain
+                            (
+                                [&] (Event & event)
                                 {
-                                    case ID(touch-started):
-                                    case ID(touch-moved):
-                                    case ID(touch-ended):
+                                    switch (event.id)
                                     {
-                                        float x = *event.properties[ID(x)].as< var::Float > ();
-                                        float y = *event.properties[ID(y)].as< var::Float > ();
+                                        case ID(touch-started):
+                                        case ID(touch-moved):
+                                        case ID(touch-ended):
+                                        {
+                                            float x = *event.properties[ID(x)].as< var::Float > ();
+                                            float y = *event.properties[ID(y)].as< var::Float > ();
+
+                                            event.properties[ID(x)] = x * h_ratio;
+                                            event.properties[ID(y)] = (surface_height - y) * v_ratio;
+
+                                            break;
+                                        }
+                                    }
 
-                                        event.properties[ID(x)] = x * h_ratio;
-                                        event.properties[ID(y)] = (surface_height - y) * v_ratio;
+                                    BASICS_PROFILE_ZONE ("handle");
 
-                                        break;
-                                    }
+                                    current_scene->handle (event);
+                                }
+                            );
+
+                            if (!touches.frame->empty ())
+                            {
+                                for (auto & touch : *touches.frame)
+                                {
+                                    touch.x = touch.x * h_ratio;
+                                    touch.y = (surface_height - touch.y) * v_ratio;
+
+                                    if (input_time == 0 || touch.time < input_time) input_time = touch.time;
                                 }
 
-                                current_scene->handle (event);
+                                BASICS_PROFILE_ZONE ("handle_touches");
+
+                                current_scene->handle_touches (*touches.frame);
                             }
 
-                            current_scene->update (time);
+                            // The scenes that have a frame rate are updated with a fixed step as
+                            // many times as fit in the time elapsed and the remainder is carried to
+                            // the next frame. The steps that exceed the limit are dropped:
+
+                            float step  = current_scene->get_frame_duration ();
+                            float alpha = 1.f;
 
-                            Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+                            stage_timer.reset ();
 
-                            if (graphics_context)
+                            if (step > 0.f)
                             {
-                                if (reset_canvas)
+                                int max_steps = current_scene->get_max_catch_up_steps ();
+
+                                accumulated += time;
+
+                                for (int steps = 0; accumulated >= step && steps < max_steps; ++steps)
                                 {
-                                    Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+                                    BASICS_PROFILE_ZONE ("update");
+
+                                    current_scene->update (step);
 
-                                    if (canvas) canvas->reset_state ();
+                                    accumulated -= step;
                                 }
 
-                                current_scene->render (graphics_context);
+                                if (accumulated >= step) accumulated = std::fmod (accumulated, step);
+
+                                alpha = accumulated / step;
+                            }
+                            else
+                            {
+                                BASICS_PROFILE_ZONE ("update");
+
+                                current_scene->update (time);
+                            }
+
+                            update_time = stage_timer.get_elapsed_seconds () * 1000.f;
+
+                            // The font of the overlay needs the graphics context to be loaded:
+
+                            if (overlay.visible && overlay.panel.needs_font ())
+                            {
+                                render_thread.synchronize ();
+
+                                Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+                                if (graphics_context) overlay.panel.load_font (graphics_context);
+                            }
+
+                            if (pipelined)
+                            {
+                                // The frame is recorded and handed over to the render thread, which
+                                // presents it while the next one is updated:
+
+                                stage_timer.reset ();
+
+                                {
+                                    BASICS_PROFILE_ZONE ("record");
+
+                                    Canvas & render_queue = render_thread.get_render_queue ();
+
+                                    current_scene->record (render_queue, alpha);
+
+                                    if (overlay.visible) overlay.panel.draw (render_queue, scene_view_size, frame_statistics, frame_arena);
+                                }
+
+                                render_time = stage_timer.get_elapsed_seconds () * 1000.f;
+
+                                stage_timer.reset ();
+
+                                render_thread.submit (window_handle, scene_view_size, reset_canvas, input_time);
+
+                                swap_time = stage_timer.get_elapsed_seconds () * 1000.f;
+                                rendered  = true;
+                            }
+                            else
+                            {
+                                Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+                                if (graphics_context)
+                                {
+                                    Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+
+                                    if (reset_canvas && canvas) canvas->reset_state ();
+
+                                    stage_timer.reset ();
+
+                                    {
+                                        BASICS_PROFILE_ZONE ("render");
+
+                                        current_scene->render (graphics_context, alpha);
+
+                                        // The scene may have created the canvas:
+
+                                        canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+
+                                        if (overlay.visible && canvas) overlay.panel.draw (*canvas, scene_view_size, frame_statistics, frame_arena);
+                                    }
+
+                                    render_time = stage_timer.get_elapsed_seconds () * 1000.f;
+
+                                    stage_timer.reset ();
+
+                                    {
+                                        BASICS_PROFILE_ZONE ("flush_and_display");
+
+                                        if (canvas) canvas->flush ();
+
+                                        graphics_context->flush_and_display ();
+                                    }
+
+                                    if (canvas)
+                                    {
+                                        canvas_frame_stats = canvas->get_frame_stats ();
 
-                                graphics_context->flush_and_display ();
+                                        canvas->reset_frame_stats ();
+                                    }
+
+                                    swap_time = stage_timer.get_elapsed_seconds () * 1000.f;
+                                    rendered  = true;
+
+                                    if (input_time != 0)
+                                    {
+                                        int64_t presentation_time = std::chrono::duration_cast< std::chrono::nanoseconds >
+                                        (
+                                            std::chrono::steady_clock::now ().time_since_epoch ()
+                                        )
+                                        .count ();
+
+                                        frame_statistics.add_latency (float(presentation_time - input_time) / 1e6f);
+                                    }
+                                }
                             }
                         }
                     }
@@ -268,9 +552,37 @@ namespace basics
             }
 
             time = timer.get_elapsed_seconds ();
+
+            if (rendered)
+            {
+                frame_statistics.add_frame (time * 1000.f, update_time, render_time, swap_time);
+            }
+
+            // The render thread tells the latency of the frames with touches once they have been
+            // presented:
+
+            int64_t input_latency = render_thread.take_input_latency ();
+
+            if (input_latency >= 0) frame_statistics.add_latency (float(input_latency) / 1e6f);
+
+            render_thread.take_canvas_frame_stats (canvas_frame_stats);
+
+            // When a capture of the profiler ends, it's written once the render thread has ended
+            // the zones of the last frame:
+
+            if (profiler.end_frame (frame_start))
+            {
+                render_thread.synchronize ();
+
+                profiler.write_capture ();
+            }
         }
         while (!kernel.exit && current_scene);
 
+        render_thread.stop ();
+
+        if (report_frame_statistics) log_frame_statistics ();
+
         if (current_scene)
         {
             current_scene->finalize ();
@@ -0,0 +1,127 @@
+/*
+ * FRAME STATISTICS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803051030
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <basics/Frame_Statistics>
+
+namespace basics
+{
+
+    Frame_Statistics::Frame_Statistics()
+    {
+        vsync_period = 1000.f / 60.f;
+
+        reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::add_frame (float frame, float update, float render, float swap)
+    {
+        // The index of the new frame in the FRAME ring is taken before adding it:
+
+        size_t index  = rings[FRAME].next;
+        float  missed = std::round (frame / vsync_period) - 1.f;
+
+        missed_vsyncs[index] = uint8_t(std::min (std::max (missed, 0.f), 255.f));
+
+        add (rings[FRAME ], frame );
+        add (rings[UPDATE], update);
+        add (rings[RENDER], render);
+        add (rings[SWAP  ], swap  );
+
+        total_frames++;
+        total_missed_vsyncs += missed_vsyncs[index];
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::add_latency (float latency)
+    {
+        add (rings[LATENCY], latency);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::reset ()
+    {
+        for (auto & ring : rings)
+        {
+            ring.count = 0;
+            ring.next  = 0;
+        }
+
+        total_frames        = 0;
+        total_missed_vsyncs = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Statistics::Summary Frame_Statistics::get_summary (Metric metric) const
+    {
+        const Ring & ring    = rings[metric];
+        Summary      summary = { ring.count, 0.f, 0.f, 0.f, 0.f, 0.f };
+
+        if (ring.count == 0) return summary;
+
+        float  sorted[window_size];
+        double sum = 0.0;
+
+        for (size_t index = 0; index < ring.count; ++index)
+        {
+            sum += sorted[index] = ring.samples[index];
+        }
+
+        std::sort (sorted, sorted + ring.count);
+
+        auto percentile = [&sorted, &ring] (float fraction)
+        {
+            size_t rank = size_t(std::ceil (fraction * float(ring.count)));
+
+            return sorted[rank > 0 ? rank - 1 : 0];
+        };
+
+        summary.mean = float(sum / double(ring.count));
+        summary.p50  = percentile (.50f);
+        summary.p95  = percentile (.95f);
+        summary.p99  = percentile (.99f);
+        summary.max  = sorted[ring.count - 1];
+
+        return summary;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Frame_Statistics::get_missed_vsyncs () const
+    {
+        unsigned missed = 0;
+
+        for (size_t index = 0; index < rings[FRAME].count; ++index)
+        {
+            missed += missed_vsyncs[index];
+        }
+
+        return missed;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::add (Ring & ring, float sample)
+    {
+        ring.samples[ring.next] = sample;
+        ring.next               = (ring.next + 1) % window_size;
+
+        if (ring.count < window_size) ring.count++;
+    }
+
+}
@@ -0,0 +1,170 @@
+/*
+ * PERFORMANCE OVERLAY
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803051130
+ */
+
+#include <algorithm>
+#include <cwchar>
+#include <basics/Log>
+#include <basics/Performance_Overlay>
+#include <basics/Text_Layout>
+#include <basics/Transformation>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Sizes for a canvas 720 units high, which are scaled to the actual height:
+
+        const float reference_height = 720.f;
+        const float margin           =   8.f;
+        const float bar_width        =   2.f;
+        const float graph_height     =  80.f;
+
+        // -----------------------------------------------------------------------------------------
+
+        size_t print_summary (wchar_t * buffer, size_t size, const wchar_t * name, const Frame_Statistics::Summary & summary)
+        {
+            int length = summary.count == 0
+                ? std::swprintf (buffer, size, L"%-8ls -\n", name)
+                : std::swprintf
+                  (
+                      buffer, size, L"%-8ls p50 %5.1f  p95 %5.1f  p99 %5.1f  max %5.1f\n",
+                      name, summary.p50, summary.p95, summary.p99, summary.max
+                  );
+
+            return length > 0 ? size_t(length) : 0;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Performance_Overlay::load_font (Graphics_Context::Accessor & context)
+    {
+        font.reset (new Raster_Font(font_path, context));
+
+        if (!font->good ())
+        {
+            log.w ("the font of the performance overlay couldn't be loaded: " + font_path);
+
+            font.reset ();
+
+            font_failed = true;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Performance_Overlay::draw (Canvas & canvas, const Size2u & canvas_size, const Frame_Statistics & statistics, Frame_Arena & arena)
+    {
+        if (!font)
+        {
+            draw_panel (canvas, canvas_size, statistics, nullptr);
+
+            return;
+        }
+
+        wchar_t buffer[512];
+        size_t  length = 0;
+
+        length += print_summary (buffer + length, 512 - length, L"frame",   statistics.get_summary (Frame_Statistics::FRAME  ));
+        length += print_summary (buffer + length, 512 - length, L"update",  statistics.get_summary (Frame_Statistics::UPDATE ));
+        length += print_summary (buffer + length, 512 - length, L"render",  statistics.get_summary (Frame_Statistics::RENDER ));
+        length += print_summary (buffer + length, 512 - length, L"swap",    statistics.get_summary (Frame_Statistics::SWAP   ));
+        length += print_summary (buffer + length, 512 - length, L"latency", statistics.get_summary (Frame_Statistics::LATENCY));
+
+        std::swprintf
+        (
+            buffer + length, 512 - length, L"missed vsyncs %u (%llu in total)",
+            statistics.get_missed_vsyncs (), (unsigned long long)statistics.get_total_missed_vsyncs ()
+        );
+
+        // The layout only lives during this frame, so its glyphs are taken from the arena:
+
+        Text_Layout text(*font, buffer, arena);
+
+        draw_panel (canvas, canvas_size, statistics, &text);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Performance_Overlay::draw_panel (Canvas & canvas, const Size2u & canvas_size, const Frame_Statistics & statistics, const Text_Layout * text)
+    {
+        float scale       = float(canvas_size.height) / reference_height;
+        float gap         = margin * scale;
+        float graph_w     = float(graph_frames) * bar_width * scale;
+        float graph_h     = graph_height * scale;
+        float period      = statistics.get_vsync_period () * 1000.f;
+        float ms_to_units = graph_h / (3.f * period);           // Three periods fill the graph
+
+        // The panel is placed at the top left corner and contains the graph and the text below it:
+
+        float panel_w     = graph_w + 2.f * gap;
+        float panel_h     = graph_h + 2.f * gap;
+
+        if (text)
+        {
+            panel_w  = std::max (panel_w, text->get_width () + 2.f * gap);
+            panel_h += text->get_height () + gap;
+        }
+
+        float left         = gap;
+        float top          = float(canvas_size.height) - gap;
+        float graph_left   = left + gap;
+        float graph_bottom = top  - gap - graph_h;
+
+        canvas.set_transform  (Transformation2f());
+
+        canvas.set_color      (0.f, 0.f, 0.f);
+        canvas.set_opacity    (.6f);
+        canvas.fill_rectangle ({ left, top - panel_h }, { panel_w, panel_h });
+        canvas.set_opacity    (1.f);
+
+        // Graph of the frame times, with the newest frame on the right:
+
+        size_t frames = std::min (statistics.get_count (Frame_Statistics::FRAME), size_t(graph_frames));
+        int    color  = -1;
+
+        for (size_t age = 0; age < frames; ++age)
+        {
+            float time      = statistics.get_sample (Frame_Statistics::FRAME, age);
+            int   new_color = time <= period * 1.05f ? 0 : time <= period * 2.05f ? 1 : 2;
+
+            if (new_color != color)
+            {
+                static const float colors[3][3] = { { .2f, .9f, .2f }, { .9f, .8f, .1f }, { .9f, .2f, .2f } };
+
+                color = new_color;
+
+                canvas.set_color (colors[color][0], colors[color][1], colors[color][2]);
+            }
+
+            canvas.fill_rectangle
+            (
+                { graph_left + float(graph_frames - 1 - age) * bar_width * scale, graph_bottom },
+                { bar_width * scale, std::min (time * ms_to_units, graph_h) }
+            );
+        }
+
+        // Mark of the vsync period:
+
+        canvas.set_color      (1.f, 1.f, 1.f);
+        canvas.fill_rectangle ({ graph_left, graph_bottom + period * ms_to_units }, { graph_w, scale });
+
+        if (text)
+        {
+            canvas.draw_text ({ graph_left, graph_bottom - gap }, *text, TOP | LEFT);
+        }
+    }
+
+}
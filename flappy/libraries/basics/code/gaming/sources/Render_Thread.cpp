@@ -0,0 +1,261 @@
+/*
+ * RENDER THREAD
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803011130
+ */
+
+#include <chrono>
+#include <basics/Canvas>
+#include <basics/Profiler>
+#include <basics/Render_Thread>
+
+namespace basics
+{
+
+    Render_Thread::Render_Thread()
+    {
+        recording          = 0;
+        reset_canvas       = false;
+        input_time         = 0;
+        input_latency      = -1;
+        canvas_stats       = Canvas::Frame_Stats();
+        canvas_stats_ready = false;
+        busy               = false;
+        owns_context       = false;
+        release            = false;
+        exit               = false;
+        presented_frames   = 0;
+        failed_frames      = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::submit (const Window::Handle & window, const Size2u & canvas_size, bool reset_canvas, int64_t input_time)
+    {
+        BASICS_PROFILE_ZONE ("submit");
+
+        std::unique_lock< std::mutex > lock(mutex);
+
+        condition.wait (lock, [this] () { return !busy; });
+
+        this->window       = window;
+        this->canvas_size  = canvas_size;
+        this->reset_canvas = reset_canvas;
+        this->input_time   = input_time;
+
+        if (!owns_context)
+        {
+            // The calling thread has to release the context before the render thread can make it
+            // current:
+
+            Window::Accessor window_accessor = this->window.lock ();
+
+            if (window_accessor)
+            {
+                Graphics_Context::Accessor context = window_accessor->lock_graphics_context ();
+
+                if (context) context->release_current ();
+            }
+        }
+
+        // The other queue was presented two frames ago, so it can be recorded again starting with
+        // the state in which the submitted one was left:
+
+        Render_Queue & submitted = queues[recording];
+
+        recording ^= 1;
+
+        queues[recording].discard    ();
+        queues[recording].copy_state (submitted);
+
+        busy = true;
+
+        if (!thread.joinable ())
+        {
+            thread = std::thread(&Render_Thread::run, this);
+        }
+
+        condition.notify_all ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::synchronize ()
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+
+        condition.wait (lock, [this] () { return !busy; });
+
+        if (owns_context)
+        {
+            release = true;
+
+            condition.notify_all ();
+            condition.wait (lock, [this] () { return !release; });
+
+            lock.unlock ();
+
+            Window::Accessor window_accessor = window.lock ();
+
+            if (window_accessor)
+            {
+                Graphics_Context::Accessor context = window_accessor->lock_graphics_context ();
+
+                if (context) context->make_current ();
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::stop ()
+    {
+        synchronize ();
+
+        if (thread.joinable ())
+        {
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                exit = true;
+
+                condition.notify_all ();
+            }
+
+            thread.join ();
+
+            exit = false;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::run ()
+    {
+        Profiler::set_thread_name ("render");
+
+        std::unique_lock< std::mutex > lock(mutex);
+
+        for (;;)
+        {
+            condition.wait (lock, [this] () { return busy || release || exit; });
+
+            if (busy)
+            {
+                Render_Queue & queue = queues[recording ^ 1];
+
+                lock.unlock ();
+
+                present (queue);
+
+                lock.lock ();
+
+                busy = false;
+            }
+            else
+            if (release)
+            {
+                lock.unlock ();
+
+                Window::Accessor window_accessor = window.lock ();
+
+                if (window_accessor)
+                {
+                    Graphics_Context::Accessor context = window_accessor->lock_graphics_context ();
+
+                    if (context) context->release_current ();
+                }
+
+                lock.lock ();
+
+                owns_context = false;
+                release      = false;
+            }
+            else
+                break;
+
+            condition.notify_all ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    // The render thread is the only one that changes owns_context while it's busy, so it can read
+    // it without locking:
+
+    void Render_Thread::present (Render_Queue & queue)
+    {
+        BASICS_PROFILE_ZONE ("present");
+
+        Window::Accessor    window_accessor = window.lock ();
+        bool                presented       = false;
+        bool                acquired        = owns_context;
+        bool                replayed        = false;
+        Canvas::Frame_Stats stats;
+
+        if (window_accessor)
+        {
+            Graphics_Context::Accessor context = window_accessor->lock_graphics_context ();
+
+            if (context && (acquired || context->make_current ()))
+            {
+                acquired = true;
+
+                Canvas * canvas = context->get_renderer< Canvas > (ID(canvas));
+
+                if (!canvas)
+                {
+                    canvas = Canvas::create (ID(canvas), context, { canvas_size });
+                }
+                else
+                if (reset_canvas)
+                {
+                    canvas->reset_state ();
+                }
+
+                if (canvas)
+                {
+                    BASICS_PROFILE_ZONE ("replay");
+
+                    queue.replay (*canvas);
+
+                    canvas->flush ();
+
+                    // The frame ends here for the canvas, as the Director does in serial mode:
+
+                    stats    = canvas->get_frame_stats ();
+                    replayed = true;
+
+                    canvas->reset_frame_stats ();
+                }
+
+                BASICS_PROFILE_ZONE ("flush_and_display");
+
+                presented = context->flush_and_display ();
+            }
+        }
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        owns_context = acquired;
+
+        if (presented) presented_frames++; else failed_frames++;
+
+        if (replayed)
+        {
+            canvas_stats       = stats;
+            canvas_stats_ready = true;
+        }
+
+        if (presented && input_time != 0)
+        {
+            input_latency = std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now ().time_since_epoch ()).count () - input_time;
+        }
+    }
+
+}
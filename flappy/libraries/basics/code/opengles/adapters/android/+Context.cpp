@@ -35,7 +35,14 @@
 
                 if (context->is_available () && window->set_graphics_context (context))
                 {
-                    return context->make_current ();
+                    if (context->make_current ())
+                    {
+                        // Se reconstruyen los recursos que quedasen de un contexto anterior:
+
+                        context->initialize ();
+
+                        return true;
+                    }
                 }
             }
 
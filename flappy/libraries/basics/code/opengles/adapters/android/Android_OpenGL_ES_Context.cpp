@@ -103,7 +103,22 @@
         {
             if (available)
             {
-                return eglMakeCurrent (display, surface, surface, context) == EGL_TRUE;
+                if (eglMakeCurrent (display, surface, surface, context) == EGL_TRUE)
+                {
+                    render_state.make_current ();
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool Android_OpenGL_ES_Context::release_current ()
+        {
+            if (display != EGL_NO_DISPLAY)
+            {
+                return eglMakeCurrent (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE;
             }
 
             return false;
@@ -250,6 +265,8 @@
             {
                 eglDestroyContext (display, context);
 
+                render_state.invalidate ();
+
                 context  = EGL_NO_CONTEXT;
             }
         }
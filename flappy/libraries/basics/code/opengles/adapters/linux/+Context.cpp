@@ -0,0 +1,76 @@
+/*
+ * OPENGL ES CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802121855
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdlib>
+    #include <cstring>
+    #include <basics/enable>
+    #include <basics/Log>
+    #include <basics/software/Context>
+    #include <basics/software/Software>
+    #include "Linux_OpenGL_ES_Context.hpp"
+    #include "../../../base/adapters/linux/Offscreen_Window.hpp"
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * When BASICS_GRAPHICS is "software" or there's no usable EGL implementation, the window
+         * gets a software::Context instead, so that the applications that only enable the OpenGL ES
+         * backend (as main() usually does) still run on any host.
+         */
+        bool Context::create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
+        {
+            if (window && window->is_available () && !window->has_graphics_context ())
+            {
+                const char * graphics = std::getenv ("BASICS_GRAPHICS");
+
+                if (!graphics || std::strcmp (graphics, "software") != 0)
+                {
+                    std::shared_ptr< Graphics_Context > context
+                    (
+                        new basics::opengles::internal::Linux_OpenGL_ES_Context
+                        (
+                            *static_cast< basics::internal::Offscreen_Window::Accessor & >(window).get (),
+                             cache
+                        )
+                    );
+
+                    if (context->is_available ())
+                    {
+                        if (window->set_graphics_context (context) && context->make_current ())
+                        {
+                            // The resources left by a previous context are rebuilt:
+
+                            context->initialize ();
+
+                            return true;
+                        }
+
+                        return false;
+                    }
+
+                    log.w ("OpenGL ES is not available: falling back to the software renderer.");
+                }
+
+                return enable< basics::Software > () && software::Context::create (window, cache);
+            }
+
+            return false;
+        }
+
+    }}
+
+#endif
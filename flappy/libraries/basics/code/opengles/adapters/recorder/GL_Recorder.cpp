@@ -0,0 +1,449 @@
+/*
+ * GL RECORDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803061030
+ */
+
+// This file isn't part of basics-opengles: it replaces the functions of libGLESv2 in the programs
+// that link basics-opengles-recorder.
+
+#include <cstring>
+#include <basics/opengles/Context>
+#include <basics/opengles/GL_Recorder>
+
+namespace basics { namespace opengles
+{
+
+    namespace internal
+    {
+
+        /**
+         * Context without native surface whose calls go to the GL_Recorder. It's always available
+         * and current, so the Director and the render thread can hand it over as a real one.
+         */
+        class Recording_Context final : public opengles::Context
+        {
+
+            unsigned surface_width;
+            unsigned surface_height;
+
+        public:
+
+            Recording_Context(basics::Window & window, Graphics_Resource_Cache * cache) : opengles::Context(window, cache)
+            {
+                surface_width  = window.get_width  ();
+                surface_height = window.get_height ();
+                version        = VERSION_2_0;
+            }
+
+        public:
+
+            bool is_available () const override { return true; }
+            bool is_current   () const override { return true; }
+
+            void invalidate () override { }
+            void suspend    () override { }
+            bool resume     () override { return true; }
+
+            bool make_current () override
+            {
+                render_state.make_current ();
+
+                return true;
+            }
+
+            bool release_current () override
+            {
+                return true;
+            }
+
+            bool set_sync_swap (bool ) override
+            {
+                return true;
+            }
+
+            bool flush_and_display () override
+            {
+                GL_Recorder::get_instance ().record ("eglSwapBuffers");
+
+                return true;
+            }
+
+            unsigned get_surface_width () override
+            {
+                return surface_width;
+            }
+
+            unsigned get_surface_height () override
+            {
+                return surface_height;
+            }
+
+            void reset_viewport () override
+            {
+                glViewport (0, 0, GLsizei(surface_width), GLsizei(surface_height));
+            }
+
+            void set_viewport (const Point2u & bottom_left, const Size2u & size) override
+            {
+                glViewport (GLint(bottom_left[0]), GLint(bottom_left[1]), GLsizei(size.width), GLsizei(size.height));
+            }
+
+        };
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    GL_Recorder & GL_Recorder::get_instance ()
+    {
+        static GL_Recorder instance;
+
+        return instance;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool GL_Recorder::create_context (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
+    {
+        if (window && window->is_available () && !window->has_graphics_context ())
+        {
+            std::shared_ptr< Graphics_Context > context(new internal::Recording_Context(*window.operator -> (), cache));
+
+            if (window->set_graphics_context (context) && context->make_current ())
+            {
+                context->initialize ();
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    GL_Recorder::GL_Recorder()
+    {
+        recording     = true;
+        last_name     = 0;
+        last_location = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t GL_Recorder::count (const char * function) const
+    {
+        size_t count = 0;
+
+        for (auto & call : calls)
+        {
+            if (std::strcmp (call.function, function) == 0) count++;
+        }
+
+        return count;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void GL_Recorder::write (std::ostream & output) const
+    {
+        for (auto & call : calls)
+        {
+            output << call.function << " (";
+
+            for (unsigned index = 0; index < call.argument_count; ++index)
+            {
+                output << (index > 0 ? ", " : "") << call.arguments[index];
+            }
+
+            output << ")\n";
+        }
+    }
+
+}}
+
+// -------------------------------------------------------------------------------------------------
+// Entry points of OpenGL ES 2.0 used by the library. The objects get consecutive names, the shaders
+// always compile and link, and every state change is just recorded:
+
+using basics::opengles::GL_Recorder;
+
+namespace
+{
+
+    GL_Recorder & recorder = GL_Recorder::get_instance ();
+
+    void generate_names (GLsizei count, GLuint * names)
+    {
+        for (GLsizei index = 0; index < count; ++index)
+        {
+            names[index] = recorder.generate_name ();
+        }
+    }
+
+}
+
+void GL_APIENTRY glActiveTexture (GLenum texture)
+{
+    recorder.record ("glActiveTexture", texture);
+}
+
+void GL_APIENTRY glAttachShader (GLuint program, GLuint shader)
+{
+    recorder.record ("glAttachShader", program, shader);
+}
+
+void GL_APIENTRY glBindAttribLocation (GLuint program, GLuint index, const GLchar * )
+{
+    recorder.record ("glBindAttribLocation", program, index);
+}
+
+void GL_APIENTRY glBindBuffer (GLenum target, GLuint buffer)
+{
+    recorder.record ("glBindBuffer", target, buffer);
+}
+
+void GL_APIENTRY glBindTexture (GLenum target, GLuint texture)
+{
+    recorder.record ("glBindTexture", target, texture);
+}
+
+void GL_APIENTRY glBlendFunc (GLenum source_factor, GLenum destination_factor)
+{
+    recorder.record ("glBlendFunc", source_factor, destination_factor);
+}
+
+void GL_APIENTRY glBufferData (GLenum target, GLsizeiptr size, const void * , GLenum usage)
+{
+    recorder.record ("glBufferData", target, size, usage);
+}
+
+void GL_APIENTRY glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void * )
+{
+    recorder.record ("glBufferSubData", target, offset, size);
+}
+
+void GL_APIENTRY glClear (GLbitfield mask)
+{
+    recorder.record ("glClear", mask);
+}
+
+void GL_APIENTRY glClearColor (GLfloat , GLfloat , GLfloat , GLfloat )
+{
+    recorder.record ("glClearColor");
+}
+
+void GL_APIENTRY glCompileShader (GLuint shader)
+{
+    recorder.record ("glCompileShader", shader);
+}
+
+GLuint GL_APIENTRY glCreateProgram ()
+{
+    GLuint program = recorder.generate_name ();
+
+    recorder.record ("glCreateProgram", program);
+
+    return program;
+}
+
+GLuint GL_APIENTRY glCreateShader (GLenum type)
+{
+    GLuint shader = recorder.generate_name ();
+
+    recorder.record ("glCreateShader", type, shader);
+
+    return shader;
+}
+
+void GL_APIENTRY glDeleteBuffers (GLsizei count, const GLuint * )
+{
+    recorder.record ("glDeleteBuffers", count);
+}
+
+void GL_APIENTRY glDeleteProgram (GLuint program)
+{
+    recorder.record ("glDeleteProgram", program);
+}
+
+void GL_APIENTRY glDeleteShader (GLuint shader)
+{
+    recorder.record ("glDeleteShader", shader);
+}
+
+void GL_APIENTRY glDeleteTextures (GLsizei count, const GLuint * )
+{
+    recorder.record ("glDeleteTextures", count);
+}
+
+void GL_APIENTRY glDisable (GLenum capability)
+{
+    recorder.record ("glDisable", capability);
+}
+
+void GL_APIENTRY glDisableVertexAttribArray (GLuint index)
+{
+    recorder.record ("glDisableVertexAttribArray", index);
+}
+
+void GL_APIENTRY glDrawArrays (GLenum mode, GLint first, GLsizei count)
+{
+    recorder.record ("glDrawArrays", mode, first, count);
+}
+
+void GL_APIENTRY glDrawElements (GLenum mode, GLsizei count, GLenum type, const void * )
+{
+    recorder.record ("glDrawElements", mode, count, type);
+}
+
+void GL_APIENTRY glEnable (GLenum capability)
+{
+    recorder.record ("glEnable", capability);
+}
+
+void GL_APIENTRY glEnableVertexAttribArray (GLuint index)
+{
+    recorder.record ("glEnableVertexAttribArray", index);
+}
+
+void GL_APIENTRY glGenBuffers (GLsizei count, GLuint * buffers)
+{
+    generate_names (count, buffers);
+
+    recorder.record ("glGenBuffers", count);
+}
+
+void GL_APIENTRY glGenTextures (GLsizei count, GLuint * textures)
+{
+    generate_names (count, textures);
+
+    recorder.record ("glGenTextures", count);
+}
+
+GLint GL_APIENTRY glGetAttribLocation (GLuint program, const GLchar * )
+{
+    return recorder.get_attribute_location (program);
+}
+
+GLenum GL_APIENTRY glGetError ()
+{
+    return GL_NO_ERROR;
+}
+
+void GL_APIENTRY glGetProgramiv (GLuint , GLenum name, GLint * value)
+{
+    *value = name == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+void GL_APIENTRY glGetShaderInfoLog (GLuint , GLsizei size, GLsizei * length, GLchar * log)
+{
+    if (length  ) *length = 0;
+    if (size > 0) *log    = 0;
+}
+
+void GL_APIENTRY glGetShaderiv (GLuint , GLenum name, GLint * value)
+{
+    *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+GLint GL_APIENTRY glGetUniformLocation (GLuint , const GLchar * )
+{
+    return recorder.get_uniform_location ();
+}
+
+void GL_APIENTRY glLinkProgram (GLuint program)
+{
+    recorder.record ("glLinkProgram", program);
+}
+
+void GL_APIENTRY glPixelStorei (GLenum name, GLint value)
+{
+    recorder.record ("glPixelStorei", name, value);
+}
+
+void GL_APIENTRY glShaderSource (GLuint shader, GLsizei count, const GLchar * const * , const GLint * )
+{
+    recorder.record ("glShaderSource", shader, count);
+}
+
+void GL_APIENTRY glTexImage2D (GLenum , GLint level, GLint , GLsizei width, GLsizei height, GLint , GLenum , GLenum , const void * )
+{
+    recorder.record ("glTexImage2D", level, width, height);
+}
+
+void GL_APIENTRY glTexParameteri (GLenum , GLenum name, GLint value)
+{
+    recorder.record ("glTexParameteri", name, value);
+}
+
+void GL_APIENTRY glUniform1f (GLint location, GLfloat )
+{
+    recorder.record ("glUniform1f", location);
+}
+
+void GL_APIENTRY glUniform1i (GLint location, GLint value)
+{
+    recorder.record ("glUniform1i", location, value);
+}
+
+void GL_APIENTRY glUniform2f (GLint location, GLfloat , GLfloat )
+{
+    recorder.record ("glUniform2f", location);
+}
+
+void GL_APIENTRY glUniform3f (GLint location, GLfloat , GLfloat , GLfloat )
+{
+    recorder.record ("glUniform3f", location);
+}
+
+void GL_APIENTRY glUniform4f (GLint location, GLfloat , GLfloat , GLfloat , GLfloat )
+{
+    recorder.record ("glUniform4f", location);
+}
+
+void GL_APIENTRY glUniformMatrix2fv (GLint location, GLsizei count, GLboolean , const GLfloat * )
+{
+    recorder.record ("glUniformMatrix2fv", location, count);
+}
+
+void GL_APIENTRY glUniformMatrix3fv (GLint location, GLsizei count, GLboolean , const GLfloat * )
+{
+    recorder.record ("glUniformMatrix3fv", location, count);
+}
+
+void GL_APIENTRY glUniformMatrix4fv (GLint location, GLsizei count, GLboolean , const GLfloat * )
+{
+    recorder.record ("glUniformMatrix4fv", location, count);
+}
+
+void GL_APIENTRY glUseProgram (GLuint program)
+{
+    recorder.record ("glUseProgram", program);
+}
+
+void GL_APIENTRY glVertexAttrib1f (GLuint index, GLfloat )
+{
+    recorder.record ("glVertexAttrib1f", index);
+}
+
+void GL_APIENTRY glVertexAttrib4f (GLuint index, GLfloat , GLfloat , GLfloat , GLfloat )
+{
+    recorder.record ("glVertexAttrib4f", index);
+}
+
+void GL_APIENTRY glVertexAttribPointer (GLuint index, GLint size, GLenum , GLboolean , GLsizei stride, const void * )
+{
+    recorder.record ("glVertexAttribPointer", index, size, stride);
+}
+
+void GL_APIENTRY glViewport (GLint , GLint , GLsizei width, GLsizei height)
+{
+    recorder.record ("glViewport", width, height);
+}
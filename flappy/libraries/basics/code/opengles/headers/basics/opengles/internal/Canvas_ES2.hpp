@@ -14,16 +14,41 @@
 #define BASICS_OPENGLES_CANVAS_ES2_HEADER
 
     #include <memory>
+    #include <vector>
     #include <basics/Canvas>
     #include <basics/Transformation>
+    #include <basics/opengles/OpenGL_ES2>
 
     namespace basics { namespace opengles
     {
 
         class Shader_Program;
+        class Texture_2D;
 
         class Canvas_ES2 : public basics::Canvas
         {
+        private:
+
+            /**
+             * Vertex format used by the batcher. The color holds the RGB tint and the opacity, so
+             * that changing them does not break the batch.
+             */
+            struct Vertex
+            {
+                float x, y;
+                float u, v;
+                byte  color[4];
+            };
+
+            enum Batch_Kind
+            {
+                EMPTY,
+                FLAT,
+                TEXTURED
+            };
+
+            static constexpr unsigned max_batched_quads = 1024;
+
         private:
 
             static const char * internal_vertex_shader_f;
@@ -49,31 +74,62 @@
 
             Transformation2f transform;
             Transformation2f projection;
+            Transformation2f projected_transform;           ///< projection * transform, uploaded as a single uniform.
+            bool             projected_transform_dirty;
 
             std::shared_ptr< Shader_Program > shader_program_f;
             std::shared_ptr< Shader_Program > shader_program_t;
 
-            int  transform_f_id;
-            int projection_f_id;
-            int      color_f_id;
-            int    opacity_f_id;
-            int  transform_t_id;
-            int projection_t_id;
-            int    sampler_t_id;
-            int    opacity_t_id;
+            int transform_f_id;
+            int transform_t_id;
+            int   sampler_t_id;
 
             unsigned   vertex_position_location_f;
+            unsigned      vertex_color_location_f;
             unsigned   vertex_position_location_t;
             unsigned vertex_texture_uv_location_t;
+            unsigned      vertex_color_location_t;
+
+            byte     color[4];
+
+            struct
+            {
+                bool                         enabled;
+                Batch_Kind                   kind;
+                const opengles::Texture_2D * texture;
+                std::vector< Vertex >        vertices;
+                GLuint                       vertex_buffer;
+                GLuint                       index_buffer;
+            }
+            batch;
 
         public:
 
             Canvas_ES2(Graphics_Context::Accessor & context, const Size2u & viewport_size);
+           ~Canvas_ES2();
 
         public:
 
             void reset_state     () override;
 
+        public:
+
+            /**
+             * Enables or disables merging consecutive quads into a single draw call. When batching
+             * is disabled every quad is submitted as soon as it's drawn.
+             */
+            void set_batching (bool enabled)
+            {
+                flush_batch ();
+
+                batch.enabled = enabled;
+            }
+
+            bool is_batching () const
+            {
+                return batch.enabled;
+            }
+
         public:
 
             void set_size        (const Size2u & size) override;
@@ -83,6 +139,7 @@
             void set_clear_color (float r, float g, float b) override;
             void set_color       (float r, float g, float b) override;
             void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
             void set_transform   (const Transformation2f & transform) override;
             void apply_transform (const Transformation2f & transform) override;
 
@@ -97,6 +154,14 @@
             void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
+            void flush           () override;
+
+        private:
+
+            void     use_program    (const Shader_Program & program, int transform_id);
+            void     draw_immediate (const Point2f * coordinates, GLsizei count, GLenum mode);
+            Vertex * append_quad    (Batch_Kind kind, const opengles::Texture_2D * texture);
+            void     flush_batch    ();
 
         };
 
@@ -16,6 +16,7 @@
     #include <memory>
     #include <basics/Window>
     #include <basics/Graphics_Context>
+    #include <basics/opengles/Render_State>
 
     namespace basics { namespace opengles
     {
@@ -41,7 +42,8 @@
 
         protected:
 
-            Version version;
+            Version      version;
+            Render_State render_state;
 
         protected:
 
@@ -82,6 +84,11 @@
                 return version;
             }
 
+            Render_State & get_render_state ()
+            {
+                return render_state;
+            }
+
             Renderer * get_renderer ();
 
         };
@@ -0,0 +1,142 @@
+/*
+ * GL RECORDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803061000
+ */
+
+#ifndef BASICS_OPENGLES_GL_RECORDER_HEADER
+#define BASICS_OPENGLES_GL_RECORDER_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <map>
+    #include <ostream>
+    #include <vector>
+    #include <basics/Graphics_Resource_Cache>
+    #include <basics/Window>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Stand-in for the OpenGL ES 2.0 driver that draws nothing: it records the calls that it
+         * receives and answers the queries as a driver that accepts every shader would. It's built
+         * into the basics-opengles-recorder library, which defines the gl* functions, so that the
+         * programs that link it (tools and performance checks) can run the OpenGL ES backend and
+         * inspect what it sends to the driver on machines without GPU.
+         *
+         * Like a real context, it must only be used by one thread at a time.
+         */
+        class GL_Recorder
+        {
+        public:
+
+            struct Call
+            {
+                const char * function;                  ///< Name of the gl* function.
+                int64_t      arguments[3];              ///< Integer arguments that tell the calls apart.
+                unsigned     argument_count;
+            };
+
+        public:
+
+            static GL_Recorder & get_instance ();
+
+            /**
+             * Gives the window a context that uses the recorder. It has the signature of
+             * opengles::Context::create(), so it can be given to
+             * Director::set_graphics_context_factory() too.
+             */
+            static bool create_context (basics::Window::Accessor & window, Graphics_Resource_Cache * cache);
+
+        private:
+
+            std::vector< Call >       calls;
+            bool                      recording;
+            GLuint                    last_name;            ///< Of the objects created.
+            GLint                     last_location;        ///< Of the uniforms.
+            std::map< GLuint, GLint > attribute_counts;     ///< Attribute locations given to each program.
+
+        private:
+
+            GL_Recorder();
+
+        public:
+
+            template< typename ...ARGUMENTS >
+            void record (const char * function, ARGUMENTS... arguments)
+            {
+                static_assert (sizeof...(ARGUMENTS) <= 3, "at most 3 arguments are recorded");
+
+                if (recording)
+                {
+                    calls.push_back (Call{ function, { int64_t(arguments)... }, sizeof...(ARGUMENTS) });
+                }
+            }
+
+            GLuint generate_name ()
+            {
+                return ++last_name;
+            }
+
+            GLint get_uniform_location ()
+            {
+                return last_location++;
+            }
+
+            /**
+             * The attributes of each program get consecutive locations from 0.
+             */
+            GLint get_attribute_location (GLuint program)
+            {
+                return attribute_counts[program]++;
+            }
+
+        public:
+
+            /**
+             * The calls are recorded from the start. While recording is paused they're still
+             * answered, but not kept.
+             */
+            void set_recording (bool recording)
+            {
+                this->recording = recording;
+            }
+
+            bool is_recording () const
+            {
+                return recording;
+            }
+
+            void clear ()
+            {
+                calls.clear ();
+            }
+
+            const std::vector< Call > & get_calls () const
+            {
+                return calls;
+            }
+
+            /**
+             * Number of recorded calls to the given function (eg: "glDrawElements").
+             */
+            size_t count (const char * function) const;
+
+            /**
+             * Writes the recorded calls, one per line.
+             */
+            void write (std::ostream & output) const;
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * RENDER STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802051915
+ */
+
+#ifndef BASICS_OPENGLES_RENDER_STATE_HEADER
+#define BASICS_OPENGLES_RENDER_STATE_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Shadow copy of the OpenGL ES state that is changed on every draw call. Each context owns
+         * one and makes it current along with itself, so the setters only reach the driver when the
+         * requested value differs from the one that is already bound.
+         */
+        class Render_State
+        {
+        public:
+
+            static constexpr unsigned max_texture_units     = 8;        ///< Minimum guaranteed by OpenGL ES 2.0.
+            static constexpr unsigned max_vertex_attributes = 8;        ///< Minimum guaranteed by OpenGL ES 2.0.
+            static constexpr GLuint   unknown               = ~GLuint(0);
+
+        private:
+
+            static Render_State * current;
+
+        public:
+
+            /**
+             * Returns the state of the context that is current in this process. Before any context
+             * has been made current, a detached instance is returned so that calls are still safe.
+             */
+            static Render_State & get_current ()
+            {
+                static Render_State detached;
+
+                return current ? *current : detached;
+            }
+
+        private:
+
+            // Every value starts as unknown, which never matches a requested one:
+
+            GLuint   program;
+            GLenum   active_unit;
+            GLuint   textures[max_texture_units];
+            uint32_t enabled_attributes;
+            bool     attributes_known;
+            GLuint   array_buffer;
+            GLuint   element_array_buffer;
+            GLenum   blending;                              ///< GL_TRUE, GL_FALSE or unknown.
+            GLenum   blend_source;
+            GLenum   blend_destination;
+
+            size_t   uploaded_texture_bytes;                ///< Not yet taken by the canvas.
+
+        public:
+
+            Render_State()
+            {
+                invalidate ();
+
+                uploaded_texture_bytes = 0;
+            }
+
+            Render_State(const Render_State & ) = delete;
+
+           ~Render_State()
+            {
+                if (current == this) current = nullptr;
+            }
+
+        public:
+
+            /**
+             * Must be called after the native context has been bound to the calling thread.
+             */
+            void make_current ()
+            {
+                if (current != this) invalidate ();
+
+                current = this;
+            }
+
+            /**
+             * Forgets every shadowed value, so that the next calls reach the driver. It's required
+             * when the context is recreated or when code outside of this class has changed the state.
+             */
+            void invalidate ();
+
+        public:
+
+            /**
+             * Returns false when the program was already in use.
+             */
+            bool use_program (GLuint program_object_id)
+            {
+                if (program != program_object_id)
+                {
+                    glUseProgram (program = program_object_id);
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * Returns false when the texture was already bound to the given unit.
+             */
+            bool bind_texture (GLuint texture_object_id, unsigned unit = 0);
+
+            /**
+             * Enables the vertex attribute arrays whose bits are set in the mask and disables the
+             * rest, touching only the ones that changed.
+             */
+            void set_vertex_attribute_arrays (uint32_t mask);
+
+            void bind_array_buffer (GLuint buffer_object_id)
+            {
+                if (array_buffer != buffer_object_id)
+                {
+                    glBindBuffer (GL_ARRAY_BUFFER, array_buffer = buffer_object_id);
+                }
+            }
+
+            void bind_element_array_buffer (GLuint buffer_object_id)
+            {
+                if (element_array_buffer != buffer_object_id)
+                {
+                    glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, element_array_buffer = buffer_object_id);
+                }
+            }
+
+            void disable_blending ();
+            void enable_blending  (GLenum source_factor, GLenum destination_factor);
+
+        public:
+
+            /**
+             * The textures are uploaded outside of the canvas (usually while a scene loads them), so
+             * their bytes are kept here until the canvas adds them to the statistics of its frame.
+             */
+            void count_texture_upload (size_t bytes)
+            {
+                uploaded_texture_bytes += bytes;
+            }
+
+            size_t take_uploaded_texture_bytes ()
+            {
+                size_t bytes = uploaded_texture_bytes;
+
+                uploaded_texture_bytes = 0;
+
+                return bytes;
+            }
+
+        public:
+
+            /**
+             * The driver unbinds the objects that get deleted, so the shadow copy must follow.
+             */
+            void forget_program (GLuint program_object_id)
+            {
+                if (program == program_object_id) program = unknown;
+            }
+
+            void forget_texture (GLuint texture_object_id);
+
+            void forget_buffer  (GLuint buffer_object_id)
+            {
+                if (        array_buffer == buffer_object_id)         array_buffer = 0;
+                if (element_array_buffer == buffer_object_id) element_array_buffer = 0;
+            }
+
+        };
+
+    }}
+
+#endif
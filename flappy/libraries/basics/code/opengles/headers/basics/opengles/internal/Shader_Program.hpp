@@ -19,6 +19,7 @@
     #include <basics/Matrix>
     #include <basics/Point>
     #include <basics/Vector>
+    #include <basics/opengles/Render_State>
     #include <basics/opengles/Shader>
 
     namespace basics { namespace opengles
@@ -30,21 +31,26 @@
 
             typedef std::map< std::string, GLint > Uniform_Map;
 
+            /**
+             * Last value uploaded to a uniform location. Uniforms belong to the program object, so
+             * the cache stays valid while the program is not relinked.
+             */
+            struct Uniform_Value
+            {
+                GLint   location;
+                GLsizei size;
+                GLubyte bytes[sizeof(Matrix44f::values)];
+            };
+
         private:
 
-            static const Shader_Program * active_shader_program;
-            static       unsigned         instance_count;
+            static unsigned instance_count;
 
         public:
 
-            static const Shader_Program * get_active_shader_program ()
-            {
-                return active_shader_program;
-            }
-
             static void disable ()
             {
-                glUseProgram (0);
+                Render_State::get_current ().use_program (0);
             }
 
         private:
@@ -55,6 +61,8 @@
             GLuint      program_object_id;
             std::string log_string;
 
+            mutable std::vector< Uniform_Value > uniform_cache;
+
         public:
 
             Shader_Program()
@@ -77,7 +85,11 @@
             {
                 if (initialized)
                 {
+                    Render_State::get_current ().forget_program (program_object_id);
+
                     glDeleteProgram (program_object_id);
+
+                    uniform_cache.clear ();
                 }
             }
 
@@ -102,18 +114,22 @@
 
             bool link ();
 
+            /**
+             * Returns true and remembers the value when it differs from the last one uploaded to the
+             * given location, so that redundant glUniform* calls can be skipped.
+             */
+            bool uniform_changed (GLint uniform_id, const void * value, GLsizei size) const;
+
         public:
 
-            void use () const
+            /**
+             * Returns false when the program was already in use.
+             */
+            bool use () const
             {
                 assert(is_usable ());
 
-                if (this != active_shader_program)
-                {
-                    glUseProgram (program_object_id);
-
-                    active_shader_program = this;
-                }
+                return Render_State::get_current ().use_program (program_object_id);
             }
 
         public:
@@ -129,20 +145,23 @@
                 return (uniform_id);
             }
 
-            void set_uniform_value (GLint uniform_id, const GLint     & value     ) const { glUniform1i  (uniform_id, value); }
-            void set_uniform_value (GLint uniform_id, const float     & value     ) const { glUniform1f  (uniform_id, value); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[2]) const { glUniform2f  (uniform_id, vector[0], vector[1]); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[3]) const { glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[4]) const { glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); }
-            void set_uniform_value (GLint uniform_id, const Point2f   & point     ) const { glUniform2f  (uniform_id,  point[0],  point[1]); }
-            void set_uniform_value (GLint uniform_id, const Point3f   & point     ) const { glUniform3f  (uniform_id,  point[0],  point[1],  point[2]); }
-            void set_uniform_value (GLint uniform_id, const Point4f   & point     ) const { glUniform4f  (uniform_id,  point[0],  point[1],  point[2],  point[3]); }
-            void set_uniform_value (GLint uniform_id, const Vector2f  & vector    ) const { glUniform2f  (uniform_id, vector[0], vector[1]); }
-            void set_uniform_value (GLint uniform_id, const Vector3f  & vector    ) const { glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); }
-            void set_uniform_value (GLint uniform_id, const Vector4f  & vector    ) const { glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); }
-            void set_uniform_value (GLint uniform_id, const Matrix22f & matrix    ) const { glUniformMatrix2fv (uniform_id, 1, GL_FALSE, matrix.values); }
-            void set_uniform_value (GLint uniform_id, const Matrix33f & matrix    ) const { glUniformMatrix3fv (uniform_id, 1, GL_FALSE, matrix.values); }
-            void set_uniform_value (GLint uniform_id, const Matrix44f & matrix    ) const { glUniformMatrix4fv (uniform_id, 1, GL_FALSE, matrix.values); }
+            // The program must be in use when a uniform is set, as the cache can't tell otherwise. They
+            // return false when the value was already uploaded:
+
+            bool set_uniform_value (GLint uniform_id, const GLint     & value     ) const { if (!uniform_changed (uniform_id, &value,        sizeof(value        ))) return false; glUniform1i  (uniform_id, value); return true; }
+            bool set_uniform_value (GLint uniform_id, const float     & value     ) const { if (!uniform_changed (uniform_id, &value,        sizeof(value        ))) return false; glUniform1f  (uniform_id, value); return true; }
+            bool set_uniform_value (GLint uniform_id, const float    (& vector)[2]) const { if (!uniform_changed (uniform_id,  vector,       sizeof(vector       ))) return false; glUniform2f  (uniform_id, vector[0], vector[1]); return true; }
+            bool set_uniform_value (GLint uniform_id, const float    (& vector)[3]) const { if (!uniform_changed (uniform_id,  vector,       sizeof(vector       ))) return false; glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); return true; }
+            bool set_uniform_value (GLint uniform_id, const float    (& vector)[4]) const { if (!uniform_changed (uniform_id,  vector,       sizeof(vector       ))) return false; glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); return true; }
+            bool set_uniform_value (GLint uniform_id, const Point2f   & point     ) const { if (!uniform_changed (uniform_id, &point[0],     sizeof(float) * 2    )) return false; glUniform2f  (uniform_id,  point[0],  point[1]); return true; }
+            bool set_uniform_value (GLint uniform_id, const Point3f   & point     ) const { if (!uniform_changed (uniform_id, &point[0],     sizeof(float) * 3    )) return false; glUniform3f  (uniform_id,  point[0],  point[1],  point[2]); return true; }
+            bool set_uniform_value (GLint uniform_id, const Point4f   & point     ) const { if (!uniform_changed (uniform_id, &point[0],     sizeof(float) * 4    )) return false; glUniform4f  (uniform_id,  point[0],  point[1],  point[2],  point[3]); return true; }
+            bool set_uniform_value (GLint uniform_id, const Vector2f  & vector    ) const { if (!uniform_changed (uniform_id, &vector[0],    sizeof(float) * 2    )) return false; glUniform2f  (uniform_id, vector[0], vector[1]); return true; }
+            bool set_uniform_value (GLint uniform_id, const Vector3f  & vector    ) const { if (!uniform_changed (uniform_id, &vector[0],    sizeof(float) * 3    )) return false; glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); return true; }
+            bool set_uniform_value (GLint uniform_id, const Vector4f  & vector    ) const { if (!uniform_changed (uniform_id, &vector[0],    sizeof(float) * 4    )) return false; glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); return true; }
+            bool set_uniform_value (GLint uniform_id, const Matrix22f & matrix    ) const { if (!uniform_changed (uniform_id,  matrix.values, sizeof(matrix.values))) return false; glUniformMatrix2fv (uniform_id, 1, GL_FALSE, matrix.values); return true; }
+            bool set_uniform_value (GLint uniform_id, const Matrix33f & matrix    ) const { if (!uniform_changed (uniform_id,  matrix.values, sizeof(matrix.values))) return false; glUniformMatrix3fv (uniform_id, 1, GL_FALSE, matrix.values); return true; }
+            bool set_uniform_value (GLint uniform_id, const Matrix44f & matrix    ) const { if (!uniform_changed (uniform_id,  matrix.values, sizeof(matrix.values))) return false; glUniformMatrix4fv (uniform_id, 1, GL_FALSE, matrix.values); return true; }
 
         public:
 
@@ -13,55 +13,82 @@
 #ifndef BASICS_OPENGLES_TEXTURE_2D_HEADER
 #define BASICS_OPENGLES_TEXTURE_2D_HEADER
 
+    #include <atomic>
+    #include <memory>
+    #include <basics/Asset>
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Resource>
     #include <basics/opengles/OpenGL_ES2>
+    #include <basics/opengles/Render_State>
     #include <basics/Texture_2D>
 
     namespace basics { namespace opengles
     {
 
+        /**
+         * Once the pixels have been uploaded, what's kept in main memory depends on the residency
+         * of the texture (see basics::Texture_2D::Residency). When the pixels have been released
+         * and the context is lost, they're decoded again in background threads the next time the
+         * texture is initialized, and it stays unusable until they're ready. The textures created
+         * from a texture container are uploaded straight from the mapped asset (with all its mipmap
+         * levels) and rebuilt by mapping it again. The decoded pixels are converted to the upload
+         * format of the options (if it has 16 bits) right before sending them.
+         */
         class Texture_2D : public basics::Texture_2D
         {
-
-            static const Texture_2D * active_texture;
-
         public:
 
             static std::shared_ptr< basics::Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+            static std::shared_ptr< basics::Texture_2D > create (Id id, const Texture_Container & container, const Options & options = {});
 
         public:
 
             static void enable ()
             {
-                register_factory (ID(opengles2), basics::opengles::Texture_2D::create);
+                register_factory
+                (
+                    ID(opengles2),
+                    static_cast< Factory           >(basics::opengles::Texture_2D::create),
+                    static_cast< Container_Factory >(basics::opengles::Texture_2D::create)
+                );
             }
 
             static void unuse ()
             {
-                glBindTexture (GL_TEXTURE_2D, 0);
+                Render_State::get_current ().bind_texture (0);
             }
 
         private:
 
-            Color_Buffer< Rgba8888 > color_buffer;
-            GLuint texture_object_id;
+            struct Rebuild
+            {
+                std::atomic< bool >      done;
+                bool                     good;
+                Color_Buffer< Rgba8888 > color_buffer;
+            };
+
+        private:
+
+            Color_Buffer< Rgba8888 >   color_buffer;        ///< Empty while the pixels aren't resident.
+            Residency                  residency;
+            Texture_Container::Format  upload_format;       ///< Ignored by the containers, which have their own.
+            bool                       dither;
+            std::string                asset_path;
+            Asset::View                encoded_data;        ///< Only kept with COMPACT_CACHE.
+            Texture_Container          container;           ///< Mapped while its pixels are needed.
+            bool                       from_container;
+            std::shared_ptr< Rebuild > rebuild;             ///< Pending decoding of the pixels.
+            GLuint                     texture_object_id;
 
         public:
 
-            Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
-            :
-                basics::Texture_2D(width, height),
-                color_buffer      (color_buffer )
-            {
-            }
+            Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height, const Options & options = {});
+            Texture_2D(const Texture_Container & container, const Options & options);
 
             Texture_2D(const Texture_2D & ) = delete;
 
            ~Texture_2D()
             {
-                if (active_texture == this) active_texture = nullptr;
-
                 finalize ();
             }
 
@@ -73,7 +100,11 @@
             {
                 if (initialized)
                 {
+                    Render_State::get_current ().forget_texture (texture_object_id);
+
                     glDeleteTextures (1, &texture_object_id);
+
+                    initialized = false;
                 }
             }
 
@@ -84,10 +115,36 @@
                 return initialized;
             }
 
+            /**
+             * Finishes a pending rebuild if its pixels are ready. Returns true if the texture can
+             * be used.
+             */
+            bool prepare () const
+            {
+                return initialized || (rebuild && const_cast< Texture_2D * >(this)->initialize ());
+            }
+
+            Residency get_residency () const
+            {
+                return residency;
+            }
+
         public:
 
+            /**
+             * Binds the texture to the first unit. Returns false when it was already bound.
+             */
             bool use () const;
 
+        private:
+
+            void   resolve_residency     ();
+            bool   restore_pixels        ();
+            void   release_pixels        ();
+            void   update_resident_bytes ();
+            size_t upload_color_buffer   ();           ///< Both return the bytes uploaded.
+            size_t upload_container      ();
+
         };
 
     }}
@@ -10,9 +10,12 @@
  * C1801091703
  */
 
+#include <algorithm>
+#include <cstddef>
 #include <basics/Transformation>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
+#include <basics/opengles/Render_State>
 #include <basics/opengles/Shader_Program>
 #include <basics/opengles/Texture_2D>
 
@@ -21,47 +24,51 @@
 namespace basics { namespace opengles
 {
 
+    // The transform uniform already holds the projection applied after the canvas transform:
+
     const char * Canvas_ES2::internal_vertex_shader_f =
         "precision mediump float;"
         "uniform   mat3 transform;"
-        "uniform   mat3 projection;"
         "attribute vec2 vertex_position;"
+        "attribute vec4 vertex_color;"
+        "varying   vec4 varying_color;"
         "void main()"
         "{"
-            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+            "varying_color = vertex_color;"
+            "gl_Position   = vec4((vec3(vertex_position, 1.0) * transform).xy, 0.0, 1.0);"
         "}";
 
     const char * Canvas_ES2::internal_vertex_shader_t =
         "precision mediump float;"
         "uniform   mat3 transform;"
-        "uniform   mat3 projection;"
         "attribute vec2 vertex_position;"
         "attribute vec2 vertex_texture_uv;"
+        "attribute vec4 vertex_color;"
         "varying   vec2 varying_uv;"
+        "varying   vec4 varying_color;"
         "void main()"
         "{"
-            "varying_uv  = vertex_texture_uv;"
-            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+            "varying_uv    = vertex_texture_uv;"
+            "varying_color = vertex_color;"
+            "gl_Position   = vec4((vec3(vertex_position, 1.0) * transform).xy, 0.0, 1.0);"
         "}";
 
     const char * Canvas_ES2::internal_fragment_shader_f =
         "precision mediump float;"
-        "uniform vec3  color;"
-        "uniform float opacity;"
+        "varying vec4 varying_color;"
         "void main()"
         "{"
-            "gl_FragColor = vec4(color, opacity);"
+            "gl_FragColor = varying_color;"
         "}";
 
     const char * Canvas_ES2::internal_fragment_shader_t =
         "precision mediump   float;"
         "uniform   sampler2D sampler;"
-        "uniform   float     opacity;"
         "varying   vec2      varying_uv;"
+        "varying   vec4      varying_color;"
         "void main()"
         "{"
-            "vec4 texel   = texture2D (sampler, varying_uv);"
-            "gl_FragColor = vec4(texel.rgb, texel.a * opacity);"
+            "gl_FragColor = texture2D (sampler, varying_uv) * varying_color;"
         "}";
 
     static const Point2f normal_texture_uvs[] =
@@ -120,10 +127,10 @@ namespace basics { namespace opengles
         {
             shader_program_f->use ();
 
-             transform_f_id = shader_program_f->get_uniform_id ("transform" );
-            projection_f_id = shader_program_f->get_uniform_id ("projection");
-                 color_f_id = shader_program_f->get_uniform_id ("color"     );
-               opacity_f_id = shader_program_f->get_uniform_id ("opacity"   );
+            transform_f_id = shader_program_f->get_uniform_id ("transform");
+
+            vertex_position_location_f = shader_program_f->get_vertex_attribute_id ("vertex_position");
+               vertex_color_location_f = shader_program_f->get_vertex_attribute_id ("vertex_color"   );
         }
 
         shader_program_t.reset (new Shader_Program);
@@ -137,24 +144,73 @@ namespace basics { namespace opengles
         {
             shader_program_t->use ();
 
-             transform_t_id = shader_program_t->get_uniform_id ("transform" );
-            projection_t_id = shader_program_t->get_uniform_id ("projection");
-               sampler_t_id = shader_program_t->get_uniform_id ("sampler"   );
-               opacity_t_id = shader_program_t->get_uniform_id ("opacity"   );
+            transform_t_id = shader_program_t->get_uniform_id ("transform");
+              sampler_t_id = shader_program_t->get_uniform_id ("sampler"  );
 
               vertex_position_location_t = shader_program_t->get_vertex_attribute_id ("vertex_position"  );
             vertex_texture_uv_location_t = shader_program_t->get_vertex_attribute_id ("vertex_texture_uv");
+                 vertex_color_location_t = shader_program_t->get_vertex_attribute_id ("vertex_color"     );
 
             shader_program_t->set_uniform_value (sampler_t_id, 0);
         }
 
+        // The vertex buffer is reallocated on every flush (GL_STREAM_DRAW) while the index buffer
+        // never changes, as every quad is made of two triangles that share the same pattern:
+
+        batch.enabled = true;
+        batch.kind    = EMPTY;
+        batch.texture = nullptr;
+
+        batch.vertices.reserve (max_batched_quads * 4);
+
+        std::vector< GLushort > indices(max_batched_quads * 6);
+
+        for (unsigned quad = 0, index = 0; quad < max_batched_quads; ++quad, index += 6)
+        {
+            GLushort first_vertex = GLushort(quad * 4);
+
+            indices[index + 0] = first_vertex;
+            indices[index + 1] = first_vertex + 1;
+            indices[index + 2] = first_vertex + 2;
+            indices[index + 3] = first_vertex + 2;
+            indices[index + 4] = first_vertex + 1;
+            indices[index + 5] = first_vertex + 3;
+        }
+
+        Render_State & render_state = Render_State::get_current ();
+
+        glGenBuffers (1, &batch.vertex_buffer);
+        glGenBuffers (1, &batch.index_buffer );
+
+        render_state.bind_array_buffer         (batch.vertex_buffer);
+        render_state.bind_element_array_buffer (batch.index_buffer );
+
+        glBufferData (GL_ARRAY_BUFFER,         max_batched_quads * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+        glBufferData (GL_ELEMENT_ARRAY_BUFFER, indices.size () * sizeof(GLushort), indices.data (), GL_STATIC_DRAW);
+
+        projected_transform_dirty = true;
+
         reset_state ();
     }
 
+    Canvas_ES2::~Canvas_ES2()
+    {
+        Render_State::get_current ().forget_buffer (batch.vertex_buffer);
+        Render_State::get_current ().forget_buffer (batch.index_buffer );
+
+        glDeleteBuffers (1, &batch.vertex_buffer);
+        glDeleteBuffers (1, &batch.index_buffer );
+    }
+
     void Canvas_ES2::reset_state ()
     {
-        glEnable      (GL_BLEND);
-        glBlendFunc   (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        flush_batch ();
+
+        // Whoever reset the canvas may have changed the GL state behind the back of the tracker:
+
+        Render_State::get_current ().invalidate ();
+        Render_State::get_current ().enable_blending (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
         glClearColor  (0.f, 0.f, 0.f, 1.f);
 
         set_size      ({ unsigned(size.width), unsigned(size.height) });
@@ -165,16 +221,14 @@ namespace basics { namespace opengles
 
     void Canvas_ES2::set_size (const Size2u & new_viewport_size)
     {
+        flush_batch ();
+
         size.width  = float(new_viewport_size.width );
         size.height = float(new_viewport_size.height);
         half_size   = size * 0.5f;
         projection  = translate_then_scale_2d (Vector2f{ -half_size.width, -half_size.height }, 2.f / size.width, 2.f / size.height);
 
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (projection_f_id, projection.matrix);
-
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
+        projected_transform_dirty = true;
     }
 
     void Canvas_ES2::set_clear_color (float r, float g, float b)
@@ -184,95 +238,89 @@ namespace basics { namespace opengles
 
     void Canvas_ES2::set_opacity (float opacity)
     {
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (opacity_f_id, opacity);
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (opacity_t_id, opacity);
+        color[3] = byte(std::min (std::max (opacity, 0.f), 1.f) * 255.f + .5f);
     }
 
     void Canvas_ES2::set_color (float r, float g, float b)
     {
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (color_f_id, Vector3f{ r, g, b });
+        color[0] = byte(std::min (std::max (r, 0.f), 1.f) * 255.f + .5f);
+        color[1] = byte(std::min (std::max (g, 0.f), 1.f) * 255.f + .5f);
+        color[2] = byte(std::min (std::max (b, 0.f), 1.f) * 255.f + .5f);
     }
 
-    void Canvas_ES2::set_transform (const Transformation2f & new_transform)
+    void Canvas_ES2::set_blending (Blending blending)
     {
-        transform = new_transform;
+        flush_batch ();
 
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
+        Render_State & render_state = Render_State::get_current ();
 
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+        switch (blending)
+        {
+            case NONE:         render_state.disable_blending ();                                       break;
+            case TRANSPARENCY: render_state.enable_blending  (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
+            case MULTIPLY:     render_state.enable_blending  (GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA); break;
+            case ADD:          render_state.enable_blending  (GL_SRC_ALPHA, GL_ONE);                 break;
+        }
     }
 
-    void Canvas_ES2::apply_transform (const Transformation2f & t)
+    void Canvas_ES2::set_transform (const Transformation2f & new_transform)
     {
-        transform = t * transform;
+        // Scenes often set the same transform again, which must not break the batch:
+
+        if (new_transform.matrix != transform.matrix)
+        {
+            flush_batch ();
+
+            transform = new_transform;
 
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
+            projected_transform_dirty = true;
+        }
+    }
 
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+    void Canvas_ES2::apply_transform (const Transformation2f & t)
+    {
+        set_transform (t * transform);
     }
 
     void Canvas_ES2::clear ()
     {
+        flush_batch ();
+
+        // A frame starts with a clear, so its statistics start here too:
+
+        reset_frame_stats ();
+
         glClear (GL_COLOR_BUFFER_BIT);
     }
 
     void Canvas_ES2::draw_point (const Point2f & position)
     {
-        shader_program_f->use ();
-
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, position.coordinates);
-        glDrawArrays               (GL_POINTS, 0, 1);
+        draw_immediate (&position, 1, GL_POINTS);
     }
 
     void Canvas_ES2::draw_segment (const Point2f & a, const Point2f & b)
     {
-        shader_program_f->use ();
-
         const Point2f coordinates[] = { a, b };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINES, 0, 2);
+        draw_immediate (coordinates, 2, GL_LINES);
     }
 
     void Canvas_ES2::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
-        shader_program_f->use ();
-
         const Point2f coordinates[] = { a, b, c, a };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 4);
+        draw_immediate (coordinates, 4, GL_LINE_STRIP);
     }
 
     void Canvas_ES2::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
-        shader_program_f->use ();
-
         const Point2f coordinates[] = { a, b, c };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLES, 0, 3);
+        draw_immediate (coordinates, 3, GL_TRIANGLES);
     }
 
     void Canvas_ES2::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
-        shader_program_f->use ();
-
         Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
 
         const Point2f coordinates[] =
@@ -284,37 +332,33 @@ namespace basics { namespace opengles
               bottom_left
         };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 5);
+        draw_immediate (coordinates, 5, GL_LINE_STRIP);
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
-        shader_program_f->use ();
+        Vertex * vertices = append_quad (FLAT, nullptr);
 
-        Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
+        float left   = bottom_left.coordinates.x ();
+        float bottom = bottom_left.coordinates.y ();
+        float right  = left   + size.width;
+        float top    = bottom + size.height;
 
-        const Point2f coordinates[] =
-        {
-              bottom_left,
-            { bottom_left.coordinates.x (),   top_right.coordinates.y () },
-            {   top_right.coordinates.x (), bottom_left.coordinates.y () },
-                top_right,
-        };
+        vertices[0] = { left,  bottom, 0.f, 0.f, { color[0], color[1], color[2], color[3] } };
+        vertices[1] = { left,  top,    0.f, 0.f, { color[0], color[1], color[2], color[3] } };
+        vertices[2] = { right, bottom, 0.f, 0.f, { color[0], color[1], color[2], color[3] } };
+        vertices[3] = { right, top,    0.f, 0.f, { color[0], color[1], color[2], color[3] } };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLE_STRIP, 0, 4);
+        if (!batch.enabled) flush_batch ();
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
     {
         const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(texture);
 
-        if (opengl_es_texture)
+        // A texture that is being rebuilt after losing the context isn't drawn until it's ready:
+
+        if (opengl_es_texture && opengl_es_texture->prepare ())
         {
                   Point2f   bottom_left;
             const Point2f * texture_uvs;
@@ -356,14 +400,19 @@ namespace basics { namespace opengles
                     top_right,
             };
 
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
+            Vertex * vertices = append_quad (TEXTURED, opengl_es_texture);
+
+            for (unsigned index = 0; index < 4; ++index)
+            {
+                vertices[index] =
+                {
+                    coordinates[index][0], coordinates[index][1],
+                    texture_uvs[index][0], texture_uvs[index][1],
+                    { 255, 255, 255, color[3] }
+                };
+            }
 
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+            if (!batch.enabled) flush_batch ();
         }
     }
 
@@ -376,22 +425,15 @@ namespace basics { namespace opengles
 
         const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(slice->atlas->get_texture ().get ());
 
-        if (opengl_es_texture)
+        if (opengl_es_texture && opengl_es_texture->prepare ())
         {
-            float   horizontal_ratio  = 1.f / opengl_es_texture->get_width  ();
-            float     vertical_ratio  = 1.f / opengl_es_texture->get_height ();
-            float   normalized_left   = slice->left   * horizontal_ratio;
-            float   normalized_right  = slice->right  * horizontal_ratio;
-            float   normalized_top    = slice->top    *   vertical_ratio;
-            float   normalized_bottom = slice->bottom *   vertical_ratio;
-
             Point2f bottom_left;
             Point2f texture_uvs[] =
             {
-                { normalized_left,  normalized_top    },
-                { normalized_left,  normalized_bottom },
-                { normalized_right, normalized_top    },
-                { normalized_right, normalized_bottom },
+                { slice->uv_left,  slice->uv_top    },
+                { slice->uv_left,  slice->uv_bottom },
+                { slice->uv_right, slice->uv_top    },
+                { slice->uv_right, slice->uv_bottom },
             };
 
             switch (handling & 0x03)
@@ -434,15 +476,143 @@ namespace basics { namespace opengles
                     top_right,
             };
 
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
+            Vertex * vertices = append_quad (TEXTURED, opengl_es_texture);
 
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+            for (unsigned index = 0; index < 4; ++index)
+            {
+                vertices[index] =
+                {
+                    coordinates[index][0], coordinates[index][1],
+                    texture_uvs[index][0], texture_uvs[index][1],
+                    { 255, 255, 255, color[3] }
+                };
+            }
+
+            if (!batch.enabled) flush_batch ();
+        }
+    }
+
+    void Canvas_ES2::flush ()
+    {
+        flush_batch ();
+
+        frame_stats.texture_upload_bytes += Render_State::get_current ().take_uploaded_texture_bytes ();
+    }
+
+    void Canvas_ES2::use_program (const Shader_Program & program, int transform_id)
+    {
+        if (projected_transform_dirty)
+        {
+            projected_transform       = projection * transform;
+            projected_transform_dirty = false;
+        }
+
+        if (program.use ()) frame_stats.program_switches++;
+
+        // Each program keeps track of the last value it received, so this is only uploaded once
+        // per program after each change:
+
+        if (program.set_uniform_value (transform_id, projected_transform.matrix)) frame_stats.uniform_uploads++;
+    }
+
+    void Canvas_ES2::draw_immediate (const Point2f * coordinates, GLsizei count, GLenum mode)
+    {
+        flush_batch ();
+
+        use_program (*shader_program_f, transform_f_id);
+
+        Render_State & render_state = Render_State::get_current ();
+
+        render_state.bind_array_buffer           (0);
+        render_state.set_vertex_attribute_arrays (1u << vertex_position_location_f);
+
+        glVertexAttrib4f           (vertex_color_location_f, color[0] / 255.f, color[1] / 255.f, color[2] / 255.f, color[3] / 255.f);
+        glVertexAttribPointer      (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays               (mode, 0, count);
+
+        // The coordinates are read from client memory on every call:
+
+        frame_stats.draw_calls++;
+        frame_stats.vertices       += unsigned(count);
+        frame_stats.bytes_streamed += size_t(count) * sizeof(Point2f);
+    }
+
+    Canvas_ES2::Vertex * Canvas_ES2::append_quad (Batch_Kind kind, const opengles::Texture_2D * texture)
+    {
+        // Any change of shader or texture (or a full arena) closes the current batch:
+
+        if (batch.kind != kind || batch.texture != texture || batch.vertices.size () == max_batched_quads * 4)
+        {
+            flush_batch ();
+
+            batch.kind    = kind;
+            batch.texture = texture;
         }
+
+        frame_stats.quads++;
+
+        batch.vertices.resize (batch.vertices.size () + 4);
+
+        return &batch.vertices.back () - 3;
+    }
+
+    void Canvas_ES2::flush_batch ()
+    {
+        if (batch.vertices.empty ())
+        {
+            return;
+        }
+
+        GLsizei quad_count = GLsizei(batch.vertices.size () / 4);
+
+        Render_State & render_state = Render_State::get_current ();
+
+        render_state.bind_array_buffer         (batch.vertex_buffer);
+        render_state.bind_element_array_buffer (batch.index_buffer );
+
+        // Orphaning the previous storage avoids stalling while the GPU may still be reading it:
+
+        glBufferData    (GL_ARRAY_BUFFER, max_batched_quads * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+        glBufferSubData (GL_ARRAY_BUFFER, 0, batch.vertices.size () * sizeof(Vertex), batch.vertices.data ());
+
+        const GLvoid * position_offset = reinterpret_cast< const GLvoid * >(offsetof(Vertex, x    ));
+        const GLvoid * uv_offset       = reinterpret_cast< const GLvoid * >(offsetof(Vertex, u    ));
+        const GLvoid * color_offset    = reinterpret_cast< const GLvoid * >(offsetof(Vertex, color));
+
+        if (batch.kind == TEXTURED)
+        {
+            if (batch.texture->use ()) frame_stats.texture_binds++;
+
+            use_program (*shader_program_t, transform_t_id);
+
+            render_state.set_vertex_attribute_arrays
+            (
+                1u << vertex_position_location_t | 1u << vertex_texture_uv_location_t | 1u << vertex_color_location_t
+            );
+
+            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT,         GL_FALSE, sizeof(Vertex), position_offset);
+            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT,         GL_FALSE, sizeof(Vertex), uv_offset      );
+            glVertexAttribPointer     (     vertex_color_location_t, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(Vertex), color_offset   );
+        }
+        else
+        {
+            use_program (*shader_program_f, transform_f_id);
+
+            render_state.set_vertex_attribute_arrays (1u << vertex_position_location_f | 1u << vertex_color_location_f);
+
+            glVertexAttribPointer     (vertex_position_location_f, 2, GL_FLOAT,         GL_FALSE, sizeof(Vertex), position_offset);
+            glVertexAttribPointer     (   vertex_color_location_f, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(Vertex), color_offset   );
+        }
+
+        glDrawElements (GL_TRIANGLES, quad_count * 6, GL_UNSIGNED_SHORT, nullptr);
+
+        frame_stats.draw_calls++;
+        frame_stats.vertices       += unsigned(batch.vertices.size ());
+        frame_stats.bytes_streamed += batch.vertices.size () * sizeof(Vertex);
+
+        batch.vertices.clear ();
+        batch.kind    = EMPTY;
+        batch.texture = nullptr;
     }
 
 }}
@@ -0,0 +1,112 @@
+/*
+ * RENDER STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802051917
+ */
+
+#include <basics/opengles/Render_State>
+
+namespace basics { namespace opengles
+{
+
+    Render_State * Render_State::current = nullptr;
+
+    void Render_State::invalidate ()
+    {
+        program              = unknown;
+        active_unit          = unknown;
+        enabled_attributes   = 0;
+        attributes_known     = false;
+        array_buffer         = unknown;
+        element_array_buffer = unknown;
+        blending             = unknown;
+        blend_source         = unknown;
+        blend_destination    = unknown;
+
+        for (auto & texture : textures) texture = unknown;
+    }
+
+    bool Render_State::bind_texture (GLuint texture_object_id, unsigned unit)
+    {
+        if (unit >= max_texture_units)
+        {
+            glActiveTexture (active_unit = GL_TEXTURE0 + unit);
+            glBindTexture   (GL_TEXTURE_2D, texture_object_id);
+
+            return true;
+        }
+
+        if (textures[unit] != texture_object_id)
+        {
+            if (active_unit != GL_TEXTURE0 + unit)
+            {
+                glActiveTexture (active_unit = GL_TEXTURE0 + unit);
+            }
+
+            glBindTexture (GL_TEXTURE_2D, textures[unit] = texture_object_id);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void Render_State::set_vertex_attribute_arrays (uint32_t mask)
+    {
+        uint32_t changed = attributes_known ? mask ^ enabled_attributes : (1u << max_vertex_attributes) - 1u;
+
+        for (unsigned index = 0; changed != 0; ++index, changed >>= 1)
+        {
+            if (changed & 1u)
+            {
+                if (mask & (1u << index))
+                    glEnableVertexAttribArray  (index);
+                else
+                    glDisableVertexAttribArray (index);
+            }
+        }
+
+        enabled_attributes = mask;
+        attributes_known   = true;
+    }
+
+    void Render_State::disable_blending ()
+    {
+        if (blending != GL_FALSE)
+        {
+            glDisable (GL_BLEND);
+
+            blending = GL_FALSE;
+        }
+    }
+
+    void Render_State::enable_blending (GLenum source_factor, GLenum destination_factor)
+    {
+        if (blending != GL_TRUE)
+        {
+            glEnable (GL_BLEND);
+
+            blending = GL_TRUE;
+        }
+
+        if (blend_source != source_factor || blend_destination != destination_factor)
+        {
+            glBlendFunc (blend_source = source_factor, blend_destination = destination_factor);
+        }
+    }
+
+    void Render_State::forget_texture (GLuint texture_object_id)
+    {
+        for (auto & texture : textures)
+        {
+            if (texture == texture_object_id) texture = 0;
+        }
+    }
+
+}}
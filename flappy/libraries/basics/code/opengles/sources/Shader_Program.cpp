@@ -8,6 +8,7 @@
  * angel.rodriguez@esne.edu
  */
 
+#include <cstring>
 #include <basics/opengles/Fragment_Shader>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Shader_Program>
@@ -16,8 +17,7 @@
 namespace basics { namespace opengles
 {
 
-    const Shader_Program * Shader_Program::active_shader_program = nullptr;
-    unsigned int           Shader_Program::instance_count        = 0;
+    unsigned int Shader_Program::instance_count = 0;
 
     bool Shader_Program::initialize ()
     {
@@ -25,6 +25,8 @@ namespace basics { namespace opengles
         {
             if (source_code.size () > 0)
             {
+                uniform_cache.clear ();
+
                 program_object_id = glCreateProgram ();
 
                 assert(program_object_id != 0);
@@ -85,4 +87,35 @@ namespace basics { namespace opengles
         return succeeded != 0;
     }
 
+    bool Shader_Program::uniform_changed (GLint uniform_id, const void * value, GLsizei size) const
+    {
+        assert(size_t(size) <= sizeof(Uniform_Value::bytes));
+
+        for (auto & cached : uniform_cache)
+        {
+            if (cached.location == uniform_id)
+            {
+                if (cached.size == size && std::memcmp (cached.bytes, value, size_t(size)) == 0)
+                {
+                    return false;
+                }
+
+                cached.size = size;
+
+                std::memcpy (cached.bytes, value, size_t(size));
+
+                return true;
+            }
+        }
+
+        uniform_cache.emplace_back ();
+
+        uniform_cache.back ().location = uniform_id;
+        uniform_cache.back ().size     = size;
+
+        std::memcpy (uniform_cache.back ().bytes, value, size_t(size));
+
+        return true;
+    }
+
 }}
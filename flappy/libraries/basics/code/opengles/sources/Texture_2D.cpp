@@ -12,32 +12,136 @@
 
 #include <basics/assert>
 #include <basics/opengles/Texture_2D>
+#include <basics/pixel_conversion>
+#include <basics/Thread_Pool>
 
 namespace basics { namespace opengles
 {
 
-    const Texture_2D * Texture_2D::active_texture = nullptr;
+    namespace
+    {
+
+        // The textures that have to be rebuilt after losing the context share these threads:
+
+        Thread_Pool & get_decoding_pool ()
+        {
+            static Thread_Pool decoding_pool;
+
+            return decoding_pool;
+        }
+
+    }
 
-    std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
+    std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id , Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
-        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options.width, options.height));
+        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options.width, options.height, options));
+    }
+
+    std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id , const Texture_Container & container, const Options & options)
+    {
+        return std::shared_ptr< Texture_2D >(new Texture_2D(container, options));
+    }
+
+    Texture_2D::Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height, const Options & options)
+    :
+        basics::Texture_2D(width, height),
+        color_buffer      (color_buffer         ),
+        residency         (options.residency    ),
+        upload_format     (options.upload_format),
+        dither            (options.dither       ),
+        asset_path        (options.asset_path   ),
+        from_container    (false                )
+    {
+        resolve_residency ();
+
+        if (residency == COMPACT_CACHE)
+        {
+            encoded_data = Asset::map (asset_path);
+
+            if (!encoded_data) residency = RELEASE_PIXELS;
+        }
+
+        update_resident_bytes ();
+    }
+
+    Texture_2D::Texture_2D(const Texture_Container & container, const Options & options)
+    :
+        basics::Texture_2D(container.get_width (), container.get_height ()),
+        residency         (options.residency    ),
+        upload_format     (options.upload_format),
+        dither            (options.dither       ),
+        asset_path        (options.asset_path   ),
+        container         (container            ),
+        from_container    (true                 )
+    {
+        resolve_residency ();
+        update_resident_bytes ();
+    }
+
+    void Texture_2D::resolve_residency ()
+    {
+        // Without an asset the pixels couldn't be recovered, so they have to be kept:
+
+        if (asset_path.empty ())
+        {
+            residency = KEEP_PIXELS;
+        }
+        else
+        if (residency == AUTOMATIC)
+        {
+            residency = RELEASE_PIXELS;
+        }
     }
 
     bool Texture_2D::initialize ()
     {
         if (!initialized)
         {
-            if (color_buffer.size () > 0)
+            if (restore_pixels ())
             {
                 glEnable        (GL_TEXTURE_2D);////
                 glGenTextures   (1, &texture_object_id);
-                glBindTexture   (GL_TEXTURE_2D, texture_object_id);
 
-                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                Render_State::get_current ().bind_texture (texture_object_id);
+
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
+                size_t uploaded_bytes = from_container ? upload_container () : upload_color_buffer ();
+
+                Render_State::get_current ().count_texture_upload (uploaded_bytes);
+
+                int error = glGetError ();
+
+                assert(glGetError () == GL_NO_ERROR);
+                assert(width > 0 && height > 0);
+
+                initialized = true;
+
+                release_pixels ();
+            }
+        }
+
+        return initialized;
+    }
+
+    size_t Texture_2D::upload_color_buffer ()
+    {
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+        GLenum                   format = GL_RGBA;
+        GLenum                   type   = GL_UNSIGNED_SHORT_4_4_4_4;
+        Color_Buffer< uint16_t > converted;
+
+        switch (upload_format)
+        {
+            case Texture_Container::RGB565:   convert_to_rgb565   (color_buffer, converted, dither); format = GL_RGB; type = GL_UNSIGNED_SHORT_5_6_5; break;
+            case Texture_Container::RGBA4444: convert_to_rgba4444 (color_buffer, converted, dither); break;
+            case Texture_Container::RGBA5551: convert_to_rgba5551 (color_buffer, converted, dither); type = GL_UNSIGNED_SHORT_5_5_5_1; break;
+
+            default:
+            {
                 glTexImage2D
                 (
                     GL_TEXTURE_2D,
@@ -51,33 +155,160 @@ namespace basics { namespace opengles
                     color_buffer
                 );
 
-                int error = glGetError ();
+                return color_buffer.size () * sizeof(Rgba8888);
+            }
+        }
 
-                assert(glGetError () == GL_NO_ERROR);
-                assert(width > 0 && height > 0);
+        glPixelStorei (GL_UNPACK_ALIGNMENT, 2);
+        glTexImage2D  (GL_TEXTURE_2D, 0, format, converted.get_width (), converted.get_height (), 0, format, type, converted);
+        glPixelStorei (GL_UNPACK_ALIGNMENT, 4);
 
-                initialized = true;
-            }
+        return converted.size () * sizeof(uint16_t);
+    }
+
+    size_t Texture_2D::upload_container ()
+    {
+        GLenum format = GL_RGBA;
+        GLenum type   = GL_UNSIGNED_BYTE;
+
+        switch (container.get_format ())
+        {
+            case Texture_Container::RGB565:   format = GL_RGB;  type = GL_UNSIGNED_SHORT_5_6_5;   break;
+            case Texture_Container::RGBA4444: format = GL_RGBA; type = GL_UNSIGNED_SHORT_4_4_4_4; break;
+            case Texture_Container::RGBA5551: format = GL_RGBA; type = GL_UNSIGNED_SHORT_5_5_5_1; break;
+            default: break;
         }
 
-        return initialized;
+        // OpenGL ES 2 only allows mipmaps with power of two sizes:
+
+        unsigned full_width  = container.get_width  ();
+        unsigned full_height = container.get_height ();
+        bool     power_of_2  = (full_width & (full_width - 1)) == 0 && (full_height & (full_height - 1)) == 0;
+        unsigned level_count = power_of_2 ? container.get_level_count () : 1;
+
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, level_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+        // The rows of the 16 bit formats are only aligned to 2 bytes:
+
+        glPixelStorei (GL_UNPACK_ALIGNMENT, type == GL_UNSIGNED_BYTE ? 4 : 2);
+
+        size_t uploaded_bytes = 0;
+
+        for (unsigned index = 0; index < level_count; ++index)
+        {
+            const Texture_Container::Level & level = container.get_level (index);
+
+            glTexImage2D (GL_TEXTURE_2D, GLint(index), format, level.width, level.height, 0, format, type, level.pixels);
+
+            uploaded_bytes += level.size;
+        }
+
+        glPixelStorei (GL_UNPACK_ALIGNMENT, 4);
+
+        return uploaded_bytes;
     }
 
-    bool Texture_2D::use () const
+    bool Texture_2D::restore_pixels ()
     {
-        assert(is_usable ());
+        // Mapping the container again is cheap enough to do it right away:
 
-        //if (active_texture != this)
+        if (from_container)
         {
-            glBindTexture   (GL_TEXTURE_2D, texture_object_id);
-            glActiveTexture (GL_TEXTURE0);
+            if (!container.good ())
+            {
+                container = find_container (asset_path);
+
+                update_resident_bytes ();
+            }
 
-            active_texture  = this;
+            return container.good ();
+        }
 
+        if (color_buffer.size () > 0)
+        {
             return true;
         }
 
-        return false;
+        if (!rebuild)
+        {
+            if (residency == KEEP_PIXELS)
+            {
+                return false;
+            }
+
+            // The decoding is started now and checked again in later calls:
+
+            rebuild = std::make_shared< Rebuild > ();
+            rebuild->done = false;
+            rebuild->good = false;
+
+            std::shared_ptr< Rebuild > pending  = rebuild;
+            std::string                path     = asset_path;
+            Asset::View                data     = encoded_data;
+
+            get_decoding_pool ().submit
+            (
+                [pending, path, data] ()
+                {
+                    Options options{};
+
+                    pending->good = data
+                        ? decode (data, pending->color_buffer, options)
+                        : decode (path, pending->color_buffer, options);
+
+                    pending->done = true;
+                }
+            );
+
+            return false;
+        }
+
+        if (!rebuild->done)
+        {
+            return false;
+        }
+
+        bool good = rebuild->good;
+
+        if (good)
+        {
+            color_buffer = std::move (rebuild->color_buffer);
+
+            update_resident_bytes ();
+        }
+
+        rebuild.reset ();
+
+        return good;
+    }
+
+    void Texture_2D::release_pixels ()
+    {
+        // A container is already compact, so it's only dropped when the pixels are released:
+
+        if (from_container)
+        {
+            if (residency == RELEASE_PIXELS) container = Texture_Container();
+        }
+        else
+        if (residency != KEEP_PIXELS)
+        {
+            color_buffer = Color_Buffer< Rgba8888 >();
+        }
+
+        update_resident_bytes ();
+    }
+
+    void Texture_2D::update_resident_bytes ()
+    {
+        set_resident_bytes (color_buffer.size () * sizeof(Rgba8888) + encoded_data.size () + container.get_size ());
+    }
+
+    bool Texture_2D::use () const
+    {
+        assert(is_usable ());
+
+        return Render_State::get_current ().bind_texture (texture_object_id);
     }
 
 }}
@@ -13,12 +13,42 @@
 #ifndef BASICS_PNG_DECODE_HEADER
 #define BASICS_PNG_DECODE_HEADER
 
+    #include <vector>
     #include <basics/Color_Buffer>
 
     namespace basics
     {
 
-        bool png_decode (const std::vector< byte > & encoded_data, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height);
+        /**
+         * Decodes a PNG as 8 bit RGBA rows (the first one at the top) written straight into the
+         * memory returned by get_buffer(), which is called once the size of the image is known
+         * and must return room for width * height * 4 bytes (or nullptr to give up).
+         */
+        bool png_decode
+        (
+            const byte * encoded_data,
+            size_t       encoded_size,
+            byte       * (* get_buffer) (void * context, unsigned width, unsigned height),
+            void       * context,
+            unsigned   & width,
+            unsigned   & height
+        );
+
+        /**
+         * Decodes a PNG straight into the storage of the color buffer, which is resized as needed.
+         */
+        bool png_decode (const byte * encoded_data, size_t encoded_size, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height);
+
+        inline bool png_decode (const std::vector< byte > & encoded_data, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height)
+        {
+            return png_decode (encoded_data.data (), encoded_data.size (), color_buffer, width, height);
+        }
+
+        /**
+         * Peak of the memory allocated by the decoder during the last call to png_decode() made
+         * from the calling thread, not counting the destination buffer.
+         */
+        size_t png_decode_peak_bytes ();
 
     }
 
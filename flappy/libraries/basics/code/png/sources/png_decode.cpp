@@ -10,47 +10,259 @@
  * C1801221221
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include "lodepng.h"
 #include <basics/png_decode>
 
+namespace basics
+{
+
+    namespace
+    {
+
+        /**
+         * State of the decoding running on the current thread. lodepng gets its memory through
+         * lodepng_malloc(), lodepng_realloc() and lodepng_free() (see the allocators below), so
+         * they can hand out the caller's buffer as the image buffer and measure the memory used.
+         */
+        struct Decoding
+        {
+            byte   * target;                                ///< Where the RGBA pixels have to end.
+            size_t   target_size;
+            bool     image_inflated;                        ///< The pixel data has been decompressed.
+            bool     target_claimed;
+            size_t   current_bytes;
+            size_t   peak_bytes;
+        };
+
+        thread_local Decoding * current_decoding = nullptr;
+        thread_local size_t     last_peak_bytes  = 0;
+
+        // The size of each block is stored before it (keeping the alignment of malloc):
+
+        const size_t header_size = 16;
+
+        // The image data is the only zlib stream decompressed into a buffer that was reserved in
+        // advance (the text chunks start from an empty one). After it, the next allocation of the
+        // size of the RGBA image is the final buffer: the one written by postProcessScanlines()
+        // when the PNG is already RGBA or the one written by lodepng_convert() otherwise.
+
+        unsigned inflate_image
+        (
+            unsigned char            ** out,
+            size_t                    * outsize,
+            const unsigned char       * in,
+            size_t                      insize,
+            const LodePNGDecompressSettings * settings
+        )
+        {
+            bool is_image = *out != nullptr;
+
+            LodePNGDecompressSettings default_settings = *settings;
+
+            default_settings.custom_zlib = nullptr;
+
+            unsigned error = lodepng_zlib_decompress (out, outsize, in, insize, &default_settings);
+
+            if (is_image && current_decoding) current_decoding->image_inflated = true;
+
+            return error;
+        }
+
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void * lodepng_malloc (size_t size)
+{
+    using namespace basics;
+
+    Decoding * decoding = current_decoding;
+
+    if (decoding && decoding->image_inflated && !decoding->target_claimed && size == decoding->target_size)
+    {
+        decoding->target_claimed = true;
+
+        return decoding->target;
+    }
+
+    byte * block = static_cast< byte * >(std::malloc (size + header_size));
+
+    if (!block) return nullptr;
+
+    *reinterpret_cast< size_t * >(block) = size;
+
+    if (decoding)
+    {
+        decoding->current_bytes += size;
+
+        if (decoding->current_bytes > decoding->peak_bytes) decoding->peak_bytes = decoding->current_bytes;
+    }
+
+    return block + header_size;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void lodepng_free (void * pointer)
+{
+    using namespace basics;
+
+    if (!pointer) return;
+
+    Decoding * decoding = current_decoding;
+
+    // The target belongs to the caller:
+
+    if (decoding && pointer == decoding->target) return;
+
+    byte * block = static_cast< byte * >(pointer) - header_size;
+
+    if (decoding)
+    {
+        size_t size = *reinterpret_cast< size_t * >(block);
+
+        decoding->current_bytes -= std::min (size, decoding->current_bytes);
+    }
+
+    std::free (block);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void * lodepng_realloc (void * pointer, size_t new_size)
+{
+    using namespace basics;
+
+    if (!pointer) return lodepng_malloc (new_size);
+
+    Decoding * decoding = current_decoding;
+
+    // lodepng never grows the final buffer, so this can't happen unless something goes wrong:
+
+    if (decoding && pointer == decoding->target) return nullptr;
+
+    byte * block    = static_cast< byte * >(pointer) - header_size;
+    size_t old_size = *reinterpret_cast< size_t * >(block);
+
+    block = static_cast< byte * >(std::realloc (block, new_size + header_size));
+
+    if (!block) return nullptr;
+
+    *reinterpret_cast< size_t * >(block) = new_size;
+
+    if (decoding)
+    {
+        decoding->current_bytes += new_size;
+        decoding->current_bytes -= std::min (old_size, decoding->current_bytes);
+
+        if (decoding->current_bytes > decoding->peak_bytes) decoding->peak_bytes = decoding->current_bytes;
+    }
+
+    return block + header_size;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 namespace basics
 {
 
     bool png_decode
     (
-        const std::vector< byte > & encoded_data,
-        Color_Buffer < Rgba8888 > & color_buffer,
-        unsigned & width,
-        unsigned & height
+        const byte * encoded_data,
+        size_t       encoded_size,
+        byte       * (* get_buffer) (void * context, unsigned width, unsigned height),
+        void       * context,
+        unsigned   & width,
+        unsigned   & height
     )
     {
-        std::vector< byte > decoded_data;
+        LodePNGState state;
 
-        int error = lodepng::decode
-        (
-            decoded_data,
-            width,
-            height,
-            encoded_data,
-            LCT_RGBA,
-            8
-        );
+        lodepng_state_init (&state);
 
-        if (!error)
+        state.info_raw.colortype                  = LCT_RGBA;
+        state.info_raw.bitdepth                   = 8;
+        state.decoder.zlibsettings.custom_zlib    = inflate_image;
+
+        // The header says how big the destination has to be before decoding anything:
+
+        unsigned error = lodepng_inspect (&width, &height, &state, encoded_data, encoded_size);
+
+        byte * target = error ? nullptr : get_buffer (context, width, height);
+
+        if (target)
         {
-            color_buffer.resize (width, height);
+            Decoding decoding{ target, size_t(width) * height * 4, false, false, 0, 0 };
+
+            current_decoding = &decoding;
 
-            byte * buffer = color_buffer;
+            unsigned char * decoded_data = nullptr;
 
-            for (auto i = decoded_data.begin (); i != decoded_data.end (); ++i)
+            error = lodepng_decode (&decoded_data, &width, &height, &state, encoded_data, encoded_size);
+
+            // Only when some other buffer of the same size was allocated first (ie. 16 bit grey
+            // with alpha converted to RGBA) the pixels end somewhere else:
+
+            if (!error && decoded_data != target)
             {
-                *buffer++ = *i;
+                std::memcpy (target, decoded_data, decoding.target_size);
             }
 
-            return true;
+            lodepng_free (decoded_data);
+
+            current_decoding = nullptr;
+            last_peak_bytes  = decoding.peak_bytes;
         }
+        else
+        if (!error)
+        {
+            error = 83;
+        }
+
+        lodepng_state_cleanup (&state);
+
+        return error == 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool png_decode
+    (
+        const byte                * encoded_data,
+        size_t                      encoded_size,
+        Color_Buffer < Rgba8888 > & color_buffer,
+        unsigned & width,
+        unsigned & height
+    )
+    {
+        return png_decode
+        (
+            encoded_data,
+            encoded_size,
+            [] (void * context, unsigned width, unsigned height) -> byte *
+            {
+                Color_Buffer< Rgba8888 > & color_buffer = *static_cast< Color_Buffer< Rgba8888 > * >(context);
 
-        return false;
+                color_buffer.resize (width, height);
+
+                return color_buffer;
+            },
+            &color_buffer,
+            width,
+            height
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t png_decode_peak_bytes ()
+    {
+        return last_peak_bytes;
     }
 
 }
@@ -0,0 +1,165 @@
+/*
+ * SOFTWARE CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101215
+ */
+
+#ifndef BASICS_SOFTWARE_CANVAS_HEADER
+#define BASICS_SOFTWARE_CANVAS_HEADER
+
+    #include <memory>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Thread_Pool>
+    #include <basics/Transformation>
+
+    namespace basics { namespace software
+    {
+
+        class Context;
+        class Texture_2D;
+
+        /**
+         * Canvas that rasterizes on the CPU into the framebuffer of a software::Context.
+         *
+         * The primitives are recorded in framebuffer coordinates until flush() is called. Then they
+         * are binned into square tiles and every tile is rasterized by a worker of a thread pool,
+         * in submission order, so the result doesn't depend on the number of threads.
+         */
+        class Canvas_Software : public basics::Canvas
+        {
+        public:
+
+            static constexpr int tile_size = 64;            ///< Side of the tiles in pixels.
+
+            struct Statistics
+            {
+                unsigned primitives;                        ///< Primitives rasterized by the last flush.
+                unsigned tiles;                             ///< Tiles touched by at least one of them.
+            };
+
+        public:
+
+            static Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(software), Canvas_Software::create);
+            }
+
+        private:
+
+            struct Vertex
+            {
+                float x, y;                                 ///< Framebuffer coordinates.
+                float u, v;
+            };
+
+            struct Primitive
+            {
+                enum Kind
+                {
+                    CLEAR,
+                    RECTANGLE,                              ///< Axis aligned and untextured.
+                    TRIANGLE
+                };
+
+                Kind               kind;
+                Blending           blending;
+                uint8_t            color[4];
+                const Texture_2D * texture;
+                int                left, bottom, right, top;            ///< Covered pixels, half-open.
+                Vertex             vertices[3];
+            };
+
+        private:
+
+            Context                    & context;
+
+            Size2f                       size;
+            Transformation2f             transform;
+
+            float                        clear_color[3];
+            float                        color[3];
+            float                        opacity;
+            Blending                     blending;
+
+            std::vector< Primitive >     primitives;
+            std::vector< std::vector< unsigned > > tile_bins;
+            std::vector< unsigned >      touched_tiles;
+
+            std::unique_ptr< Thread_Pool > thread_pool;
+            Statistics                   statistics;
+
+        public:
+
+            Canvas_Software(Context & context, const Size2u & size);
+
+        public:
+
+            void reset_state     () override;
+            void set_size        (const Size2u & size) override;
+
+        public:
+
+            /**
+             * Sets the number of threads (including the calling one) that rasterize the tiles.
+             * Passing 0 uses every hardware thread.
+             */
+            void set_thread_count (unsigned count);
+
+            unsigned get_thread_count () const
+            {
+                return thread_pool ? thread_pool->get_worker_count () + 1 : 1;
+            }
+
+            const Statistics & get_statistics () const
+            {
+                return statistics;
+            }
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
+            void flush           () override;
+
+        private:
+
+            Vertex    to_framebuffer   (const Point2f & point, float u = 0.f, float v = 0.f) const;
+            Primitive make_primitive   (Primitive::Kind kind, const Texture_2D * texture) const;
+            void      add_rectangle    (float left, float bottom, float right, float top);
+            void      add_triangle     (const Vertex & a, const Vertex & b, const Vertex & c, const Texture_2D * texture);
+            void      add_quad         (const Point2f & bottom_left, const Size2f & size, const Point2f * texture_uvs, const Texture_2D * texture);
+            void      add_line         (const Vertex & a, const Vertex & b);
+            void      rasterize_tile   (unsigned tile_index);
+
+        };
+
+    }}
+
+#endif
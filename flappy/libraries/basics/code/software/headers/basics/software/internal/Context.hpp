@@ -0,0 +1,175 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101205
+ */
+
+#ifndef BASICS_SOFTWARE_CONTEXT_HEADER
+#define BASICS_SOFTWARE_CONTEXT_HEADER
+
+    #include <atomic>
+    #include <functional>
+    #include <string>
+    #include <basics/Color_Buffer>
+    #include <basics/Graphics_Context>
+    #include <basics/Point>
+    #include <basics/Size>
+    #include <basics/Window>
+
+    namespace basics { namespace software
+    {
+
+        /**
+         * Graphics context whose surface is a Color_Buffer in main memory. It doesn't need any GPU
+         * or window system, so it can render on headless machines. Row 0 of the framebuffer is the
+         * bottom one, as in OpenGL.
+         */
+        class Context : public basics::Graphics_Context
+        {
+        public:
+
+            typedef std::function< void (const Color_Buffer< Rgba8888 > & frame, unsigned frame_index) > Present_Callback;
+
+        public:
+
+            /**
+             * Factory compatible with Director::set_graphics_context_factory(). The framebuffer
+             * takes the size of the window.
+             */
+            static bool create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache);
+
+        private:
+
+            Color_Buffer< Rgba8888 > framebuffer;
+            Point2u                  viewport_origin;
+            Size2u                   viewport_size;
+            Present_Callback         present_callback;
+            unsigned                 frame_count;
+            std::atomic< bool >      available;
+
+        public:
+
+            Context(Window & window, Graphics_Resource_Cache * cache, const Size2u & surface_size);
+
+           ~Context()
+            {
+                finalize ();
+            }
+
+        public:
+
+            Id get_id () const override
+            {
+                return ID(software);
+            }
+
+            bool is_available () const override
+            {
+                return available;
+            }
+
+            bool is_current () const override
+            {
+                return available;
+            }
+
+            void invalidate () override
+            {
+                available = false;
+            }
+
+            void suspend () override
+            {
+                available = false;
+            }
+
+            bool resume () override
+            {
+                return available = true;
+            }
+
+            bool make_current () override
+            {
+                return available;
+            }
+
+            bool release_current () override
+            {
+                return true;
+            }
+
+            bool set_sync_swap (bool ) override
+            {
+                return false;
+            }
+
+            unsigned get_surface_width () override
+            {
+                return framebuffer.get_width ();
+            }
+
+            unsigned get_surface_height () override
+            {
+                return framebuffer.get_height ();
+            }
+
+            void reset_viewport () override
+            {
+                viewport_origin = { 0, 0 };
+                viewport_size   = { framebuffer.get_width (), framebuffer.get_height () };
+            }
+
+            void set_viewport (const Point2u & bottom_left, const Size2u & size) override
+            {
+                viewport_origin = bottom_left;
+                viewport_size   = size;
+            }
+
+            /**
+             * Hands the finished frame to the present callback, if any.
+             */
+            bool flush_and_display () override;
+
+        public:
+
+            Color_Buffer< Rgba8888 > & get_framebuffer ()
+            {
+                return framebuffer;
+            }
+
+            const Point2u & get_viewport_origin () const
+            {
+                return viewport_origin;
+            }
+
+            const Size2u & get_viewport_size () const
+            {
+                return viewport_size;
+            }
+
+            unsigned get_frame_count () const
+            {
+                return frame_count;
+            }
+
+            void set_present_callback (const Present_Callback & callback)
+            {
+                present_callback = callback;
+            }
+
+            /**
+             * Writes the current contents of the framebuffer to an uncompressed TGA file.
+             */
+            bool save_frame (const std::string & path) const override;
+
+        };
+
+    }}
+
+#endif
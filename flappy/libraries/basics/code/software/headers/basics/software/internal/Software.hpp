@@ -0,0 +1,22 @@
+/*
+ * SOFTWARE RENDERING
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101200
+ */
+
+#ifndef BASICS_SOFTWARE_HEADER
+#define BASICS_SOFTWARE_HEADER
+
+    namespace basics
+    {
+        /// Tag used with enable<>() to register the software renderers.
+        class Software;
+    }
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * SOFTWARE TEXTURE 2D
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101210
+ */
+
+#ifndef BASICS_SOFTWARE_TEXTURE_2D_HEADER
+#define BASICS_SOFTWARE_TEXTURE_2D_HEADER
+
+    #include <basics/Color_Buffer>
+    #include <basics/Texture_2D>
+
+    namespace basics { namespace software
+    {
+
+        /**
+         * Texture kept in main memory so that Canvas_Software can sample it. The texels keep the
+         * byte order produced by png_decode (R, G, B, A) and row 0 is addressed by v = 0.
+         */
+        class Texture_2D : public basics::Texture_2D
+        {
+        public:
+
+            static std::shared_ptr< basics::Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(software), basics::software::Texture_2D::create);
+            }
+
+        private:
+
+            Color_Buffer< Rgba8888 > color_buffer;
+
+        public:
+
+            Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
+            :
+                basics::Texture_2D(width, height),
+                color_buffer      (color_buffer )
+            {
+                // The canvas samples the pixels, so they're always resident:
+
+                set_resident_bytes (this->color_buffer.size () * sizeof(Rgba8888));
+            }
+
+            Texture_2D(const Texture_2D & ) = delete;
+
+        public:
+
+            bool initialize () override
+            {
+                return initialized = color_buffer.size () > 0;
+            }
+
+            void finalize () override
+            {
+            }
+
+        public:
+
+            const Color_Buffer< Rgba8888 > & get_color_buffer () const
+            {
+                return color_buffer;
+            }
+
+        };
+
+    }}
+
+#endif
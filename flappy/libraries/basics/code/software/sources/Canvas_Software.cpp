@@ -0,0 +1,841 @@
+/*
+ * SOFTWARE CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101220
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <basics/software/Canvas_Software>
+#include <basics/software/Context>
+#include <basics/software/Texture_2D>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BASICS_SOFTWARE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define BASICS_SOFTWARE_NEON
+#endif
+
+namespace basics { namespace software
+{
+
+    // ---------------------------------------------------------------------------------------------
+    // Pixel kernels. Every pixel is stored as four bytes in R, G, B, A order. All of them divide by
+    // 255 in the same way, so the SIMD and scalar paths produce identical results.
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        inline int divide_by_255 (int value)
+        {
+            value += 128;
+
+            return (value + (value >> 8)) >> 8;
+        }
+
+        inline uint8_t to_byte (float value)
+        {
+            return uint8_t(std::min (std::max (value, 0.f), 1.f) * 255.f + .5f);
+        }
+
+        /** Writes the same pixel count times. */
+        void fill_span (uint8_t * target, int count, const uint8_t (& color)[4])
+        {
+            uint32_t pixel;
+
+            std::memcpy (&pixel, color, 4);
+
+            #if defined(BASICS_SOFTWARE_SSE2)
+
+                __m128i pixels = _mm_set1_epi32 (int(pixel));
+
+                for ( ; count >= 4; count -= 4, target += 16)
+                {
+                    _mm_storeu_si128 (reinterpret_cast< __m128i * >(target), pixels);
+                }
+
+            #elif defined(BASICS_SOFTWARE_NEON)
+
+                uint32x4_t pixels = vdupq_n_u32 (pixel);
+
+                for ( ; count >= 4; count -= 4, target += 16)
+                {
+                    vst1q_u32 (reinterpret_cast< uint32_t * >(target), pixels);
+                }
+
+            #endif
+
+            for ( ; count > 0; --count, target += 4)
+            {
+                std::memcpy (target, &pixel, 4);
+            }
+        }
+
+        /** Blends the same color over count pixels using its alpha (the TRANSPARENCY mode). */
+        void blend_span (uint8_t * target, int count, const uint8_t (& color)[4])
+        {
+            int alpha         = color[3];
+            int inverse_alpha = 255 - alpha;
+
+            #if defined(BASICS_SOFTWARE_SSE2)
+
+                // Two pixels fit in a vector of 16 bit lanes, so the source term is repeated twice:
+
+                __m128i zero    = _mm_setzero_si128 ();
+                __m128i inverse = _mm_set1_epi16 (short(inverse_alpha));
+                __m128i source  = _mm_setr_epi16
+                (
+                    short(color[0] * alpha + 128), short(color[1] * alpha + 128), short(color[2] * alpha + 128), short(color[3] * alpha + 128),
+                    short(color[0] * alpha + 128), short(color[1] * alpha + 128), short(color[2] * alpha + 128), short(color[3] * alpha + 128)
+                );
+
+                for ( ; count >= 4; count -= 4, target += 16)
+                {
+                    __m128i pixels = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(target));
+                    __m128i low    = _mm_add_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (pixels, zero), inverse), source);
+                    __m128i high   = _mm_add_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (pixels, zero), inverse), source);
+
+                    low  = _mm_srli_epi16 (_mm_add_epi16 (low,  _mm_srli_epi16 (low,  8)), 8);
+                    high = _mm_srli_epi16 (_mm_add_epi16 (high, _mm_srli_epi16 (high, 8)), 8);
+
+                    _mm_storeu_si128 (reinterpret_cast< __m128i * >(target), _mm_packus_epi16 (low, high));
+                }
+
+            #elif defined(BASICS_SOFTWARE_NEON)
+
+                uint8x8_t  inverse = vdup_n_u8 (uint8_t(inverse_alpha));
+                uint16_t   terms[8];
+
+                for (int index = 0; index < 8; ++index) terms[index] = uint16_t(color[index & 3] * alpha + 128);
+
+                uint16x8_t source = vld1q_u16 (terms);
+
+                for ( ; count >= 4; count -= 4, target += 16)
+                {
+                    uint8x16_t pixels = vld1q_u8 (target);
+                    uint16x8_t low    = vaddq_u16 (vmull_u8 (vget_low_u8  (pixels), inverse), source);
+                    uint16x8_t high   = vaddq_u16 (vmull_u8 (vget_high_u8 (pixels), inverse), source);
+
+                    low  = vaddq_u16 (low,  vshrq_n_u16 (low,  8));
+                    high = vaddq_u16 (high, vshrq_n_u16 (high, 8));
+
+                    vst1q_u8 (target, vcombine_u8 (vshrn_n_u16 (low, 8), vshrn_n_u16 (high, 8)));
+                }
+
+            #endif
+
+            for ( ; count > 0; --count, target += 4)
+            {
+                for (int channel = 0; channel < 4; ++channel)
+                {
+                    target[channel] = uint8_t(divide_by_255 (color[channel] * alpha + target[channel] * inverse_alpha));
+                }
+            }
+        }
+
+        /** Blends one pixel with the given mode, matching the blend functions set by Canvas_ES2. */
+        inline void blend_pixel (uint8_t * target, const uint8_t * source, Canvas::Blending blending)
+        {
+            int alpha = source[3];
+
+            switch (blending)
+            {
+                case Canvas::NONE:
+                {
+                    std::memcpy (target, source, 4);
+                    break;
+                }
+
+                case Canvas::TRANSPARENCY:
+                {
+                    for (int channel = 0; channel < 4; ++channel)
+                    {
+                        target[channel] = uint8_t(divide_by_255 (source[channel] * alpha + target[channel] * (255 - alpha)));
+                    }
+                    break;
+                }
+
+                case Canvas::MULTIPLY:
+                {
+                    for (int channel = 0; channel < 4; ++channel)
+                    {
+                        target[channel] = uint8_t(std::min (255, divide_by_255 (source[channel] * target[channel] + target[channel] * (255 - alpha))));
+                    }
+                    break;
+                }
+
+                case Canvas::ADD:
+                {
+                    for (int channel = 0; channel < 4; ++channel)
+                    {
+                        target[channel] = uint8_t(std::min (255, target[channel] + divide_by_255 (source[channel] * alpha)));
+                    }
+                    break;
+                }
+            }
+        }
+
+        /** Draws a span of a single color choosing the fastest kernel for the blending mode. */
+        inline void solid_span (uint8_t * target, int count, const uint8_t (& color)[4], Canvas::Blending blending)
+        {
+            if (blending == Canvas::NONE || (blending == Canvas::TRANSPARENCY && color[3] == 255))
+            {
+                fill_span (target, count, color);
+            }
+            else
+            if (blending == Canvas::TRANSPARENCY)
+            {
+                if (color[3] != 0) blend_span (target, count, color);
+            }
+            else
+            {
+                for ( ; count > 0; --count, target += 4) blend_pixel (target, color, blending);
+            }
+        }
+
+        /** Bilinear filtering with clamp to edge addressing, like the textures of Canvas_ES2. */
+        inline void sample_bilinear (const Color_Buffer< Rgba8888 > & texels, float u, float v, uint8_t (& result)[4])
+        {
+            int   width  = int(texels.get_width  ());
+            int   height = int(texels.get_height ());
+            float x      = u * width  - .5f;
+            float y      = v * height - .5f;
+            float x0     = std::floor (x);
+            float y0     = std::floor (y);
+            int   fx     = int((x - x0) * 256.f);
+            int   fy     = int((y - y0) * 256.f);
+            int   left   = std::min (std::max (int(x0),     0), width  - 1);
+            int   right  = std::min (std::max (int(x0) + 1, 0), width  - 1);
+            int   top    = std::min (std::max (int(y0),     0), height - 1);
+            int   bottom = std::min (std::max (int(y0) + 1, 0), height - 1);
+
+            const uint8_t * base = reinterpret_cast< const uint8_t * >(texels.buffer.data ());
+            const uint8_t * a    = base + (top    * width + left ) * 4;
+            const uint8_t * b    = base + (top    * width + right) * 4;
+            const uint8_t * c    = base + (bottom * width + left ) * 4;
+            const uint8_t * d    = base + (bottom * width + right) * 4;
+
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                int upper = a[channel] * (256 - fx) + b[channel] * fx;
+                int lower = c[channel] * (256 - fx) + d[channel] * fx;
+
+                result[channel] = uint8_t((upper * (256 - fy) + lower * fy + 32768) >> 16);
+            }
+        }
+
+        // The texture coordinates of the four corners (bottom-left, top-left, bottom-right and
+        // top-right) for every combination of flips. They're the same used by Canvas_ES2:
+
+        const Point2f normal_texture_uvs[] = { { 0.f, 1.f }, { 0.f, 0.f }, { 1.f, 1.f }, { 1.f, 0.f } };
+        const Point2f h_flip_texture_uvs[] = { { 1.f, 1.f }, { 1.f, 0.f }, { 0.f, 1.f }, { 0.f, 0.f } };
+        const Point2f v_flip_texture_uvs[] = { { 0.f, 0.f }, { 0.f, 1.f }, { 1.f, 0.f }, { 1.f, 1.f } };
+        const Point2f d_flip_texture_uvs[] = { { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 0.f }, { 0.f, 1.f } };
+
+        /** Index of the first pixel whose center is not to the left of the given coordinate. */
+        inline int first_pixel (float coordinate)
+        {
+            return int(std::ceil (coordinate - .5f));
+        }
+
+        Point2f anchor (const Point2f & where, const Size2f & size, int handling)
+        {
+            Point2f bottom_left;
+
+            switch (handling & 0x03)
+            {
+                case LEFT:   bottom_left[0] = where[0];                  break;
+                case CENTER: bottom_left[0] = where[0] - size[0] * 0.5f; break;
+                case RIGHT:  bottom_left[0] = where[0] - size[0];        break;
+            }
+
+            switch (handling & 0x0C)
+            {
+                case TOP:    bottom_left[1] = where[1] - size[1];        break;
+                case CENTER: bottom_left[1] = where[1] - size[1] * 0.5f; break;
+                case BOTTOM: bottom_left[1] = where[1];                  break;
+            }
+
+            return bottom_left;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Canvas * Canvas_Software::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        Context * software_context = dynamic_cast< Context * >(context.operator -> ());
+
+        if (software_context)
+        {
+            std::shared_ptr< Canvas > canvas(new Canvas_Software(*software_context, options.size));
+
+            context->add (id, canvas);
+
+            return canvas.get ();
+        }
+
+        return nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Canvas_Software::Canvas_Software(Context & context, const Size2u & size)
+    :
+        context(context),
+        size   { float(size.width), float(size.height) }
+    {
+        statistics = { 0, 0 };
+
+        set_thread_count (0);
+        reset_state      ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::reset_state ()
+    {
+        set_clear_color (0.f, 0.f, 0.f);
+        set_color       (1.f, 1.f, 1.f);
+        set_opacity     (1.f);
+        set_blending    (TRANSPARENCY);
+        set_transform   (Transformation2f());
+    }
+
+    void Canvas_Software::set_size (const Size2u & new_size)
+    {
+        size.width  = float(new_size.width );
+        size.height = float(new_size.height);
+    }
+
+    void Canvas_Software::set_thread_count (unsigned count)
+    {
+        flush ();
+
+        if (count == 0) count = std::max (std::thread::hardware_concurrency (), 1u);
+
+        if (count > 1)
+            thread_pool.reset (new Thread_Pool(count - 1));
+        else
+            thread_pool.reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::set_clear_color (float r, float g, float b)
+    {
+        clear_color[0] = r;
+        clear_color[1] = g;
+        clear_color[2] = b;
+    }
+
+    void Canvas_Software::set_color (float r, float g, float b)
+    {
+        color[0] = r;
+        color[1] = g;
+        color[2] = b;
+    }
+
+    void Canvas_Software::set_opacity (float new_opacity)
+    {
+        opacity = new_opacity;
+    }
+
+    void Canvas_Software::set_blending (Blending new_blending)
+    {
+        blending = new_blending;
+    }
+
+    void Canvas_Software::set_transform (const Transformation2f & new_transform)
+    {
+        transform = new_transform;
+    }
+
+    void Canvas_Software::apply_transform (const Transformation2f & t)
+    {
+        transform = t * transform;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::clear ()
+    {
+        // Nothing drawn before a clear can be seen, so it's dropped before it's rasterized:
+
+        primitives.clear ();
+
+        Primitive primitive = make_primitive (Primitive::CLEAR, nullptr);
+
+        primitive.blending = NONE;
+        primitive.color[0] = to_byte (clear_color[0]);
+        primitive.color[1] = to_byte (clear_color[1]);
+        primitive.color[2] = to_byte (clear_color[2]);
+        primitive.color[3] = 255;
+        primitive.left     = 0;
+        primitive.bottom   = 0;
+        primitive.right    = int(context.get_surface_width  ());
+        primitive.top      = int(context.get_surface_height ());
+
+        primitives.push_back (primitive);
+    }
+
+    void Canvas_Software::draw_point (const Point2f & position)
+    {
+        Vertex point = to_framebuffer (position);
+
+        float  x = std::floor (point.x);
+        float  y = std::floor (point.y);
+
+        add_rectangle (x, y, x + 1.f, y + 1.f);
+    }
+
+    void Canvas_Software::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        add_line (to_framebuffer (a), to_framebuffer (b));
+    }
+
+    void Canvas_Software::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        Vertex va = to_framebuffer (a);
+        Vertex vb = to_framebuffer (b);
+        Vertex vc = to_framebuffer (c);
+
+        add_line (va, vb);
+        add_line (vb, vc);
+        add_line (vc, va);
+    }
+
+    void Canvas_Software::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        add_triangle (to_framebuffer (a), to_framebuffer (b), to_framebuffer (c), nullptr);
+    }
+
+    void Canvas_Software::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Vertex a = to_framebuffer (bottom_left);
+        Vertex b = to_framebuffer ({ bottom_left[0] + size.width, bottom_left[1]               });
+        Vertex c = to_framebuffer ({ bottom_left[0] + size.width, bottom_left[1] + size.height });
+        Vertex d = to_framebuffer ({ bottom_left[0],              bottom_left[1] + size.height });
+
+        add_line (a, b);
+        add_line (b, c);
+        add_line (c, d);
+        add_line (d, a);
+    }
+
+    void Canvas_Software::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        const Transformation2f::Matrix & matrix = transform.matrix;
+
+        if (matrix[0][1] == 0.f && matrix[1][0] == 0.f)
+        {
+            // Without rotation nor shear the rectangle stays axis aligned and takes the fast path:
+
+            Vertex a = to_framebuffer (bottom_left);
+            Vertex b = to_framebuffer ({ bottom_left[0] + size.width, bottom_left[1] + size.height });
+
+            add_rectangle (std::min (a.x, b.x), std::min (a.y, b.y), std::max (a.x, b.x), std::max (a.y, b.y));
+        }
+        else
+        {
+            add_quad (bottom_left, size, normal_texture_uvs, nullptr);
+        }
+    }
+
+    void Canvas_Software::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
+    {
+        const Texture_2D * software_texture = dynamic_cast< const Texture_2D * >(texture);
+
+        if (software_texture)
+        {
+            const Point2f * texture_uvs;
+
+            switch (handling & 0xF0)
+            {
+                case FLIP_HORIZONTAL:  texture_uvs = h_flip_texture_uvs; break;
+                case FLIP_VERTICAL:    texture_uvs = v_flip_texture_uvs; break;
+                case FLIP_HORIZONTAL | FLIP_VERTICAL:
+                                       texture_uvs = d_flip_texture_uvs; break;
+                default:               texture_uvs = normal_texture_uvs; break;
+            }
+
+            add_quad (anchor (where, size, handling), size, texture_uvs, software_texture);
+        }
+    }
+
+    void Canvas_Software::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        if (!slice || !slice->atlas)
+        {
+            return;
+        }
+
+        const Texture_2D * software_texture = dynamic_cast< const Texture_2D * >(slice->atlas->get_texture ().get ());
+
+        if (software_texture)
+        {
+            Point2f texture_uvs[] =
+            {
+                { slice->uv_left,  slice->uv_top    },
+                { slice->uv_left,  slice->uv_bottom },
+                { slice->uv_right, slice->uv_top    },
+                { slice->uv_right, slice->uv_bottom },
+            };
+
+            if (handling & FLIP_HORIZONTAL)
+            {
+                std::swap (texture_uvs[0][0], texture_uvs[2][0]);
+                std::swap (texture_uvs[1][0], texture_uvs[3][0]);
+            }
+
+            if (handling & FLIP_VERTICAL)
+            {
+                std::swap (texture_uvs[0][1], texture_uvs[1][1]);
+                std::swap (texture_uvs[2][1], texture_uvs[3][1]);
+            }
+
+            add_quad (anchor (where, size, handling), size, texture_uvs, software_texture);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::flush ()
+    {
+        statistics = { unsigned(primitives.size ()), 0 };
+
+        if (primitives.empty ())
+        {
+            return;
+        }
+
+        int tiles_x = (int(context.get_surface_width  ()) + tile_size - 1) / tile_size;
+        int tiles_y = (int(context.get_surface_height ()) + tile_size - 1) / tile_size;
+
+        tile_bins.resize (size_t(tiles_x * tiles_y));
+
+        for (auto & bin : tile_bins) bin.clear ();
+
+        // Binning keeps the submission order inside every tile:
+
+        for (unsigned index = 0, count = unsigned(primitives.size ()); index < count; ++index)
+        {
+            const Primitive & primitive = primitives[index];
+
+            int first_column = std::max (primitive.left   / tile_size, 0);
+            int first_row    = std::max (primitive.bottom / tile_size, 0);
+            int last_column  = std::min ((primitive.right - 1) / tile_size, tiles_x - 1);
+            int last_row     = std::min ((primitive.top   - 1) / tile_size, tiles_y - 1);
+
+            for (int row = first_row; row <= last_row; ++row)
+            {
+                for (int column = first_column; column <= last_column; ++column)
+                {
+                    tile_bins[size_t(row * tiles_x + column)].push_back (index);
+                }
+            }
+        }
+
+        touched_tiles.clear ();
+
+        for (unsigned index = 0, count = unsigned(tile_bins.size ()); index < count; ++index)
+        {
+            if (!tile_bins[index].empty ()) touched_tiles.push_back (index);
+        }
+
+        statistics.tiles = unsigned(touched_tiles.size ());
+
+        if (thread_pool)
+        {
+            thread_pool->parallel_for
+            (
+                unsigned(touched_tiles.size ()),
+                [this] (unsigned index) { rasterize_tile (touched_tiles[index]); }
+            );
+        }
+        else
+        {
+            for (unsigned tile_index : touched_tiles) rasterize_tile (tile_index);
+        }
+
+        primitives.clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Canvas_Software::Vertex Canvas_Software::to_framebuffer (const Point2f & point, float u, float v) const
+    {
+        const Transformation2f::Matrix & matrix = transform.matrix;
+
+        float x = matrix[0][0] * point[0] + matrix[0][1] * point[1] + matrix[0][2];
+        float y = matrix[1][0] * point[0] + matrix[1][1] * point[1] + matrix[1][2];
+
+        const Point2u & origin   = context.get_viewport_origin ();
+        const Size2u  & viewport = context.get_viewport_size   ();
+
+        return
+        {
+            float(origin[0]) + x * float(viewport.width ) / size.width,
+            float(origin[1]) + y * float(viewport.height) / size.height,
+            u,
+            v
+        };
+    }
+
+    Canvas_Software::Primitive Canvas_Software::make_primitive (Primitive::Kind kind, const Texture_2D * texture) const
+    {
+        Primitive primitive;
+
+        primitive.kind     = kind;
+        primitive.blending = blending;
+        primitive.texture  = texture;
+
+        // Textures aren't tinted by the color, only faded by the opacity, as in Canvas_ES2:
+
+        primitive.color[0] = texture ? 255 : to_byte (color[0]);
+        primitive.color[1] = texture ? 255 : to_byte (color[1]);
+        primitive.color[2] = texture ? 255 : to_byte (color[2]);
+        primitive.color[3] = to_byte (opacity);
+
+        return primitive;
+    }
+
+    void Canvas_Software::add_rectangle (float left, float bottom, float right, float top)
+    {
+        const Point2u & origin   = context.get_viewport_origin ();
+        const Size2u  & viewport = context.get_viewport_size   ();
+
+        Primitive primitive = make_primitive (Primitive::RECTANGLE, nullptr);
+
+        primitive.left   = std::max (first_pixel (left  ), int(origin[0]));
+        primitive.bottom = std::max (first_pixel (bottom), int(origin[1]));
+        primitive.right  = std::min (first_pixel (right ), int(origin[0] + viewport.width ));
+        primitive.top    = std::min (first_pixel (top   ), int(origin[1] + viewport.height));
+
+        if (primitive.left < primitive.right && primitive.bottom < primitive.top)
+        {
+            primitives.push_back (primitive);
+        }
+    }
+
+    void Canvas_Software::add_triangle (const Vertex & a, const Vertex & b, const Vertex & c, const Texture_2D * texture)
+    {
+        float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+        if (area == 0.f)
+        {
+            return;
+        }
+
+        const Point2u & origin   = context.get_viewport_origin ();
+        const Size2u  & viewport = context.get_viewport_size   ();
+
+        Primitive primitive = make_primitive (Primitive::TRIANGLE, texture);
+
+        // The vertices are kept in counterclockwise order, so the inside is left of every edge:
+
+        primitive.vertices[0] = a;
+        primitive.vertices[1] = area > 0.f ? b : c;
+        primitive.vertices[2] = area > 0.f ? c : b;
+
+        primitive.left   = std::max (first_pixel (std::min ({ a.x, b.x, c.x })), int(origin[0]));
+        primitive.bottom = std::max (first_pixel (std::min ({ a.y, b.y, c.y })), int(origin[1]));
+        primitive.right  = std::min (first_pixel (std::max ({ a.x, b.x, c.x })), int(origin[0] + viewport.width ));
+        primitive.top    = std::min (first_pixel (std::max ({ a.y, b.y, c.y })), int(origin[1] + viewport.height));
+
+        if (primitive.left < primitive.right && primitive.bottom < primitive.top)
+        {
+            primitives.push_back (primitive);
+        }
+    }
+
+    void Canvas_Software::add_quad (const Point2f & bottom_left, const Size2f & size, const Point2f * texture_uvs, const Texture_2D * texture)
+    {
+        float  left   = bottom_left[0];
+        float  bottom = bottom_left[1];
+        float  right  = left   + size.width;
+        float  top    = bottom + size.height;
+
+        Vertex corners[] =
+        {
+            to_framebuffer ({ left,  bottom }, texture_uvs[0][0], texture_uvs[0][1]),
+            to_framebuffer ({ left,  top    }, texture_uvs[1][0], texture_uvs[1][1]),
+            to_framebuffer ({ right, bottom }, texture_uvs[2][0], texture_uvs[2][1]),
+            to_framebuffer ({ right, top    }, texture_uvs[3][0], texture_uvs[3][1]),
+        };
+
+        // Same split as the index buffer of Canvas_ES2. The fill rule avoids blending twice the
+        // pixels of the shared diagonal:
+
+        add_triangle (corners[0], corners[1], corners[2], texture);
+        add_triangle (corners[2], corners[1], corners[3], texture);
+    }
+
+    void Canvas_Software::add_line (const Vertex & a, const Vertex & b)
+    {
+        float dx     = b.x - a.x;
+        float dy     = b.y - a.y;
+        float length = std::sqrt (dx * dx + dy * dy);
+
+        if (length < 1e-6f)
+        {
+            add_rectangle (std::floor (a.x), std::floor (a.y), std::floor (a.x) + 1.f, std::floor (a.y) + 1.f);
+            return;
+        }
+
+        // One pixel wide quad centered on the segment:
+
+        float nx = -dy / length * .5f;
+        float ny =  dx / length * .5f;
+
+        Vertex corners[] =
+        {
+            { a.x + nx, a.y + ny, 0.f, 0.f },
+            { a.x - nx, a.y - ny, 0.f, 0.f },
+            { b.x + nx, b.y + ny, 0.f, 0.f },
+            { b.x - nx, b.y - ny, 0.f, 0.f },
+        };
+
+        add_triangle (corners[0], corners[1], corners[2], nullptr);
+        add_triangle (corners[2], corners[1], corners[3], nullptr);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::rasterize_tile (unsigned tile_index)
+    {
+        Color_Buffer< Rgba8888 > & framebuffer = context.get_framebuffer ();
+
+        int      width       = int(framebuffer.get_width  ());
+        int      height      = int(framebuffer.get_height ());
+        int      tiles_x     = (width + tile_size - 1) / tile_size;
+        int      tile_left   = int(tile_index) % tiles_x * tile_size;
+        int      tile_bottom = int(tile_index) / tiles_x * tile_size;
+        int      tile_right  = std::min (tile_left   + tile_size, width );
+        int      tile_top    = std::min (tile_bottom + tile_size, height);
+        uint8_t * pixels     = framebuffer;
+
+        for (unsigned primitive_index : tile_bins[tile_index])
+        {
+            const Primitive & primitive = primitives[primitive_index];
+
+            int left   = std::max (primitive.left,   tile_left  );
+            int bottom = std::max (primitive.bottom, tile_bottom);
+            int right  = std::min (primitive.right,  tile_right );
+            int top    = std::min (primitive.top,    tile_top   );
+
+            if (left >= right || bottom >= top) continue;
+
+            if (primitive.kind != Primitive::TRIANGLE)
+            {
+                for (int y = bottom; y < top; ++y)
+                {
+                    solid_span (pixels + (size_t(y) * width + left) * 4, right - left, primitive.color, primitive.blending);
+                }
+
+                continue;
+            }
+
+            const Vertex (& v)[3] = primitive.vertices;
+
+            // Edge i goes from vertex i to vertex i + 1. Its function is A * x + B * y + C, which is
+            // positive inside the triangle:
+
+            float edge_a[3], edge_b[3], edge_c[3];
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                const Vertex & from = v[edge];
+                const Vertex & to   = v[(edge + 1) % 3];
+
+                edge_a[edge] = from.y - to.y;
+                edge_b[edge] = to.x - from.x;
+                edge_c[edge] = from.x * to.y - from.y * to.x;
+            }
+
+            // The texture coordinates are linear in x and y, so they're stepped along each span:
+
+            float du_dx = 0.f, du_dy = 0.f, dv_dx = 0.f, dv_dy = 0.f;
+
+            if (primitive.texture)
+            {
+                float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+
+                du_dx = ((v[1].u - v[0].u) * (v[2].y - v[0].y) - (v[2].u - v[0].u) * (v[1].y - v[0].y)) / area;
+                du_dy = ((v[2].u - v[0].u) * (v[1].x - v[0].x) - (v[1].u - v[0].u) * (v[2].x - v[0].x)) / area;
+                dv_dx = ((v[1].v - v[0].v) * (v[2].y - v[0].y) - (v[2].v - v[0].v) * (v[1].y - v[0].y)) / area;
+                dv_dy = ((v[2].v - v[0].v) * (v[1].x - v[0].x) - (v[1].v - v[0].v) * (v[2].x - v[0].x)) / area;
+            }
+
+            for (int y = bottom; y < top; ++y)
+            {
+                float center_y = float(y) + .5f;
+                int   start    = left;
+                int   end      = right;
+
+                // Edges that face right bound the span from the left and include the pixels whose
+                // center lies exactly on them. The rest bound it from the right and exclude them,
+                // so two triangles sharing an edge never cover the same pixel:
+
+                for (int edge = 0; edge < 3 && start < end; ++edge)
+                {
+                    float offset = edge_b[edge] * center_y + edge_c[edge];
+
+                    if (edge_a[edge] > 0.f)
+                    {
+                        start = std::max (start, first_pixel (-offset / edge_a[edge]));
+                    }
+                    else
+                    if (edge_a[edge] < 0.f)
+                    {
+                        end   = std::min (end,   first_pixel (-offset / edge_a[edge]));
+                    }
+                    else
+                    if (edge_b[edge] > 0.f ? offset < 0.f : offset <= 0.f)
+                    {
+                        end   = start;
+                    }
+                }
+
+                if (start >= end) continue;
+
+                uint8_t * target = pixels + (size_t(y) * width + start) * 4;
+
+                if (!primitive.texture)
+                {
+                    solid_span (target, end - start, primitive.color, primitive.blending);
+                    continue;
+                }
+
+                const Color_Buffer< Rgba8888 > & texels = primitive.texture->get_color_buffer ();
+
+                float center_x = float(start) + .5f;
+                float u        = v[0].u + du_dx * (center_x - v[0].x) + du_dy * (center_y - v[0].y);
+                float w        = v[0].v + dv_dx * (center_x - v[0].x) + dv_dy * (center_y - v[0].y);
+
+                for (int x = start; x < end; ++x, target += 4, u += du_dx, w += dv_dx)
+                {
+                    uint8_t texel[4];
+
+                    sample_bilinear (texels, u, w, texel);
+
+                    texel[3] = uint8_t(divide_by_255 (texel[3] * primitive.color[3]));
+
+                    blend_pixel (target, texel, primitive.blending);
+                }
+            }
+        }
+    }
+
+}}
@@ -0,0 +1,107 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101225
+ */
+
+#include <fstream>
+#include <basics/software/Context>
+
+namespace basics { namespace software
+{
+
+    bool Context::create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
+    {
+        if (window && window->is_available () && !window->has_graphics_context ())
+        {
+            std::shared_ptr< Graphics_Context > context(new Context(*window.operator -> (), cache, window->get_size ()));
+
+            if (window->set_graphics_context (context))
+            {
+                return context->make_current ();
+            }
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Context::Context(Window & window, Graphics_Resource_Cache * cache, const Size2u & surface_size)
+    :
+        Graphics_Context(window, cache),
+        framebuffer     (surface_size.width, surface_size.height)
+    {
+        frame_count = 0;
+        available   = framebuffer.size () > 0;
+
+        reset_viewport ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Context::flush_and_display ()
+    {
+        if (available)
+        {
+            if (present_callback) present_callback (framebuffer, frame_count);
+
+            frame_count++;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Context::save_frame (const std::string & path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+
+        if (!file) return false;
+
+        unsigned width  = framebuffer.get_width  ();
+        unsigned height = framebuffer.get_height ();
+
+        // Uncompressed true color TGA with 8 bits of alpha. Its default origin is the bottom-left
+        // corner, which matches the row order of the framebuffer:
+
+        const uint8_t header[18] =
+        {
+            0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            uint8_t(width  & 0xFF), uint8_t(width  >> 8),
+            uint8_t(height & 0xFF), uint8_t(height >> 8),
+            32, 8
+        };
+
+        file.write (reinterpret_cast< const char * >(header), sizeof(header));
+
+        std::vector< uint8_t > row(width * 4);
+
+        for (unsigned y = 0; y < height; ++y)
+        {
+            const uint8_t * source = reinterpret_cast< const uint8_t * >(&framebuffer[y * width]);
+
+            for (unsigned x = 0; x < width; ++x, source += 4)
+            {
+                row[x * 4 + 0] = source[2];
+                row[x * 4 + 1] = source[1];
+                row[x * 4 + 2] = source[0];
+                row[x * 4 + 3] = source[3];
+            }
+
+            file.write (reinterpret_cast< const char * >(row.data ()), std::streamsize(row.size ()));
+        }
+
+        return bool(file);
+    }
+
+}}
@@ -0,0 +1,30 @@
+/*
+ * ENABLE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101235
+ */
+
+#include <basics/enable>
+#include <basics/software/Canvas_Software>
+#include <basics/software/Software>
+#include <basics/software/Texture_2D>
+
+namespace basics
+{
+
+    template< >
+    bool enable< Software > ()
+    {
+        software::Canvas_Software::enable ();
+        software::Texture_2D::enable ();
+
+        return true;
+    }
+
+}
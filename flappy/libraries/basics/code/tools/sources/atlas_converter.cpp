@@ -0,0 +1,122 @@
+/*
+ * ATLAS CONVERTER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802251100
+ */
+
+// Herramienta de línea de comandos para el host que convierte los archivos .sprites (XML) de los
+// assets en atlas binarios (.batlas) que se usan sin analizarlos:
+//
+//     basics-atlas-converter <sprites o carpeta>...
+//
+// Las carpetas se recorren recursivamente y cada atlas binario se guarda junto a su .sprites, que es
+// donde Atlas lo busca.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <basics/Atlas>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    struct
+    {
+        unsigned converted = 0;
+        unsigned failed    = 0;
+    }
+    totals;
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool ends_with (const string & text, const char * suffix)
+    {
+        size_t length = strlen (suffix);
+
+        return text.size () >= length && text.compare (text.size () - length, length, suffix) == 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool convert (const string & sprites_path)
+    {
+        ifstream reader(sprites_path, ios::binary);
+
+        vector< char > text((istreambuf_iterator< char >(reader)), istreambuf_iterator< char >());
+        vector< byte > binary_atlas;
+
+        if (text.empty () || !Atlas::encode (text.data (), text.size (), binary_atlas))
+        {
+            fprintf (stderr, "%s: can't be converted.\n", sprites_path.c_str ());
+            return false;
+        }
+
+        string   binary_path = Atlas::get_binary_path_for (sprites_path);
+        ofstream writer(binary_path, ios::binary | ios::trunc);
+
+        writer.write (reinterpret_cast< const char * >(binary_atlas.data ()), binary_atlas.size ());
+
+        if (!writer)
+        {
+            fprintf (stderr, "%s: can't be written.\n", binary_path.c_str ());
+            return false;
+        }
+
+        size_t count = (binary_atlas.size () - Atlas::header_size) / sizeof(Atlas::Record);
+
+        printf ("%s: %zu slices, %zu bytes (sprites: %zu bytes)\n", binary_path.c_str (), count, binary_atlas.size (), text.size ());
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int visit (const char * path, const struct stat * , int type, struct FTW * )
+    {
+        if (type == FTW_F && ends_with (path, ".sprites"))
+        {
+            if (convert (path)) totals.converted++; else totals.failed++;
+        }
+
+        return 0;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main (int argc, char * argv[])
+{
+    if (argc < 2)
+    {
+        fprintf (stderr, "usage: %s <sprites file or folder>...\n", argv[0]);
+        return 2;
+    }
+
+    for (int index = 1; index < argc; ++index)
+    {
+        if (nftw (argv[index], visit, 16, FTW_PHYS) != 0)
+        {
+            fprintf (stderr, "%s: can't be read.\n", argv[index]);
+            totals.failed++;
+        }
+    }
+
+    printf ("%u converted, %u failed.\n", totals.converted, totals.failed);
+
+    return totals.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+/*
+ * ATLAS PARSE BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802251700
+ */
+
+// Compara el tiempo y el número de reservas de memoria que necesita Atlas para leer un archivo
+// .sprites con Xml_Scanner frente a como se hacía antes con rapidxml (copiando el texto, formando
+// los ids con cadenas y convirtiendo los números con atoi):
+//
+//     basics-atlas-benchmark [slices [slices por carpeta]]
+//
+// El archivo se genera en memoria con carpetas anidadas de dos niveles. También se comprueba que
+// ambos caminos producen los mismos slices.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <rapidxml.hpp>
+#include <basics/Atlas>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    atomic< size_t > allocations(0);
+
+    const double minimum_seconds    = 0.25;
+    const int    minimum_iterations = 5;
+
+    struct Rectangle
+    {
+        int x, y, w, h;
+    };
+
+    typedef map< Id, Rectangle > Rectangle_Map;
+
+    // ---------------------------------------------------------------------------------------------
+    // Lectura con rapidxml tal como la hacía Atlas antes de usar Xml_Scanner:
+
+    void rapidxml_parse_dir (rapidxml::xml_node<> * dir_tag, Rectangle_Map & slices, const string & prefix = string())
+    {
+        using namespace rapidxml;
+
+        for (xml_node<> * child = dir_tag->first_node (); child; child = child->next_sibling ())
+        {
+            if (child->type () != node_element) continue;
+
+            xml_attribute<> * name_attribute = child->first_attribute ("name");
+
+            if (!name_attribute) continue;
+
+            string id = prefix + name_attribute->value ();
+
+            if (child->name () == string("dir"))
+            {
+                if (id == "/") id.clear (); else id += ".";
+
+                rapidxml_parse_dir (child, slices, id);
+            }
+            else
+            if (child->name () == string("spr"))
+            {
+                xml_attribute<> * x_attribute = child->first_attribute ("x");
+                xml_attribute<> * y_attribute = child->first_attribute ("y");
+                xml_attribute<> * w_attribute = child->first_attribute ("w");
+                xml_attribute<> * h_attribute = child->first_attribute ("h");
+
+                if (x_attribute && y_attribute && w_attribute && h_attribute)
+                {
+                    slices.insert
+                    ({
+                        fnv32 (id),
+                        {
+                            atoi (x_attribute->value ()), atoi (y_attribute->value ()),
+                            atoi (w_attribute->value ()), atoi (h_attribute->value ())
+                        }
+                    });
+                }
+            }
+        }
+    }
+
+    void rapidxml_parse (const string & sprites, Rectangle_Map & slices)
+    {
+        using namespace rapidxml;
+
+        vector< char > text;
+
+        text.reserve   (sprites.size () + 1);
+        text.assign    (sprites.begin (), sprites.end ());
+        text.push_back (0);
+
+        xml_document<> xml;
+
+        xml.parse< 0 > (text.data ());
+
+        xml_node<> * img_tag = xml.first_node ("img");
+
+        if (!img_tag) return;
+
+        xml_node<> * definitions_tag = img_tag->first_node ();
+
+        if (definitions_tag && definitions_tag->name () == string("definitions"))
+        {
+            for (xml_node<> * dir_tag = definitions_tag->first_node ("dir"); dir_tag; dir_tag = dir_tag->next_sibling ("dir"))
+            {
+                rapidxml_parse_dir (dir_tag, slices);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    string generate (unsigned slice_count, unsigned slices_per_folder)
+    {
+        string sprites = "<?xml version=\"1.0\"?>\n<img name=\"synthetic.png\" w=\"4096\" h=\"4096\">\n  <definitions>\n    <dir name=\"/\">\n";
+        char   line[160];
+
+        for (unsigned index = 0; index < slice_count; ++index)
+        {
+            if (index % slices_per_folder == 0)
+            {
+                if (index > 0) sprites += "        </dir>\n      </dir>\n";
+
+                snprintf (line, sizeof(line), "      <dir name=\"group%u\">\n        <dir name=\"frames\">\n", index / slices_per_folder);
+                sprites += line;
+            }
+
+            snprintf
+            (
+                line, sizeof(line), "          <spr name=\"sprite%u\" x=\"%u\" y=\"%u\" w=\"%u\" h=\"%u\"/>\n",
+                index, index * 37 % 4000, index * 53 % 4000, 8 + index % 80, 8 + index % 90
+            );
+
+            sprites += line;
+        }
+
+        if (slice_count > 0) sprites += "        </dir>\n      </dir>\n";
+
+        sprites += "    </dir>\n  </definitions>\n</img>\n";
+
+        return sprites;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    double measure (const char * name, const function< void () > & parse, double reference_milliseconds = 0)
+    {
+        typedef chrono::steady_clock Clock;
+
+        size_t            allocations_before = allocations;
+
+        parse ();
+
+        size_t            allocations_per_parse = allocations - allocations_before;
+        int               iterations = 0;
+        Clock::time_point start      = Clock::now ();
+        double            seconds;
+
+        do
+        {
+            parse ();
+            iterations++;
+            seconds = chrono::duration< double >(Clock::now () - start).count ();
+        }
+        while (iterations < minimum_iterations || seconds < minimum_seconds);
+
+        double milliseconds = seconds * 1000.0 / iterations;
+
+        printf ("%-12s %10.3f %12zu", name, milliseconds, allocations_per_parse);
+
+        if (reference_milliseconds > 0) printf (" %8.2fx", reference_milliseconds / milliseconds);
+
+        printf ("\n");
+
+        return milliseconds;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+// Se cuentan todas las reservas de memoria del programa:
+
+void * operator new (size_t size)
+{
+    allocations++;
+
+    if (void * memory = malloc (size ? size : 1)) return memory;
+
+    throw bad_alloc();
+}
+
+void operator delete (void * memory) noexcept
+{
+    free (memory);
+}
+
+void operator delete (void * memory, size_t) noexcept
+{
+    free (memory);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main (int argc, char * argv[])
+{
+    unsigned slice_count       = argc > 1 ? unsigned(atoi (argv[1])) : 20000;
+    unsigned slices_per_folder = argc > 2 ? unsigned(atoi (argv[2])) : 100;
+
+    if (slice_count == 0 || slices_per_folder == 0)
+    {
+        fprintf (stderr, "usage: %s [slices [slices per folder]]\n", argv[0]);
+        return 2;
+    }
+
+    string sprites = generate (slice_count, slices_per_folder);
+
+    // Ambos caminos deben leer los mismos slices:
+
+    Rectangle_Map reference;
+
+    rapidxml_parse (sprites, reference);
+
+    Atlas atlas(sprites.data (), sprites.size ());
+
+    bool same = reference.size () == slice_count && atlas.get_slice_count () == slice_count;
+
+    for (auto & item : reference)
+    {
+        const Atlas::Slice * slice = atlas.get_slice (item.first);
+
+        same = same && slice
+                    && slice->left   == item.second.x && slice->bottom == item.second.y
+                    && slice->width  == item.second.w && slice->height == item.second.h;
+    }
+
+    printf ("%u slices, %zu bytes of XML: %s\n\n", slice_count, sprites.size (), same ? "same slices" : "MISMATCH");
+    printf ("%-12s %10s %12s %9s\n", "parser", "ms/parse", "allocations", "speedup");
+
+    double reference_milliseconds = measure ("rapidxml", [&sprites] () { Rectangle_Map slices; rapidxml_parse (sprites, slices); });
+
+    measure ("xml scanner", [&sprites] () { Atlas atlas(sprites.data (), sprites.size ()); }, reference_milliseconds);
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+/*
+ * CANVAS STATS CHECK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803061100
+ */
+
+// Dibuja unos frames de prueba con el Canvas_ES2 sobre el GL_Recorder (sin GPU) y comprueba que las
+// estadísticas de cada frame (Canvas::get_frame_stats()) cuadran con las llamadas a OpenGL ES que
+// se grabaron. Sirve de modelo para las comprobaciones de rendimiento del tipo "la escena se dibuja
+// con N draw calls como mucho":
+//
+//     basics-canvas-stats-check [sprites] [máximo de draw calls] [fichero de llamadas]
+//
+// Termina con 1 si algo no cuadra o si algún frame supera el máximo de draw calls. Si se indica un
+// fichero, se escribe en él la secuencia de llamadas del último frame.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <basics/Canvas>
+#include <basics/Color_Buffer>
+#include <basics/enable>
+#include <basics/Window>
+#include <basics/opengles/GL_Recorder>
+#include <basics/opengles/OpenGL_ES2>
+
+using namespace basics;
+using namespace std;
+
+using opengles::GL_Recorder;
+
+namespace
+{
+
+    const unsigned sprites_per_texture = 8;
+
+    // ---------------------------------------------------------------------------------------------
+
+    // Lo que las estadísticas deberían decir según las llamadas grabadas. Lo anterior al glClear()
+    // del frame (la creación de las texturas) solo cuenta para los bytes de las texturas:
+
+    Canvas::Frame_Stats count_calls (const vector< GL_Recorder::Call > & calls)
+    {
+        Canvas::Frame_Stats expected = Canvas::Frame_Stats();
+        bool                cleared  = false;
+
+        for (auto & call : calls)
+        {
+            const char * function = call.function;
+
+            if (strcmp (function, "glTexImage2D") == 0)
+            {
+                expected.texture_upload_bytes += size_t(call.arguments[1] * call.arguments[2]) * 4;
+            }
+            else
+            if (strcmp (function, "glClear") == 0)
+            {
+                cleared = true;
+            }
+            else
+            if (cleared)
+            {
+                if (strcmp (function, "glDrawElements") == 0)
+                {
+                    expected.draw_calls++;
+                    expected.vertices += unsigned(call.arguments[1] / 6 * 4);
+                    expected.quads    += unsigned(call.arguments[1] / 6);
+                }
+                else
+                if (strcmp (function, "glDrawArrays") == 0)
+                {
+                    expected.draw_calls++;
+                    expected.vertices       += unsigned(call.arguments[2]);
+                    expected.bytes_streamed += size_t(call.arguments[2]) * sizeof(float) * 2;
+                }
+                else
+                if (strcmp (function, "glBufferSubData"   ) == 0) expected.bytes_streamed += size_t(call.arguments[2]); else
+                if (strcmp (function, "glUseProgram"      ) == 0) expected.program_switches++;                         else
+                if (strcmp (function, "glBindTexture"     ) == 0) expected.texture_binds++;                            else
+                if (strcmp (function, "glUniformMatrix3fv") == 0) expected.uniform_uploads++;
+            }
+        }
+
+        return expected;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool same (const Canvas::Frame_Stats & a, const Canvas::Frame_Stats & b)
+    {
+        return a.draw_calls           == b.draw_calls
+            && a.vertices             == b.vertices
+            && a.quads                == b.quads
+            && a.program_switches     == b.program_switches
+            && a.texture_binds        == b.texture_binds
+            && a.uniform_uploads      == b.uniform_uploads
+            && a.bytes_streamed       == b.bytes_streamed
+            && a.texture_upload_bytes == b.texture_upload_bytes;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void print (const char * label, const Canvas::Frame_Stats & stats)
+    {
+        printf
+        (
+            "  %-10s %10u %10u %10u %10u %10u %10u %10zu %10zu\n",
+            label,
+            stats.draw_calls,
+            stats.vertices,
+            stats.quads,
+            stats.program_switches,
+            stats.texture_binds,
+            stats.uniform_uploads,
+            stats.bytes_streamed,
+            stats.texture_upload_bytes
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    // Un frame parecido al de una escena: un fondo liso, sprites que van cambiando de textura, un
+    // cambio de transformación a mitad y unas líneas de depuración:
+
+    void draw_frame (Canvas & canvas, const vector< shared_ptr< Texture_2D > > & textures, size_t sprites)
+    {
+        canvas.clear ();
+
+        canvas.set_transform  (Transformation2f());
+        canvas.set_color      (.2f, .4f, .8f);
+        canvas.fill_rectangle ({ 0.f, 0.f }, { 720.f, 1280.f });
+
+        for (size_t index = 0; index < sprites; ++index)
+        {
+            if (index == sprites / 2)
+            {
+                canvas.set_transform (translate_then_scale_2d (Vector2f{ 10.f, 10.f }, 1.f, 1.f));
+            }
+
+            Point2f where{ float(index % 16) * 40.f, float(index / 16 % 32) * 40.f };
+
+            canvas.fill_rectangle (where, { 32.f, 32.f }, textures[index / sprites_per_texture % textures.size ()].get ());
+        }
+
+        canvas.set_color    (1.f, 1.f, 1.f);
+        canvas.draw_segment ({ 0.f, 640.f }, { 720.f, 640.f });
+        canvas.draw_segment ({ 360.f, 0.f }, { 360.f, 1280.f });
+
+        canvas.flush ();
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    size_t       sprites    = number_of_arguments > 1 ? size_t(atoi (arguments[1])) : 256;
+    unsigned     max_draws  = number_of_arguments > 2 ? unsigned(atoi (arguments[2])) : 0;
+    const char * calls_path = number_of_arguments > 3 ? arguments[3] : nullptr;
+
+    if (sprites == 0)
+    {
+        printf ("usage: basics-canvas-stats-check [sprites] [max draw calls] [calls file]\n");
+        return 1;
+    }
+
+    enable< OpenGL_ES2 > ();
+
+    GL_Recorder & recorder = GL_Recorder::get_instance ();
+    bool          good     = true;
+
+    {
+        Window::Accessor window = Window::create_window (default_window_id).lock ();
+
+        if (!GL_Recorder::create_context (window, nullptr))
+        {
+            printf ("the recording context couldn't be created\n");
+            return 1;
+        }
+
+        Graphics_Context::Accessor context = window->lock_graphics_context ();
+        Canvas                   * canvas  = Canvas::create (ID(canvas), context, { window->get_size () });
+
+        if (!canvas)
+        {
+            printf ("the canvas couldn't be created\n");
+            return 1;
+        }
+
+        printf ("%zu sprites, %u per texture\n\n", sprites, sprites_per_texture);
+        printf ("  %-10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "frame", "draws", "vertices", "quads", "programs", "textures", "uniforms", "streamed", "uploaded");
+
+        vector< shared_ptr< Texture_2D > > textures;
+
+        for (unsigned frame = 1; frame <= 3; ++frame)
+        {
+            recorder.clear ();
+
+            // Las texturas se crean durante el primer frame, como al cargar una escena:
+
+            if (frame == 1)
+            {
+                for (unsigned index = 0; index < 4; ++index)
+                {
+                    Color_Buffer< Rgba8888 > pixels(64, 64);
+                    Texture_2D::Options      options = {};
+
+                    options.width  = 64;
+                    options.height = 64;
+
+                    textures.push_back (Texture_2D::create (0, context, pixels, options));
+
+                    context->add (textures.back ());
+                }
+            }
+
+            draw_frame (*canvas, textures, sprites);
+
+            context->flush_and_display ();
+
+            Canvas::Frame_Stats stats    = canvas->get_frame_stats ();
+            Canvas::Frame_Stats expected = count_calls (recorder.get_calls ());
+            char                label[16];
+
+            snprintf (label, sizeof(label), "%u", frame);
+
+            print (label, stats);
+
+            if (!same (stats, expected))
+            {
+                print ("expected", expected);
+
+                good = false;
+            }
+
+            if (max_draws > 0 && stats.draw_calls > max_draws)
+            {
+                printf ("  frame %u takes %u draw calls (at most %u were expected)\n", frame, stats.draw_calls, max_draws);
+
+                good = false;
+            }
+
+            // Como hace el Director al terminar cada frame:
+
+            canvas->reset_frame_stats ();
+        }
+
+        if (calls_path)
+        {
+            ofstream output(calls_path);
+
+            recorder.write (output);
+        }
+    }
+
+    // El contexto se elimina con la ventana mientras el recorder sigue existiendo:
+
+    Window::destroy_window (default_window_id);
+
+    printf ("\n%s\n", good ? "OK" : "FAILED");
+
+    return good ? 0 : 1;
+}
@@ -0,0 +1,326 @@
+/*
+ * EVENT BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802261400
+ */
+
+// Mide cuántos eventos de toque por segundo se pueden crear, copiar y sacar de una cola, cuántas
+// reservas de memoria se hacen por evento y cuánto tarda cada evento en pasar de un hilo de entrada
+// a otro que los consume como lo haría una escena (latencia):
+//
+//     basics-event-benchmark [eventos [eventos/s]]
+//
+// Se comparan tres casos: un evento con sus propiedades en un std::map que pasa por una cola con
+// un mutex (como se hacía antes), Event con esa misma cola, y Event con Input_Event_Queue, que se
+// vacía de una pasada con drain(). Para medir la latencia el hilo de entrada produce los eventos
+// a un ritmo fijo, muy superior al de cualquier pantalla táctil (200000 por segundo por defecto).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <thread>
+#include <vector>
+#include <basics/Event>
+#include <basics/Event_Queue>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    typedef chrono::steady_clock Clock;
+
+    atomic< size_t > allocations(0);
+
+    struct Map_Event
+    {
+        Id                  id;
+        int                 priority;
+        std::map< Id, Var > properties;
+
+        Map_Event(Id id = 0) : id(id), priority(0)
+        {
+        }
+
+        Var & operator [] (const Id & id)
+        {
+            return properties[id];
+        }
+    };
+
+    // Cola con un mutex como la que usaban Director, Window y Application:
+
+    template< typename EVENT >
+    class Mutex_Queue
+    {
+
+        std::queue< EVENT > queue;
+        std::mutex          mutex;
+
+    public:
+
+        void push (const EVENT & event)
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            queue.push (event);
+        }
+
+        bool pop (EVENT & event)
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            if (queue.size () > 0)
+            {
+                event = queue.front ();
+
+                queue.pop ();
+
+                return true;
+            }
+
+            return false;
+        }
+
+        template< typename CALLBACK >
+        size_t drain (CALLBACK && callback)
+        {
+            EVENT  event;
+            size_t count = 0;
+
+            while (pop (event))
+            {
+                callback (event);
+                count++;
+            }
+
+            return count;
+        }
+
+        uint64_t get_dropped () const
+        {
+            return 0;
+        }
+
+    };
+
+    class Ring_Queue_Adapter : public Input_Event_Queue
+    {
+    public:
+
+        Ring_Queue_Adapter() : Input_Event_Queue(256, Overflow_Policy::DROP_OLDEST)
+        {
+        }
+
+        uint64_t get_dropped () const
+        {
+            return get_counters ().dropped;
+        }
+
+    };
+
+    struct Result
+    {
+        double events_per_second;
+        double allocations_per_event;
+        double latency_50;                                  // Microsegundos
+        double latency_99;
+        double dropped;                                     // Porcentaje
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename EVENT >
+    EVENT make_touch (unsigned index)
+    {
+        EVENT event(ID(touch-moved));
+
+        event[ID(id)] = int32_t(index);
+        event[ID(x) ] = float(index % 720);
+        event[ID(y) ] = float(index % 1280);
+
+        return event;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename EVENT, typename QUEUE >
+    Result measure_threads (unsigned count, unsigned rate)
+    {
+        QUEUE                       queue;
+        vector< Clock::time_point > push_times(count);
+        vector< float             > latencies;
+        atomic< bool >              done(false);
+        float                       sum = 0;
+
+        latencies.reserve (count);
+
+        size_t            allocations_before = allocations;
+        Clock::time_point start              = Clock::now ();
+
+        // El hilo de entrada produce los eventos mientras el de la escena los consume:
+
+        thread input
+        (
+            [&queue, &push_times, &done, count, rate] ()
+            {
+                Clock::time_point first  = Clock::now ();
+                chrono::duration< double > period(1.0 / rate);
+
+                for (unsigned index = 0; index < count; ++index)
+                {
+                    Clock::time_point due = first + chrono::duration_cast< Clock::duration >(period * index);
+
+                    // Como hace el hardware, los eventos que se acumulan mientras el hilo duerme
+                    // se envían juntos:
+
+                    if (Clock::now () < due) this_thread::sleep_until (due);
+
+                    push_times[index] = Clock::now ();
+                    queue.push (make_touch< EVENT > (index));
+                }
+
+                done = true;
+            }
+        );
+
+        auto handle = [&] (EVENT & event)
+        {
+            Clock::time_point now   = Clock::now ();
+            unsigned          index = unsigned(*event[ID(id)].template as< var::Int32 > ());
+
+            latencies.push_back (chrono::duration< float, micro >(now - push_times[index]).count ());
+
+            sum += *event[ID(x)].template as< var::Float > ();
+        };
+
+        for (bool finished = false; !finished; )
+        {
+            finished = done;
+
+            if (queue.drain (handle) == 0) this_thread::yield ();
+        }
+
+        input.join ();
+
+        queue.drain (handle);
+
+        double seconds = chrono::duration< double >(Clock::now () - start).count ();
+        size_t made    = allocations - allocations_before;
+
+        if (sum < 0) printf ("%f", sum);
+
+        sort (latencies.begin (), latencies.end ());
+
+        return
+        {
+            latencies.size () / seconds,
+            double(made) / count,
+            latencies.empty () ? 0.0 : latencies[latencies.size () / 2],
+            latencies.empty () ? 0.0 : latencies[latencies.size () * 99 / 100],
+            100.0 * queue.get_dropped () / count
+        };
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename EVENT, typename QUEUE >
+    Result measure_single_thread (unsigned count)
+    {
+        QUEUE             queue;
+        EVENT             event;
+        float             sum = 0;
+        size_t            allocations_before = allocations;
+        Clock::time_point start = Clock::now ();
+
+        for (unsigned index = 0; index < count; ++index)
+        {
+            EVENT created = make_touch< EVENT > (index);
+            EVENT copy    = created;
+
+            queue.push (copy);
+            queue.pop  (event);
+
+            sum += *event[ID(y)].template as< var::Float > ();
+        }
+
+        double seconds = chrono::duration< double >(Clock::now () - start).count ();
+
+        if (sum < 0) printf ("%f", sum);
+
+        return { count / seconds, double(allocations - allocations_before) / count, 0, 0, 0 };
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void print (const char * name, const Result & result, bool latency)
+    {
+        printf ("%-30s %12.0f %12.2f", name, result.events_per_second, result.allocations_per_event);
+
+        if (latency) printf (" %10.1f %10.1f %9.1f%%", result.latency_50, result.latency_99, result.dropped);
+
+        printf ("\n");
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+// Se cuentan todas las reservas de memoria del programa:
+
+void * operator new (size_t size)
+{
+    allocations++;
+
+    if (void * memory = malloc (size ? size : 1)) return memory;
+
+    throw bad_alloc();
+}
+
+void operator delete (void * memory) noexcept
+{
+    free (memory);
+}
+
+void operator delete (void * memory, size_t) noexcept
+{
+    free (memory);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main (int argc, char * argv[])
+{
+    unsigned count = argc > 1 ? unsigned(atoi (argv[1])) : 1000000;
+    unsigned rate  = argc > 2 ? unsigned(atoi (argv[2])) : 200000;
+
+    if (count == 0 || rate == 0)
+    {
+        fprintf (stderr, "usage: %s [events [events/s]]\n", argv[0]);
+        return 2;
+    }
+
+    printf ("%u touch events with 3 properties (sizeof(Event) = %zu bytes), %u events/s from the input thread\n\n", count, sizeof(Event), rate);
+    printf ("%-30s %12s %12s %10s %10s %10s\n", "", "events/s", "allocs/event", "p50 us", "p99 us", "dropped");
+
+    print ("std::map + mutex copy/pop",     measure_single_thread< Map_Event, Mutex_Queue< Map_Event > > (count),       false);
+    print ("Tiny_Map + mutex copy/pop",     measure_single_thread< Event,     Mutex_Queue< Event     > > (count),       false);
+    print ("Tiny_Map + ring  copy/pop",     measure_single_thread< Event,     Ring_Queue_Adapter       > (count),       false);
+    print ("std::map + mutex input->scene", measure_threads      < Map_Event, Mutex_Queue< Map_Event > > (count, rate), true );
+    print ("Tiny_Map + mutex input->scene", measure_threads      < Event,     Mutex_Queue< Event     > > (count, rate), true );
+    print ("Tiny_Map + ring  input->scene", measure_threads      < Event,     Ring_Queue_Adapter       > (count, rate), true );
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * FRAME ARENA BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803031100
+ */
+
+// Simula los contenedores temporales de un frame (vectores que crecen, cadenas que se concatenan)
+// con el allocator por defecto y con un Frame_Arena que se reinicia en cada frame:
+//
+//     basics-frame-arena-benchmark [contenedores por frame]
+//
+// Los tiempos son microsegundos por frame. Al final se muestra cuánto usó el arena por frame y
+// cuántas veces tuvo que recurrir al heap (solo en los primeros frames, mientras crece).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <basics/Frame_Arena>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    struct Glyph
+    {
+        const void * slice;
+        float        position[2];
+        float        size[2];
+    };
+
+    const double minimum_seconds = 0.2;
+
+    volatile size_t sink;
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename FUNCTION >
+    double measure (FUNCTION function)
+    {
+        typedef chrono::steady_clock Clock;
+
+        Clock::time_point start      = Clock::now ();
+        size_t            iterations = 0;
+        double            seconds;
+
+        do
+        {
+            function ();
+            iterations++;
+            seconds = chrono::duration< double >(Clock::now () - start).count ();
+        }
+        while (seconds < minimum_seconds);
+
+        return seconds * 1e6 / double(iterations);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename VECTOR, typename STRING, typename ALLOCATOR >
+    void simulate_frame (size_t containers, const ALLOCATOR & allocator)
+    {
+        size_t total = 0;
+
+        for (size_t index = 0; index < containers; ++index)
+        {
+            VECTOR glyphs(allocator);
+
+            for (size_t count = 0; count < 24 + index % 16; ++count)
+            {
+                glyphs.push_back (Glyph{ nullptr, { float(count), 0.f }, { 8.f, 8.f } });
+            }
+
+            STRING text(allocator);
+
+            for (size_t count = 0; count < 6; ++count)
+            {
+                text += L"score ";
+            }
+
+            total += glyphs.size () + text.size ();
+        }
+
+        sink = total;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    size_t containers = number_of_arguments > 1 ? size_t(atoi (arguments[1])) : 64;
+
+    if (containers == 0)
+    {
+        printf ("usage: basics-frame-arena-benchmark [containers per frame]\n");
+        return 1;
+    }
+
+    Frame_Arena arena;
+
+    arena.set_debug_mode (false);
+
+    double heap = measure
+    (
+        [containers] ()
+        {
+            simulate_frame< vector< Glyph >, wstring > (containers, allocator< Glyph >());
+        }
+    );
+
+    double arena_time = measure
+    (
+        [containers, &arena] ()
+        {
+            arena.reset ();
+            simulate_frame< Frame_Vector< Glyph >, Frame_Wstring > (containers, Frame_Allocator< Glyph >(arena));
+        }
+    );
+
+    printf ("%zu containers per frame (microseconds per frame)\n\n", containers);
+    printf ("  heap        %10.1f\n", heap);
+    printf ("  arena       %10.1f\n\n", arena_time);
+    printf ("  arena bytes per frame: %zu (capacity %zu, high-water mark %zu, heap allocations %zu)\n",
+            arena.get_frame_bytes (), arena.get_capacity (), arena.get_high_water_mark (), arena.get_heap_allocations ());
+
+    return 0;
+}
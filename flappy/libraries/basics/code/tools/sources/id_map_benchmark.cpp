@@ -0,0 +1,149 @@
+/*
+ * ID MAP BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802261030
+ */
+
+// Compara Id_Map con std::map y std::unordered_map en las operaciones que hace el motor con sus
+// tablas: insertar, buscar ids que están y que no están, y recorrer todos los elementos:
+//
+//     basics-id-map-benchmark
+//
+// Los ids son hashes FNV de nombres, como los de ID(), y los valores ocupan lo mismo que un slice.
+// Los tiempos son nanosegundos por elemento.
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <basics/Id_Map>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    struct Value
+    {
+        float data[11];
+    };
+
+    const double minimum_seconds = 0.1;
+
+    volatile float sink;
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename FUNCTION >
+    double measure (size_t operations, FUNCTION function)
+    {
+        typedef chrono::steady_clock Clock;
+
+        Clock::time_point start      = Clock::now ();
+        size_t            iterations = 0;
+        double            seconds;
+
+        do
+        {
+            function ();
+            iterations++;
+            seconds = chrono::duration< double >(Clock::now () - start).count ();
+        }
+        while (seconds < minimum_seconds);
+
+        return seconds * 1e9 / (double(iterations) * operations);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename MAP >
+    void run (const char * name, const vector< Id > & ids, const vector< Id > & missing)
+    {
+        double insert = measure
+        (
+            ids.size (),
+            [&ids] ()
+            {
+                MAP map;
+                for (Id id : ids) map[id].data[0] = float(id);
+                sink = map[ids[0]].data[0];
+            }
+        );
+
+        MAP map;
+
+        for (Id id : ids) map[id].data[0] = float(id & 0xFF);
+
+        double hit = measure
+        (
+            ids.size (),
+            [&map, &ids] ()
+            {
+                float sum = 0;
+                for (Id id : ids) sum += map.find (id)->second.data[0];
+                sink = sum;
+            }
+        );
+
+        double miss = measure
+        (
+            missing.size (),
+            [&map, &missing] ()
+            {
+                size_t found = 0;
+                for (Id id : missing) found += map.find (id) != map.end ();
+                sink = float(found);
+            }
+        );
+
+        double iterate = measure
+        (
+            ids.size (),
+            [&map] ()
+            {
+                float sum = 0;
+                for (auto & item : map) sum += item.second.data[0];
+                sink = sum;
+            }
+        );
+
+        printf ("  %-20s %8.1f %8.1f %8.1f %8.1f\n", name, insert, hit, miss, iterate);
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main ()
+{
+    for (size_t count : { 16, 256, 4096, 65536 })
+    {
+        vector< Id > ids, missing;
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            ids    .push_back (fnv32 ("sprite" + to_string (index)));
+            missing.push_back (fnv32 ("absent" + to_string (index)));
+        }
+
+        printf ("%zu items (ns per item)\n", count);
+        printf ("  %-20s %8s %8s %8s %8s\n", "", "insert", "find", "miss", "iterate");
+
+        run< Id_Map< Value >               > ("Id_Map",             ids, missing);
+        run< map< Id, Value >              > ("std::map",           ids, missing);
+        run< unordered_map< Id, Value >    > ("std::unordered_map", ids, missing);
+
+        printf ("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * PIXEL CONVERSION BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231200
+ */
+
+// Mide la velocidad de cada kernel de pixel_conversion con los kernels escalares y con los más
+// rápidos disponibles (NEON, AVX2 o SSE2), comprobando además que ambos producen lo mismo:
+//
+//     basics-pixel-benchmark [ancho alto]
+//
+// La imagen de prueba se rellena con valores pseudoaleatorios y su ancho por defecto no es múltiplo
+// de 16 para que también se ejerciten los píxeles sobrantes de cada fila.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <basics/pixel_conversion>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    const double minimum_seconds    = 0.25;
+    const int    minimum_iterations = 5;
+
+    typedef function< void (Color_Buffer< Rgba8888 > & output_32, Color_Buffer< uint16_t > & output_16) > Kernel;
+
+    // ---------------------------------------------------------------------------------------------
+
+    double measure (const Color_Buffer< Rgba8888 > & input, const Kernel & kernel)
+    {
+        typedef chrono::steady_clock Clock;
+
+        Color_Buffer< Rgba8888 > output_32;
+        Color_Buffer< uint16_t > output_16;
+        int                      iterations = 0;
+        Clock::time_point        start      = Clock::now ();
+        double                   seconds;
+
+        do
+        {
+            output_32 = input;                          // The in place kernels need fresh pixels
+            kernel (output_32, output_16);
+            iterations++;
+            seconds = chrono::duration< double >(Clock::now () - start).count ();
+        }
+        while (iterations < minimum_iterations || seconds < minimum_seconds);
+
+        return input.size () * double(iterations) / seconds / 1000000.0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool run (const char * name, const Color_Buffer< Rgba8888 > & input, const Kernel & kernel)
+    {
+        Color_Buffer< Rgba8888 > scalar_32 = input, fast_32 = input;
+        Color_Buffer< uint16_t > scalar_16,         fast_16;
+
+        use_scalar_pixel_conversion (true );
+        kernel (scalar_32, scalar_16);
+        double scalar_speed = measure (input, kernel);
+
+        use_scalar_pixel_conversion (false);
+        kernel (fast_32, fast_16);
+        double fast_speed = measure (input, kernel);
+
+        bool same = scalar_32.buffer == fast_32.buffer && scalar_16.buffer == fast_16.buffer;
+
+        printf
+        (
+            "%-18s %10.1f %10.1f %7.2fx  %s\n",
+            name,
+            scalar_speed,
+            fast_speed,
+            fast_speed / scalar_speed,
+            same ? "ok" : "MISMATCH"
+        );
+
+        return same;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main (int argc, char * argv[])
+{
+    unsigned width  = argc > 2 ? unsigned(atoi (argv[1])) : 1021;
+    unsigned height = argc > 2 ? unsigned(atoi (argv[2])) : 1024;
+
+    if (width == 0 || height == 0)
+    {
+        fprintf (stderr, "usage: %s [width height]\n", argv[0]);
+        return 2;
+    }
+
+    Color_Buffer< Rgba8888 > input(width, height);
+
+    uint32_t seed = 12345;
+
+    for (auto & pixel : input.buffer)
+    {
+        seed  = seed * 1664525u + 1013904223u;
+        pixel = seed;
+    }
+
+    use_scalar_pixel_conversion (false);
+
+    printf ("%ux%u pixels, fast kernels: %s\n\n", width, height, get_pixel_conversion_kernels ());
+    printf ("%-18s %10s %10s %8s\n", "kernel", "scalar", "fast", "speedup");
+    printf ("%-18s %10s %10s\n", "", "Mpixel/s", "Mpixel/s");
+
+    bool good = true;
+
+    good &= run ("rgb565",          input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > & out) { convert_to_rgb565   (in, out, false); });
+    good &= run ("rgb565 dither",   input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > & out) { convert_to_rgb565   (in, out, true ); });
+    good &= run ("rgba4444",        input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > & out) { convert_to_rgba4444 (in, out, false); });
+    good &= run ("rgba4444 dither", input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > & out) { convert_to_rgba4444 (in, out, true ); });
+    good &= run ("rgba5551",        input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > & out) { convert_to_rgba5551 (in, out, false); });
+    good &= run ("rgba5551 dither", input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > & out) { convert_to_rgba5551 (in, out, true ); });
+    good &= run ("premultiply",     input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > &    ) { premultiply_alpha   (in);            });
+    good &= run ("swizzle bgra",    input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > &    ) { swizzle (in, BGRA);                  });
+    good &= run ("swizzle argb",    input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > &    ) { swizzle (in, ARGB);                  });
+    good &= run ("swizzle abgr",    input, [] (Color_Buffer< Rgba8888 > & in, Color_Buffer< uint16_t > &    ) { swizzle (in, ABGR);                  });
+
+    return good ? 0 : 1;
+}
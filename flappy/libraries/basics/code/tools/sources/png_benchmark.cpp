@@ -0,0 +1,201 @@
+/*
+ * PNG BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802211030
+ */
+
+// Mide la velocidad de png_decode() y la memoria que necesita para cada PNG de una carpeta:
+//
+//     basics-png-benchmark [carpeta de assets]
+//
+// Cada imagen se decodifica de dos formas: directamente en el Color_Buffer (como lo hace el motor)
+// y en un vector temporal que después se copia en el Color_Buffer (como se hacía antes), para poder
+// comparar ambas. La memoria pico es la del decodificador más la de los buffers intermedios, sin
+// contar el Color_Buffer de destino.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <ftw.h>
+#include <basics/png_decode>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    struct Result
+    {
+        double megabytes_per_second;
+        size_t peak_bytes;
+    };
+
+    struct
+    {
+        double   single_pass_seconds = 0;
+        double   two_pass_seconds    = 0;
+        double   decoded_megabytes   = 0;
+        unsigned images              = 0;
+        unsigned failed              = 0;
+    }
+    totals;
+
+    const double minimum_seconds    = 0.25;
+    const int    minimum_iterations = 5;
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename DECODE >
+    Result measure (const vector< byte > & encoded, size_t decoded_size, double & total_seconds, DECODE decode)
+    {
+        typedef chrono::steady_clock Clock;
+
+        size_t     peak_bytes = 0;
+        int        iterations = 0;
+        Clock::time_point start = Clock::now ();
+        double     seconds;
+
+        do
+        {
+            peak_bytes = max (peak_bytes, decode (encoded));
+            iterations++;
+            seconds = chrono::duration< double >(Clock::now () - start).count ();
+        }
+        while (iterations < minimum_iterations || seconds < minimum_seconds);
+
+        total_seconds += seconds / iterations;
+
+        return { decoded_size * double(iterations) / seconds / 1048576.0, peak_bytes };
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t decode_single_pass (const vector< byte > & encoded)
+    {
+        Color_Buffer< Rgba8888 > color_buffer;
+        unsigned                 width, height;
+
+        png_decode (encoded, color_buffer, width, height);
+
+        return png_decode_peak_bytes ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t decode_two_pass (const vector< byte > & encoded)
+    {
+        vector< byte >           decoded_data;
+        Color_Buffer< Rgba8888 > color_buffer;
+        unsigned                 width, height;
+
+        png_decode
+        (
+            encoded.data (),
+            encoded.size (),
+            [] (void * context, unsigned width, unsigned height) -> byte *
+            {
+                auto & decoded_data = *static_cast< vector< byte > * >(context);
+
+                decoded_data.resize (size_t(width) * height * 4);
+
+                return decoded_data.data ();
+            },
+            &decoded_data,
+            width,
+            height
+        );
+
+        color_buffer.resize (width, height);
+
+        memcpy (static_cast< byte * >(color_buffer), decoded_data.data (), decoded_data.size ());
+
+        return png_decode_peak_bytes () + decoded_data.size ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int visit (const char * path, const struct stat * , int type, struct FTW * )
+    {
+        size_t length = strlen (path);
+
+        if (type != FTW_F || length < 4 || strcmp (path + length - 4, ".png") != 0)
+        {
+            return 0;
+        }
+
+        ifstream       reader(path, ios::binary);
+        vector< byte > encoded((istreambuf_iterator< char >(reader)), istreambuf_iterator< char >());
+
+        Color_Buffer< Rgba8888 > color_buffer;
+        unsigned                 width, height;
+
+        if (encoded.empty () || !png_decode (encoded, color_buffer, width, height))
+        {
+            printf ("%-40s can't be decoded\n", path);
+            totals.failed++;
+            return 0;
+        }
+
+        size_t decoded_size = size_t(width) * height * 4;
+
+        Result single_pass = measure (encoded, decoded_size, totals.single_pass_seconds, decode_single_pass);
+        Result two_pass    = measure (encoded, decoded_size, totals.two_pass_seconds,    decode_two_pass   );
+
+        printf
+        (
+            "%-40s %5ux%-5u %8zu %9.1f %9.1f %10zu %10zu\n",
+            path, width, height, encoded.size (),
+            single_pass.megabytes_per_second, two_pass.megabytes_per_second,
+            single_pass.peak_bytes,           two_pass.peak_bytes
+        );
+
+        totals.decoded_megabytes += decoded_size / 1048576.0;
+        totals.images++;
+
+        return 0;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main (int argc, char * argv[])
+{
+    const char * folder = argc > 1 ? argv[1] : "assets";
+
+    printf
+    (
+        "%-40s %11s %8s %9s %9s %10s %10s\n",
+        "asset", "size", "png", "MB/s", "MB/s 2p", "peak", "peak 2p"
+    );
+
+    if (nftw (folder, visit, 16, FTW_PHYS) != 0)
+    {
+        fprintf (stderr, "%s: can't be read.\n", folder);
+        return 1;
+    }
+
+    if (totals.images > 0)
+    {
+        printf
+        (
+            "%u images: %.1f MB/s single pass, %.1f MB/s two passes.\n",
+            totals.images,
+            totals.decoded_megabytes / totals.single_pass_seconds,
+            totals.decoded_megabytes / totals.two_pass_seconds
+        );
+    }
+
+    return totals.failed == 0 ? 0 : 1;
+}
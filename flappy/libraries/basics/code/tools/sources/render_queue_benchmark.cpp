@@ -0,0 +1,204 @@
+/*
+ * RENDER QUEUE BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803021100
+ */
+
+// Dibuja un frame de sprites que alternan entre varias texturas (como lo haría una escena que
+// recorre sus entidades) directamente sobre un canvas que cuenta los cambios de estado, y a través
+// de una Render_Queue que lo ordena antes de reproducirlo sobre el mismo canvas:
+//
+//     basics-render-queue-benchmark [sprites] [texturas]
+//
+// Se mide lo que cuesta grabar, ordenar y reproducir un frame (sin GPU) y cuántos cambios de
+// textura y de estado le llegarían al backend en cada caso, con mezcla opaca y con transparencia.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <basics/Render_Queue>
+#include <basics/Texture_2D>
+#include <basics/Transformation>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    struct Fake_Texture : public Texture_2D
+    {
+        Fake_Texture() : Texture_2D(64, 64)
+        {
+        }
+
+        bool initialize () override { return true; }
+        void finalize   () override { }
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    struct Counting_Canvas : public Canvas
+    {
+        const Texture_2D * texture          = nullptr;
+        size_t             drawings         = 0;
+        size_t             texture_switches = 0;
+        size_t             state_changes    = 0;
+
+        void reset_counters ()
+        {
+            texture          = nullptr;
+            drawings         = 0;
+            texture_switches = 0;
+            state_changes    = 0;
+        }
+
+        void set_color       (float, float, float)       override { state_changes++; }
+        void set_opacity     (float)                     override { state_changes++; }
+        void set_blending    (Blending)                  override { state_changes++; }
+        void set_transform   (const Transformation2f & ) override { state_changes++; }
+
+        void fill_rectangle  (const Point2f &, const Size2f &, const Texture_2D * texture, int) override
+        {
+            if (texture != this->texture)
+            {
+                this->texture = texture;
+                texture_switches++;
+            }
+
+            drawings++;
+        }
+
+       ~Counting_Canvas() = default;
+    };
+
+    const double minimum_seconds = 0.2;
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename FUNCTION >
+    double measure (FUNCTION function)
+    {
+        typedef chrono::steady_clock Clock;
+
+        Clock::time_point start      = Clock::now ();
+        size_t            iterations = 0;
+        double            seconds;
+
+        do
+        {
+            function ();
+            iterations++;
+            seconds = chrono::duration< double >(Clock::now () - start).count ();
+        }
+        while (seconds < minimum_seconds);
+
+        return seconds * 1e6 / double(iterations);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void draw_frame (Canvas & canvas, const vector< unique_ptr< Fake_Texture > > & textures, size_t sprites, Canvas::Blending blending)
+    {
+        canvas.set_blending (blending);
+
+        for (size_t index = 0; index < sprites; ++index)
+        {
+            float x = float(index % 64) * 16.f;
+            float y = float(index / 64) * 16.f;
+
+            canvas.set_transform  (scale_then_translate_2d (1.f, Vector2f{ x, y }));
+            canvas.fill_rectangle ({ 0.f, 0.f }, { 16.f, 16.f }, textures[index % textures.size ()].get (), CENTER);
+        }
+
+        canvas.set_transform (Transformation2f());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run (const char * name, const vector< unique_ptr< Fake_Texture > > & textures, size_t sprites, Canvas::Blending blending)
+    {
+        Counting_Canvas direct;
+        Counting_Canvas replayed;
+        Render_Queue    queue;
+
+        draw_frame (direct, textures, sprites, blending);
+
+        double immediate = measure
+        (
+            [&] ()
+            {
+                direct.reset_counters ();
+                draw_frame (direct, textures, sprites, blending);
+            }
+        );
+
+        double recorded = measure
+        (
+            [&] ()
+            {
+                queue.discard ();
+                draw_frame (queue, textures, sprites, blending);
+                queue.sort ();
+            }
+        );
+
+        double replay = measure
+        (
+            [&] ()
+            {
+                replayed.reset_counters ();
+                queue.replay (replayed);
+            }
+        );
+
+        printf
+        (
+            "  %-12s %10.1f %10.1f %10.1f %10zu %10zu %10zu %10zu\n",
+            name,
+            immediate,
+            recorded,
+            replay,
+            direct  .texture_switches,
+            replayed.texture_switches,
+            direct  .state_changes,
+            replayed.state_changes
+        );
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    size_t sprites        = number_of_arguments > 1 ? size_t(atoi (arguments[1])) : 4096;
+    size_t texture_count  = number_of_arguments > 2 ? size_t(atoi (arguments[2])) : 8;
+
+    if (sprites == 0 || texture_count == 0)
+    {
+        printf ("usage: basics-render-queue-benchmark [sprites] [textures]\n");
+        return 1;
+    }
+
+    vector< unique_ptr< Fake_Texture > > textures;
+
+    for (size_t index = 0; index < texture_count; ++index)
+    {
+        textures.emplace_back (new Fake_Texture);
+    }
+
+    printf ("%zu sprites, %zu textures (microseconds per frame)\n\n", sprites, texture_count);
+    printf ("  %-12s %10s %10s %10s %10s %10s %10s %10s\n", "blending", "direct", "rec+sort", "replay", "tex direct", "tex queue", "st direct", "st queue");
+
+    run ("opaque",      textures, sprites, Canvas::NONE        );
+    run ("translucent", textures, sprites, Canvas::TRANSPARENCY);
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * SOFTWARE CANVAS BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1803071000
+ */
+
+// Dibuja con el Canvas_Software un frame fijo de sprites y de texto (quads del tamaño de un glifo
+// sacados de un atlas, como los que genera draw_text()) con 1, 2... N hilos y mide lo que tarda en
+// rasterizarse cada frame, para ver cómo escala el backend con el número de núcleos:
+//
+//     basics-software-canvas-benchmark [hilos] [sprites] [glifos] [frame.tga]
+//
+// Por defecto se prueba hasta el número de hilos del hardware. Como los tiles se rasterizan en
+// orden de envío, la imagen no debe depender del número de hilos: se comprueba que todas las
+// pasadas dejan el mismo framebuffer y termina con 1 si no es así. Si se indica un fichero, se
+// guarda en él el frame con save_frame() para usarlo como golden frame.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <basics/Atlas>
+#include <basics/Canvas>
+#include <basics/Color_Buffer>
+#include <basics/enable>
+#include <basics/Window>
+#include <basics/software/Canvas_Software>
+#include <basics/software/Context>
+#include <basics/software/Software>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    const double   minimum_seconds = 0.5;
+    const unsigned glyph_columns   = 16;
+    const unsigned glyph_rows      = 8;
+    const float    glyph_width     = 8.f;
+    const float    glyph_height    = 12.f;
+
+    // ---------------------------------------------------------------------------------------------
+
+    shared_ptr< Texture_2D > create_texture (Graphics_Context::Accessor & context, unsigned width, unsigned height, unsigned seed)
+    {
+        // Un damero con transparencias para que el muestreo y la mezcla tengan trabajo:
+
+        Color_Buffer< Rgba8888 > pixels(width, height);
+
+        for (unsigned y = 0; y < height; ++y)
+        {
+            for (unsigned x = 0; x < width; ++x)
+            {
+                bool     dark  = ((x / 4 + y / 4 + seed) & 1) != 0;
+                Rgba8888 color = dark ? 0x80402010u : 0xFF20C0F0u;
+
+                pixels[y * width + x] = color ^ (seed * 0x00103050u);
+            }
+        }
+
+        Texture_2D::Options options = {};
+
+        options.width  = width;
+        options.height = height;
+
+        shared_ptr< Texture_2D > texture = Texture_2D::create (0, context, pixels, options);
+
+        if (texture) context->add (texture);
+
+        return texture;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void draw_frame
+    (
+        Canvas                                   & canvas,
+        const Size2u                             & size,
+        const vector< shared_ptr< Texture_2D > > & textures,
+        const vector< const Atlas::Slice * >     & glyphs,
+        size_t                                     sprites,
+        size_t                                     glyph_count
+    )
+    {
+        canvas.set_clear_color (.1f, .1f, .2f);
+        canvas.clear           ();
+
+        canvas.set_blending    (Canvas::TRANSPARENCY);
+        canvas.set_color       (.2f, .4f, .8f);
+        canvas.fill_rectangle  ({ 0.f, 0.f }, { float(size.width), float(size.height) / 3.f });
+
+        // Los sprites se reparten por toda la pantalla con tamaños y texturas distintos:
+
+        for (size_t index = 0; index < sprites; ++index)
+        {
+            float side = 24.f + float(index % 5) * 16.f;
+            float x    = float((index * 97 ) % size.width );
+            float y    = float((index * 193) % size.height);
+
+            canvas.fill_rectangle ({ x, y }, { side, side }, textures[index % textures.size ()].get ());
+        }
+
+        // El texto se escribe en renglones desde la esquina superior izquierda:
+
+        unsigned per_line = max(unsigned(float(size.width) / glyph_width) - 2, 1u);
+
+        canvas.set_color (1.f, 1.f, 1.f);
+
+        for (size_t index = 0; index < glyph_count; ++index)
+        {
+            float left = glyph_width  * float(1 + index % per_line);
+            float top  = float(size.height) - glyph_height * float(1 + index / per_line % 100);
+
+            canvas.fill_rectangle ({ left, top }, { glyph_width, glyph_height }, glyphs[index % glyphs.size ()], TOP | LEFT);
+        }
+
+        canvas.flush ();
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned     max_threads = number_of_arguments > 1 ? unsigned(atoi (arguments[1])) : thread::hardware_concurrency ();
+    size_t       sprites     = number_of_arguments > 2 ? size_t(atoi (arguments[2])) : 1000;
+    size_t       glyph_count = number_of_arguments > 3 ? size_t(atoi (arguments[3])) : 4000;
+    const char * frame_path  = number_of_arguments > 4 ? arguments[4] : nullptr;
+
+    if (max_threads == 0) max_threads = 1;
+
+    enable< Software > ();
+
+    bool good = true;
+
+    {
+        Window::Accessor window = Window::create_window (default_window_id).lock ();
+
+        if (!software::Context::create (window, nullptr))
+        {
+            printf ("the software context couldn't be created\n");
+            return 1;
+        }
+
+        Size2u                     size    = window->get_size ();
+        Graphics_Context::Accessor context = window->lock_graphics_context ();
+        Canvas                   * canvas  = Canvas::create (ID(canvas), context, { size });
+
+        if (!canvas)
+        {
+            printf ("the canvas couldn't be created\n");
+            return 1;
+        }
+
+        software::Context         & software_context = static_cast< software::Context         & >(*context.operator -> ());
+        software::Canvas_Software & software_canvas  = static_cast< software::Canvas_Software & >(*canvas);
+
+        // Cuatro texturas para los sprites y un atlas de glifos:
+
+        vector< shared_ptr< Texture_2D > > textures;
+
+        for (unsigned index = 0; index < 4; ++index)
+        {
+            textures.push_back (create_texture (context, 64, 64, index));
+        }
+
+        Atlas font_atlas(create_texture (context, unsigned(glyph_width) * glyph_columns, unsigned(glyph_height) * glyph_rows, 7));
+
+        for (unsigned index = 0; index < glyph_columns * glyph_rows; ++index)
+        {
+            Point2f position{ float(index % glyph_columns) * glyph_width, float(index / glyph_columns) * glyph_height };
+
+            font_atlas.add_slice (Id(index + 1), position, { glyph_width, glyph_height });
+        }
+
+        vector< const Atlas::Slice * > glyphs;
+
+        for (unsigned index = 0; index < glyph_columns * glyph_rows; ++index)
+        {
+            glyphs.push_back (font_atlas.get_slice (Id(index + 1)));
+        }
+
+        printf ("%ux%u, %zu sprites, %zu glyphs\n\n", size.width, size.height, sprites, glyph_count);
+        printf ("  %7s %12s %9s %6s\n", "threads", "ms/frame", "speedup", "image");
+
+        Color_Buffer< Rgba8888 > reference;
+        double                   single_thread_ms = 0.0;
+
+        for (unsigned threads = 1; threads <= max_threads; ++threads)
+        {
+            software_canvas.set_thread_count (threads);
+
+            // Un frame sin medir para que el pool arranque y las cachés se llenen:
+
+            draw_frame (*canvas, size, textures, glyphs, sprites, glyph_count);
+
+            typedef chrono::steady_clock Clock;
+
+            Clock::time_point start  = Clock::now ();
+            size_t            frames = 0;
+            double            seconds;
+
+            do
+            {
+                draw_frame (*canvas, size, textures, glyphs, sprites, glyph_count);
+
+                context->flush_and_display ();
+
+                frames++;
+                seconds = chrono::duration< double >(Clock::now () - start).count ();
+            }
+            while (seconds < minimum_seconds);
+
+            double milliseconds = seconds * 1000.0 / double(frames);
+
+            if (threads == 1) single_thread_ms = milliseconds;
+
+            // Todas las pasadas deben dejar exactamente la misma imagen que la de un hilo:
+
+            const Color_Buffer< Rgba8888 > & framebuffer = software_context.get_framebuffer ();
+
+            bool same = true;
+
+            if (threads == 1)
+                reference = framebuffer;
+            else
+                same = reference.buffer == framebuffer.buffer;
+
+            printf ("  %7u %12.3f %8.2fx %6s\n", threads, milliseconds, single_thread_ms / milliseconds, same ? "same" : "DIFFERS");
+
+            good = good && same;
+        }
+
+        if (frame_path && !software_context.save_frame (frame_path))
+        {
+            printf ("the frame couldn't be saved to %s\n", frame_path);
+
+            good = false;
+        }
+    }
+
+    Window::destroy_window (default_window_id);
+
+    printf ("\n%s\n", good ? "OK" : "FAILED");
+
+    return good ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+/*
+ * TEXTURE CONVERTER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802201200
+ */
+
+// Herramienta de línea de comandos para el host que convierte las imágenes PNG de los assets en
+// contenedores de textura (.btex) que se pueden subir al contexto gráfico sin decodificarlas:
+//
+//     basics-texture-converter [--format rgba8888|rgb565|rgba4444|rgba5551] [--dither] [--mipmaps] <png o carpeta>...
+//
+// Con --dither los formatos de 16 bits se generan con un tramado ordenado que disimula las bandas de
+// los degradados. Las carpetas se recorren recursivamente y cada contenedor se guarda junto a su PNG,
+// que es donde Texture_2D::create() lo busca.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <basics/png_decode>
+#include <basics/Texture_Container>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    struct
+    {
+        Texture_Container::Format format  = Texture_Container::RGBA8888;
+        bool                      mipmaps = false;
+        bool                      dither  = false;
+        unsigned                  converted = 0;
+        unsigned                  failed    = 0;
+    }
+    settings;
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool ends_with (const string & text, const char * suffix)
+    {
+        size_t length = strlen (suffix);
+
+        return text.size () >= length && text.compare (text.size () - length, length, suffix) == 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool convert (const string & png_path)
+    {
+        ifstream reader(png_path, ios::binary);
+
+        vector< byte > encoded((istreambuf_iterator< char >(reader)), istreambuf_iterator< char >());
+
+        Color_Buffer< Rgba8888 > color_buffer;
+        unsigned                 width, height;
+
+        if (encoded.empty () || !png_decode (encoded, color_buffer, width, height))
+        {
+            fprintf (stderr, "%s: can't be decoded.\n", png_path.c_str ());
+            return false;
+        }
+
+        // OpenGL ES 2 ignores the mipmaps of textures whose sizes aren't powers of two:
+
+        bool power_of_2 = (width & (width - 1)) == 0 && (height & (height - 1)) == 0;
+        bool mipmaps    = settings.mipmaps && power_of_2;
+
+        if (settings.mipmaps && !power_of_2)
+        {
+            fprintf (stderr, "%s: %ux%u isn't a power of two, the mipmaps are skipped.\n", png_path.c_str (), width, height);
+        }
+
+        vector< byte > container;
+
+        if (!Texture_Container::encode (color_buffer, settings.format, mipmaps, settings.dither, container))
+        {
+            fprintf (stderr, "%s: can't be encoded.\n", png_path.c_str ());
+            return false;
+        }
+
+        string   container_path = Texture_Container::get_path_for (png_path);
+        ofstream writer(container_path, ios::binary | ios::trunc);
+
+        writer.write (reinterpret_cast< const char * >(container.data ()), container.size ());
+
+        if (!writer)
+        {
+            fprintf (stderr, "%s: can't be written.\n", container_path.c_str ());
+            return false;
+        }
+
+        printf ("%s: %ux%u, %zu bytes (png: %zu bytes)\n", container_path.c_str (), width, height, container.size (), encoded.size ());
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int visit (const char * path, const struct stat * , int type, struct FTW * )
+    {
+        if (type == FTW_F && ends_with (path, ".png"))
+        {
+            if (convert (path)) settings.converted++; else settings.failed++;
+        }
+
+        return 0;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main (int argc, char * argv[])
+{
+    vector< string > inputs;
+
+    for (int index = 1; index < argc; ++index)
+    {
+        string argument = argv[index];
+
+        if (argument == "--mipmaps")
+        {
+            settings.mipmaps = true;
+        }
+        else
+        if (argument == "--dither")
+        {
+            settings.dither = true;
+        }
+        else
+        if (argument == "--format" && index + 1 < argc)
+        {
+            string format = argv[++index];
+
+            if (format == "rgba8888") settings.format = Texture_Container::RGBA8888; else
+            if (format == "rgb565"  ) settings.format = Texture_Container::RGB565;   else
+            if (format == "rgba4444") settings.format = Texture_Container::RGBA4444; else
+            if (format == "rgba5551") settings.format = Texture_Container::RGBA5551; else
+            {
+                fprintf (stderr, "Unknown format: %s\n", format.c_str ());
+                return 2;
+            }
+        }
+        else
+            inputs.push_back (argument);
+    }
+
+    if (inputs.empty ())
+    {
+        fprintf (stderr, "usage: %s [--format rgba8888|rgb565|rgba4444|rgba5551] [--dither] [--mipmaps] <png file or folder>...\n", argv[0]);
+        return 2;
+    }
+
+    for (auto & input : inputs)
+    {
+        if (nftw (input.c_str (), visit, 16, FTW_PHYS) != 0)
+        {
+            fprintf (stderr, "%s: can't be read.\n", input.c_str ());
+            settings.failed++;
+        }
+    }
+
+    printf ("%u converted, %u failed.\n", settings.converted, settings.failed);
+
+    return settings.failed == 0 ? 0 : 1;
+}